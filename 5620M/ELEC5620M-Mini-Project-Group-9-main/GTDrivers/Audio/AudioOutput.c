@@ -13,17 +13,29 @@
  * Date       | Changes
  * -----------+----------------------------------
  * 03/05/2023 | Creation of driver
+ * 19/10/2026 | Add non-blocking note queue serviced from the main loop
+ * 19/10/2026 | Replace per-sample sin() with a fixed-point DDS oscillator
+ * 19/10/2026 | Add AUDIOOUTPUT_fill to write whole blocks from an audio source
+ * 19/10/2026 | Allow the source used by AUDIOOUTPUT_service to be changed
+ * 19/10/2026 | Record FIFO fill levels, underruns and the longest gap between refills
+ * 19/10/2026 | Derive phase increments and note lengths from the active sample rate
+ * 19/10/2026 | Leave watchdog resets to the supervisor
+ * 19/10/2026 | Profile AUDIOOUTPUT_playTone and AUDIOOUTPUT_fill
+ * 19/10/2026 | Trace refills that write to the FIFOs
+ * 19/10/2026 | Reach the FIFOs through the audio controller model of a WM8731_HOST build
  */
 
 // Include External Libraries
 #include "AudioOutput.h"  //Include header for the Audio Output Driver
 
-#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include "DE1SoC_WM8731/DE1SoC_WM8731.h"  // Include Codec for the WM8731 peripheral
-#include "HPS_Watchdog/HPS_Watchdog.h"    //Include Driver of the HPS Watchdog
+#include "Profiler/Profiler.h"            // Include Profiler to measure the time spent generating audio
+#include "Tracer/Tracer.h"                // Include Tracer to record when the FIFOs are refilled
+#include "Timer/Timer.h"                  // Include Timer to measure the time between refills
+#include "WaveTable.h"                    // Include sine table used by the oscillators
 
 // Global Variables
 // Define Pointers
@@ -38,15 +50,98 @@ volatile unsigned char *fifospace_ptr;
 volatile unsigned int *audio_left_ptr;
 volatile unsigned int *audio_right_ptr;
 
-double phase = 0.0;  // Phase accumulator
+// FIFO access. A host build reads and writes a model of the audio controller instead.
+#ifdef WM8731_HOST
+#define audio_readFIFOSpace()   WM8731_hostRead(WM8731_FIFOSPACE)
+#define audio_writeLeft(value)  WM8731_hostWrite(WM8731_LEFTFIFO, (unsigned int)(value))
+#define audio_writeRight(value) WM8731_hostWrite(WM8731_RIGHTFIFO, (unsigned int)(value))
+#else
+#define audio_readFIFOSpace()   (*(volatile unsigned int *)fifospace_ptr)
+#define audio_writeLeft(value)  (*audio_left_ptr = (value))
+#define audio_writeRight(value) (*audio_right_ptr = (value))
+#endif
+
+// Phase increment for every note from C0 to B8. Each row is one octave
+// from C to B, the flat constants are used for the black keys.
+const unsigned int AUDIOOUTPUT_notePhaseInc[AUDIO_NUM_NOTES] = {
+    AUDIO_PHASEINC(C0), AUDIO_PHASEINC(D_FLAT_0), AUDIO_PHASEINC(D0), AUDIO_PHASEINC(E_FLAT_0), AUDIO_PHASEINC(E0), AUDIO_PHASEINC(F0),
+    AUDIO_PHASEINC(G_FLAT_0), AUDIO_PHASEINC(G0), AUDIO_PHASEINC(A_FLAT_0), AUDIO_PHASEINC(A0), AUDIO_PHASEINC(B_FLAT_0), AUDIO_PHASEINC(B0),
+    AUDIO_PHASEINC(C1), AUDIO_PHASEINC(D_FLAT_1), AUDIO_PHASEINC(D1), AUDIO_PHASEINC(E_FLAT_1), AUDIO_PHASEINC(E1), AUDIO_PHASEINC(F1),
+    AUDIO_PHASEINC(G_FLAT_1), AUDIO_PHASEINC(G1), AUDIO_PHASEINC(A_FLAT_1), AUDIO_PHASEINC(A1), AUDIO_PHASEINC(B_FLAT_1), AUDIO_PHASEINC(B1),
+    AUDIO_PHASEINC(C2), AUDIO_PHASEINC(D_FLAT_2), AUDIO_PHASEINC(D2), AUDIO_PHASEINC(E_FLAT_2), AUDIO_PHASEINC(E2), AUDIO_PHASEINC(F2),
+    AUDIO_PHASEINC(G_FLAT_2), AUDIO_PHASEINC(G2), AUDIO_PHASEINC(A_FLAT_2), AUDIO_PHASEINC(A2), AUDIO_PHASEINC(B_FLAT_2), AUDIO_PHASEINC(B2),
+    AUDIO_PHASEINC(C3), AUDIO_PHASEINC(D_FLAT_3), AUDIO_PHASEINC(D3), AUDIO_PHASEINC(E_FLAT_3), AUDIO_PHASEINC(E3), AUDIO_PHASEINC(F3),
+    AUDIO_PHASEINC(G_FLAT_3), AUDIO_PHASEINC(G3), AUDIO_PHASEINC(A_FLAT_3), AUDIO_PHASEINC(A3), AUDIO_PHASEINC(B_FLAT_3), AUDIO_PHASEINC(B3),
+    AUDIO_PHASEINC(C4), AUDIO_PHASEINC(D_FLAT_4), AUDIO_PHASEINC(D4), AUDIO_PHASEINC(E_FLAT_4), AUDIO_PHASEINC(E4), AUDIO_PHASEINC(F4),
+    AUDIO_PHASEINC(G_FLAT_4), AUDIO_PHASEINC(G4), AUDIO_PHASEINC(A_FLAT_4), AUDIO_PHASEINC(A4), AUDIO_PHASEINC(B_FLAT_4), AUDIO_PHASEINC(B4),
+    AUDIO_PHASEINC(C5), AUDIO_PHASEINC(D_FLAT_5), AUDIO_PHASEINC(D5), AUDIO_PHASEINC(E_FLAT_5), AUDIO_PHASEINC(E5), AUDIO_PHASEINC(F5),
+    AUDIO_PHASEINC(G_FLAT_5), AUDIO_PHASEINC(G5), AUDIO_PHASEINC(A_FLAT_5), AUDIO_PHASEINC(A5), AUDIO_PHASEINC(B_FLAT_5), AUDIO_PHASEINC(B5),
+    AUDIO_PHASEINC(C6), AUDIO_PHASEINC(D_FLAT_6), AUDIO_PHASEINC(D6), AUDIO_PHASEINC(E_FLAT_6), AUDIO_PHASEINC(E6), AUDIO_PHASEINC(F6),
+    AUDIO_PHASEINC(G_FLAT_6), AUDIO_PHASEINC(G6), AUDIO_PHASEINC(A_FLAT_6), AUDIO_PHASEINC(A6), AUDIO_PHASEINC(B_FLAT_6), AUDIO_PHASEINC(B6),
+    AUDIO_PHASEINC(C7), AUDIO_PHASEINC(D_FLAT_7), AUDIO_PHASEINC(D7), AUDIO_PHASEINC(E_FLAT_7), AUDIO_PHASEINC(E7), AUDIO_PHASEINC(F7),
+    AUDIO_PHASEINC(G_FLAT_7), AUDIO_PHASEINC(G7), AUDIO_PHASEINC(A_FLAT_7), AUDIO_PHASEINC(A7), AUDIO_PHASEINC(B_FLAT_7), AUDIO_PHASEINC(B7),
+    AUDIO_PHASEINC(C8), AUDIO_PHASEINC(D_FLAT_8), AUDIO_PHASEINC(D8), AUDIO_PHASEINC(E_FLAT_8), AUDIO_PHASEINC(E8), AUDIO_PHASEINC(F8),
+    AUDIO_PHASEINC(G_FLAT_8), AUDIO_PHASEINC(G8), AUDIO_PHASEINC(A_FLAT_8), AUDIO_PHASEINC(A8), AUDIO_PHASEINC(B_FLAT_8), AUDIO_PHASEINC(B8),
+};
+
+// Active sample rate, and the factor in Q16 that converts a phase
+// increment at F_SAMPLE to one at the active rate
+unsigned int output_sample_rate = (unsigned int)F_SAMPLE;
+unsigned int output_rate_scale = 1 << 16;
+
+// Oscillator used by AUDIOOUTPUT_playTone. The increment and gain are only
+// recalculated when the requested frequency or volume changes.
+AudioOscillator tone_oscillator = {0, 0};
+double tone_frequency = 0.0;
+double tone_volume = 0.0;
+signed int tone_gain = 0;
+
+// Entry in the note queue. Durations are converted to a number of samples
+// when queued so the service routine only has to count down.
+typedef struct {
+    unsigned int increment;     // Phase increment per sample
+    signed int gain;            // Gain of the note in Q16
+    unsigned int samples_left;  // Number of samples still to be played
+} QueuedNote;
+
+// Circular buffer of notes waiting to be played
+QueuedNote note_queue[AUDIOOUTPUT_QUEUE_LENGTH];
+unsigned int note_queue_head = 0;   // Index of the note currently playing
+unsigned int note_queue_count = 0;  // Number of notes in the queue
+AudioOscillator queue_oscillator;   // Oscillator for the note queue
+
+// Sample buffers that audio sources write each block into
+signed int block_left[AUDIOOUTPUT_BLOCK_FRAMES];
+signed int block_right[AUDIOOUTPUT_BLOCK_FRAMES];
+
+// Audio source callback that plays the note queue
+unsigned int noteQueueSource(signed int left[], signed int right[], unsigned int frames, void *context);
+AudioSource note_queue_source = {&noteQueueSource, 0};
+
+// Source played by AUDIOOUTPUT_service
+AudioSource *service_source = &note_queue_source;
+
+// FIFO statistics recorded by AUDIOOUTPUT_fill
+AudioOutputStats output_stats;
+bool output_streaming = false;           // True from a refill that wrote samples until the source runs dry
+unsigned long long last_refill_ms = 0;  // Time of the last refill
 
 // Function that takes in a certain frequency and processes it to fulfill a single iteration of generating the desired output to be sent to the desired channel(s)
 // NOTE: Ensure that the function is within a loop so it can generate the whole waveform to be heard
 int AUDIOOUTPUT_playTone(double frequency, double volume, unsigned int channel) {
-    // Initialise Phase Accumulator
-    double inc = frequency * PI2 / F_SAMPLE;  // Calculate the phase increment based on desired frequency
-    double ampl = 8388608.0 * volume / 100;   // Calculate the desired amplitude. WARNING: DEAFENING IF TOO HIGH!
-    signed int audio_sample = 0;              // Variable to store the sample to be output to the desired channel(s)
+    signed int audio_sample = 0;  // Variable to store the sample to be output to the desired channel(s)
+    unsigned int fifospace;       // All four FIFO space counters
+
+    PROF_BEGIN(PROF_AUDIO_PLAYTONE);
+    // Only convert the frequency and volume when they change, the per-sample path is integer only
+    if (frequency != tone_frequency) {
+        tone_oscillator.increment = AUDIOOUTPUT_frequencyToIncrement(frequency);  // Calculate the phase increment based on desired frequency
+        tone_frequency = frequency;
+    }
+    if (volume != tone_volume) {
+        tone_gain = AUDIOOUTPUT_volumeToGain(volume);  // Calculate the desired amplitude. WARNING: DEAFENING IF TOO HIGH!
+        tone_volume = volume;
+    }
 
     /// Grab the FIFO Space and Audio Channel Pointers
     fifospace_ptr = WM8731_getFIFOSpacePtr();
@@ -54,41 +149,230 @@ int AUDIOOUTPUT_playTone(double frequency, double volume, unsigned int channel)
     audio_right_ptr = WM8731_getRightFIFOPtr();
 
     // Check the FIFO space before writing/reading values to the pointers of the left/right channels
-    if ((fifospace_ptr[2] > 0) && (fifospace_ptr[3] > 0)) {
-        // Increment the phase
-        phase = phase + inc;
-        // Ensure phase is wrapped to range 0 to 2*Pi (range of sin function)
-        while (phase >= PI2) {
-            phase = phase - PI2;
-        }
+    fifospace = audio_readFIFOSpace();
+    if (((fifospace >> (8 * WM8731_WSRC)) & 0xFF) && ((fifospace >> (8 * WM8731_WSLC)) & 0xFF)) {
         // Calculate next sample of the output tone.
-        audio_sample = (signed int)(ampl * sin(phase));
+        audio_sample = AUDIOOUTPUT_nextSample(&tone_oscillator, tone_gain);
         // Output tone to left and right channels.
         AUDIOOUTPUT_writeToChannel(channel, audio_sample, audio_sample);
 
 // Debugging - display FIFO space on red LEDs.
 #ifdef WITH_DEBUGGING
-        *LEDR = fifospace_ptr[2];  // Output 'WSRC' register to the red LEDs
+        *LEDR = (fifospace >> (8 * WM8731_WSRC)) & 0xFF;  // Output 'WSRC' register to the red LEDs
 #endif
-                                   // Clear both FIFOs
-        WM8731_clearFIFO(true, true);  // Clear buffer on each iteration so it never overflows
-        // Finally reset the watchdog.
-        HPS_ResetWatchdog();
+        // The FIFOs are not cleared as that would throw away buffered samples.
+        // Callers running this in a loop are responsible for the watchdog.
     }
+    PROF_END(PROF_AUDIO_PLAYTONE);
     return AUDIOOUTPUT_SUCCESS;
 }
 
 void AUDIOOUTPUT_writeToChannel(unsigned int channel_choice, signed int left_value, signed int right_value) {
     switch (channel_choice) {
         case AUDIO_BOTHCHANNELS:  // Output to both the left and right channels
-            *audio_left_ptr = left_value;
-            *audio_right_ptr = right_value;
+            audio_writeLeft(left_value);
+            audio_writeRight(right_value);
             break;
         case AUDIO_LEFTCHANNEL:  // Output to the right channel only
-            *audio_left_ptr = left_value;
+            audio_writeLeft(left_value);
             break;
         case AUDIO_RIGHTCHANNEL:  // Output to the left channel only
-            *audio_right_ptr = right_value;
+            audio_writeRight(right_value);
             break;
     }
 }
+
+// Converts a 0 - 100 volume to a Q16 gain. Limited to full scale so the
+// 24-bit output can never overflow.
+signed int AUDIOOUTPUT_volumeToGain(double volume) {
+    if (volume < 0) volume = 0;
+    if (volume > 100) volume = 100;
+    return (signed int)(volume * 65536 / 100);
+}
+
+// Advances the oscillator and returns the next 24-bit sine sample.
+// The phase wraps at 2^32 on its own so no range check is needed.
+signed int AUDIOOUTPUT_nextSample(AudioOscillator *oscillator, signed int gain) {
+    oscillator->phase += oscillator->increment;
+    // Q15 sine x Q16 gain gives Q31, shift down to the codec's 24-bit range
+    return (WT_lookup(WT_sine, oscillator->phase) * gain) >> 8;
+}
+
+// Adds a sequence of notes to the note queue. Either all notes are queued or none.
+signed int AUDIOOUTPUT_queueNotes(const AudioNote notes[], unsigned int count, double volume) {
+    unsigned int i, index;
+    // Check there is room for the whole sequence
+    if (count > AUDIOOUTPUT_QUEUE_LENGTH - note_queue_count) return AUDIOOUTPUT_QUEUEFULL;
+
+    for (i = 0; i < count; i++) {
+        // Find the next free slot at the back of the queue
+        index = (note_queue_head + note_queue_count) % AUDIOOUTPUT_QUEUE_LENGTH;
+        note_queue[index].increment = AUDIOOUTPUT_frequencyToIncrement(notes[i].frequency);
+        // Rests are queued as notes with zero gain so timing is kept
+        note_queue[index].gain = (notes[i].frequency == AUDIO_REST) ? 0 : AUDIOOUTPUT_volumeToGain(volume);
+        note_queue[index].samples_left = notes[i].duration_ms * (output_sample_rate / 1000);
+        note_queue_count++;
+    }
+    return AUDIOOUTPUT_SUCCESS;
+}
+
+// Records the FIFO fill level and the time since the last refill.
+// space is the number of free samples in the FIFOs.
+void recordRefill(unsigned int space) {
+    unsigned int level = (space < AUDIOOUTPUT_FIFO_DEPTH) ? AUDIOOUTPUT_FIFO_DEPTH - space : 0;
+    unsigned long long now_ms = Timer_nowMs();
+    unsigned int bin = level / (AUDIOOUTPUT_FIFO_DEPTH / AUDIOOUTPUT_HISTOGRAM_BINS);
+
+    if (bin >= AUDIOOUTPUT_HISTOGRAM_BINS) bin = AUDIOOUTPUT_HISTOGRAM_BINS - 1;
+    output_stats.fill_histogram[bin]++;
+    output_stats.refills++;
+
+    // Gaps only matter while audio is playing
+    if (output_streaming) {
+        if (level == 0) output_stats.underruns++;
+        if (now_ms - last_refill_ms > output_stats.longest_gap_ms) {
+            output_stats.longest_gap_ms = (unsigned int)(now_ms - last_refill_ms);
+        }
+    }
+    last_refill_ms = now_ms;
+}
+
+// Writes as many frames from the source as fit in the FIFOs.
+unsigned int AUDIOOUTPUT_fill(AudioSource *source, unsigned int max_frames) {
+    unsigned int fifospace, space, frames, generated, written, i;
+
+    PROF_BEGIN(PROF_AUDIO_FILL);
+    /// Grab the FIFO Space and Audio Channel Pointers
+    fifospace_ptr = WM8731_getFIFOSpacePtr();
+    audio_left_ptr = WM8731_getLeftFIFOPtr();
+    audio_right_ptr = WM8731_getRightFIFOPtr();
+
+    // Read all four FIFO space counters in a single access, then use
+    // the smaller of the two write spaces so both channels stay aligned
+    fifospace = audio_readFIFOSpace();
+    space = (fifospace >> (8 * WM8731_WSRC)) & 0xFF;
+    if (((fifospace >> (8 * WM8731_WSLC)) & 0xFF) < space) space = (fifospace >> (8 * WM8731_WSLC)) & 0xFF;
+    recordRefill(space);
+    if (max_frames < space) space = max_frames;
+    // Only trace refills with room to write, as most calls find the FIFOs full
+    if (space) TRACE_BEGIN(TRACE_AUDIO_REFILL, space);
+
+// Debugging - display FIFO space on red LEDs.
+#ifdef WITH_DEBUGGING
+    *LEDR = space;
+#endif
+
+    written = 0;
+    while (written < space) {
+        // Generate the next block of frames
+        frames = space - written;
+        if (frames > AUDIOOUTPUT_BLOCK_FRAMES) frames = AUDIOOUTPUT_BLOCK_FRAMES;
+        generated = source->callback(block_left, block_right, frames, source->context);
+        // Copy the block into the FIFOs
+        for (i = 0; i < generated; i++) {
+            audio_writeLeft(block_left[i]);
+            audio_writeRight(block_right[i]);
+        }
+        written += generated;
+        // Stop early if the source has run dry
+        if (generated < frames) break;
+    }
+
+    // Audio is playing until the source runs dry. A refill with no room
+    // to write, as most are, leaves that as it was.
+    if (space) output_streaming = (written == space);
+    if (space) TRACE_END(TRACE_AUDIO_REFILL, written);
+    PROF_END(PROF_AUDIO_FILL);
+    return written;
+}
+
+// Generates frames from the note queue, moving on to the next note as each finishes.
+unsigned int noteQueueSource(signed int left[], signed int right[], unsigned int frames, void *context) {
+    QueuedNote *note;
+    unsigned int generated = 0;
+    (void)context;
+
+    while ((generated < frames) && note_queue_count) {
+        note = &note_queue[note_queue_head];
+        // Calculate next sample of the note and output to both channels
+        queue_oscillator.increment = note->increment;
+        left[generated] = AUDIOOUTPUT_nextSample(&queue_oscillator, note->gain);
+        right[generated] = left[generated];
+        generated++;
+
+        // Move on to the next note once this one has finished
+        if (note->samples_left <= 1) {
+            note_queue_head = (note_queue_head + 1) % AUDIOOUTPUT_QUEUE_LENGTH;
+            note_queue_count--;
+        } else {
+            note->samples_left--;
+        }
+    }
+    return generated;
+}
+
+// Selects the source played by AUDIOOUTPUT_service
+void AUDIOOUTPUT_setSource(AudioSource *source) {
+    service_source = source ? source : &note_queue_source;
+}
+
+// Tops up the FIFOs from the selected source.
+void AUDIOOUTPUT_service(void) {
+    // Nothing to do if no notes are waiting in the note queue
+    if ((service_source == &note_queue_source) && !note_queue_count) return;
+    AUDIOOUTPUT_fill(service_source, AUDIOOUTPUT_BLOCK_FRAMES);
+}
+
+// Returns true while there are notes left in the queue
+bool AUDIOOUTPUT_isPlaying(void) {
+    return note_queue_count > 0;
+}
+
+// Discards every note in the queue
+void AUDIOOUTPUT_stop(void) {
+    note_queue_count = 0;
+    queue_oscillator.phase = 0;
+}
+
+// Sets the codec sample rate and the scale used for phase increments
+signed int AUDIOOUTPUT_setSampleRate(unsigned int rate) {
+    if (WM8731_setSampleRate(rate) != WM8731_SUCCESS) return AUDIOOUTPUT_ERRORRATE;
+    output_sample_rate = rate;
+    output_rate_scale = (unsigned int)(((unsigned long long)F_SAMPLE * 65536) / rate);
+    return AUDIOOUTPUT_SUCCESS;
+}
+
+// Returns the active sample rate
+unsigned int AUDIOOUTPUT_getSampleRate(void) {
+    return output_sample_rate;
+}
+
+// Converts a frequency to a phase increment at the active sample rate
+unsigned int AUDIOOUTPUT_frequencyToIncrement(double frequency) {
+    return (unsigned int)(frequency * (4294967296.0 / output_sample_rate) + 0.5);
+}
+
+// Scales a note's phase increment from F_SAMPLE to the active sample rate.
+// The scale is exact for every supported rate.
+unsigned int AUDIOOUTPUT_noteIncrement(unsigned int note) {
+    if (note >= AUDIO_NUM_NOTES) return 0;
+    return (unsigned int)(((unsigned long long)AUDIOOUTPUT_notePhaseInc[note] * output_rate_scale) >> 16);
+}
+
+// Copies out the FIFO statistics
+void AUDIOOUTPUT_getStats(AudioOutputStats *stats) {
+    *stats = output_stats;
+}
+
+// Clears the FIFO statistics
+void AUDIOOUTPUT_resetStats(void) {
+    unsigned int i;
+    output_stats.refills = 0;
+    output_stats.underruns = 0;
+    output_stats.longest_gap_ms = 0;
+    for (i = 0; i < AUDIOOUTPUT_HISTOGRAM_BINS; i++) {
+        output_stats.fill_histogram[i] = 0;
+    }
+    // Gaps are measured from the next refill, not one before the reset
+    output_streaming = false;
+}
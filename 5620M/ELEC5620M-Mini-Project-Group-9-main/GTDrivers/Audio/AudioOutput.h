@@ -13,11 +13,19 @@
  * Date       | Changes
  * -----------+----------------------------------
  * 03/05/2023 | Creation of driver
+ * 19/10/2026 | Add non-blocking note queue serviced from the main loop
+ * 19/10/2026 | Replace per-sample sin() with a fixed-point DDS oscillator
+ * 19/10/2026 | Add AUDIOOUTPUT_fill to write whole blocks from an audio source
+ * 19/10/2026 | Allow the source used by AUDIOOUTPUT_service to be changed
+ * 19/10/2026 | Record FIFO fill levels, underruns and the longest gap between refills
+ * 19/10/2026 | Derive phase increments and note lengths from the active sample rate
  */
 
 #ifndef AUDIO_OUTPUT_
 #define AUDIO_OUTPUT_
 
+#include <stdbool.h>
+
 // Frequency Definition of standard notes
 #define C0 16.35
 #define C_SHARP_0 16.35
@@ -174,15 +182,94 @@
 #define B8 7902.13
 
 // Define some useful constants
-#define F_SAMPLE 48000.0   // Sampling rate of WM8731 Codec (Do not change)
+#define F_SAMPLE 48000.0   // Default sampling rate of WM8731 Codec, see AUDIOOUTPUT_setSampleRate
 #define PI2 6.28318530718  // 2 x Pi      (Apple or Peach?)
 
+// Converts a frequency in Hz to a 32-bit DDS phase increment per sample at F_SAMPLE.
+// For the note constants above this is folded to an integer at compile time.
+// Use AUDIOOUTPUT_frequencyToIncrement for the active sample rate.
+#define AUDIO_PHASEINC(frequency) ((unsigned int)((frequency) * (4294967296.0 / F_SAMPLE) + 0.5))
+
+// Note numbers used to index AUDIOOUTPUT_notePhaseInc.
+// Semitone is 0 for C up to 11 for B, octave is 0 - 8. e.g. AUDIO_NOTE(4, 9) is A4.
+#define AUDIO_NOTE(octave, semitone) ((octave) * 12 + (semitone))
+#define AUDIO_NUM_NOTES 108
+
+// Phase increment at F_SAMPLE for every note from C0 to B8, indexed by AUDIO_NOTE.
+// Use AUDIOOUTPUT_noteIncrement for the active sample rate.
+extern const unsigned int AUDIOOUTPUT_notePhaseInc[AUDIO_NUM_NOTES];
+
 #define AUDIO_BOTHCHANNELS 0  // Channel Selection Option for writing to both channels
 #define AUDIO_RIGHTCHANNEL 1  // Channel Selection Option for writing to the right channel
 #define AUDIO_LEFTCHANNEL 2   // Channel Selection Option for writing to the left channel
 
 // Define Status codes
-#define AUDIOOUTPUT_SUCCESS 1  // Value to be returned upon the successful completion of a function/process
+#define AUDIOOUTPUT_SUCCESS 1     // Value to be returned upon the successful completion of a function/process
+#define AUDIOOUTPUT_QUEUEFULL -1  // Value to be returned when there is no room left in the note queue
+#define AUDIOOUTPUT_ERRORRATE -2  // Value to be returned when the codec sample rate could not be set
+
+// Number of frames generated per call to an audio source. Matches the depth of the codec FIFOs.
+#define AUDIOOUTPUT_BLOCK_FRAMES 128
+
+// Number of samples each codec output FIFO holds
+#define AUDIOOUTPUT_FIFO_DEPTH 128
+
+// Number of bins in the FIFO fill level histogram. Each bin covers
+// AUDIOOUTPUT_FIFO_DEPTH / AUDIOOUTPUT_HISTOGRAM_BINS samples.
+#define AUDIOOUTPUT_HISTOGRAM_BINS 8
+
+// Maximum number of notes that can be waiting in the note queue
+#define AUDIOOUTPUT_QUEUE_LENGTH 32
+
+// Frequency used to represent a rest (silence) in a note sequence
+#define AUDIO_REST 0.0
+
+/*
+ * This struct represents a single note in a sequence passed to
+ * AUDIOOUTPUT_queueNotes.
+ */
+typedef struct {
+    double frequency;          // Frequency of the note, or AUDIO_REST for silence
+    unsigned int duration_ms;  // How long the note is played for in milliseconds
+} AudioNote;
+
+/*
+ * This struct represents a direct digital synthesis (DDS) oscillator.
+ * The phase wraps naturally at 2^32 which is one full cycle of the waveform.
+ */
+typedef struct {
+    unsigned int phase;      // 32-bit phase accumulator
+    unsigned int increment;  // Phase added every sample, see AUDIO_PHASEINC
+} AudioOscillator;
+
+/*
+ * Callback used by AUDIOOUTPUT_fill to generate audio.
+ * Must write up to `frames` 24-bit samples to each of left[] and right[]
+ * and return how many frames were written. Returning fewer frames than
+ * requested means the source has run out of audio for now.
+ */
+typedef unsigned int (*AudioSourceCallback)(signed int left[], signed int right[], unsigned int frames, void *context);
+
+/*
+ * This struct represents a source of audio for AUDIOOUTPUT_fill.
+ */
+typedef struct {
+    AudioSourceCallback callback;  // Function that generates the samples
+    void *context;                 // Passed to the callback unchanged
+} AudioSource;
+
+/*
+ * This struct holds the statistics recorded by AUDIOOUTPUT_fill.
+ * Audio is playing from a refill that writes samples until a refill finds
+ * the source has run dry. An underrun is counted when a refill finds the
+ * FIFOs empty while audio is playing, so a gap was almost certainly heard.
+ */
+typedef struct {
+    unsigned int refills;         // Number of times AUDIOOUTPUT_fill has run
+    unsigned int underruns;       // Refills that found the FIFOs empty while audio was playing
+    unsigned int longest_gap_ms;  // Longest time between refills while audio was playing
+    unsigned int fill_histogram[AUDIOOUTPUT_HISTOGRAM_BINS];  // Samples waiting in the FIFOs at each refill
+} AudioOutputStats;
 
 // Define Function Prototypes
 
@@ -216,4 +303,170 @@ signed int AUDIOOUTPUT_playTone(double frequency, double volume, unsigned int ch
  */
 void AUDIOOUTPUT_writeToChannel(unsigned int channel_choice, signed int left_vlaue, signed int right_value);
 
+/*
+ *   AUDIOOUTPUT_volumeToGain
+ *
+ *   Converts a volume into the fixed-point gain used by AUDIOOUTPUT_nextSample.
+ *
+ *   Inputs:
+ *               volume:                Volume level (0 - 100), values above 100 are limited to 100
+ *
+ *   Output:
+ *               Gain in Q16, where 65536 is full scale
+ */
+signed int AUDIOOUTPUT_volumeToGain(double volume);
+
+/*
+ *   AUDIOOUTPUT_nextSample
+ *
+ *   Advances a DDS oscillator by one sample and returns the next sample of a
+ *   sine wave. Uses a sine table with linear interpolation so no floating point
+ *   maths is needed.
+ *
+ *   Inputs:
+ *               oscillator:            Oscillator to advance
+ *               gain:                  Gain from AUDIOOUTPUT_volumeToGain
+ *
+ *   Output:
+ *               24-bit sample ready to be written to the codec
+ */
+signed int AUDIOOUTPUT_nextSample(AudioOscillator *oscillator, signed int gain);
+
+/*
+ *   AUDIOOUTPUT_fill
+ *
+ *   Reads the free FIFO space once and writes as many frames from the source
+ *   as will fit, in blocks of up to AUDIOOUTPUT_BLOCK_FRAMES. The FIFOs are not
+ *   cleared, so previously buffered audio keeps playing without a gap.
+ *
+ *   Inputs:
+ *               source:                The audio source to read frames from
+ *               max_frames:            Maximum number of frames to write
+ *
+ *   Output:
+ *               Number of frames written to the codec
+ */
+unsigned int AUDIOOUTPUT_fill(AudioSource *source, unsigned int max_frames);
+
+/*
+ *   AUDIOOUTPUT_queueNotes
+ *
+ *   Adds a sequence of notes to the end of the note queue and returns immediately.
+ *   The notes are played back by AUDIOOUTPUT_service, so the caller is never blocked.
+ *   Either the whole sequence is queued or none of it is.
+ *
+ *   Inputs:
+ *               notes:                 Array of notes to play in order
+ *               count:                 Number of notes in the array
+ *               volume:                Volume to play the notes at (0 - 100)
+ *
+ *   Output:
+ *               AUDIOOUTPUT_SUCCESS:   If the notes were queued
+ *               AUDIOOUTPUT_QUEUEFULL: If there was not enough room in the queue
+ */
+signed int AUDIOOUTPUT_queueNotes(const AudioNote notes[], unsigned int count, double volume);
+
+/*
+ *   AUDIOOUTPUT_setSource
+ *
+ *   Selects the audio source used by AUDIOOUTPUT_service. The note queue
+ *   is used until this is called. Passing 0 selects the note queue again.
+ *
+ *   Inputs:
+ *               source:                The audio source to play from
+ *
+ */
+void AUDIOOUTPUT_setSource(AudioSource *source);
+
+/*
+ *   AUDIOOUTPUT_service
+ *
+ *   Tops up the codec FIFOs with samples from the selected source. Writes as many
+ *   samples as there is space for and then returns without waiting.
+ *   Must be called regularly, e.g. once per pass of the main loop or from a timer IRQ.
+ *
+ */
+void AUDIOOUTPUT_service(void);
+
+/*
+ *   AUDIOOUTPUT_isPlaying
+ *
+ *   Output:
+ *               true if there are notes still waiting to be played
+ */
+bool AUDIOOUTPUT_isPlaying(void);
+
+/*
+ *   AUDIOOUTPUT_stop
+ *
+ *   Discards all queued notes, including the one currently playing.
+ *
+ */
+void AUDIOOUTPUT_stop(void);
+
+/*
+ *   AUDIOOUTPUT_setSampleRate
+ *
+ *   Sets the codec sample rate. Audio is generated at this rate, so lower rates
+ *   cost proportionally less CPU. Phase increments and note lengths are worked
+ *   out when a note starts, so this should be called before any audio is set
+ *   up, e.g. straight after WM8731_initialise.
+ *
+ *   Inputs:
+ *               rate:                  Sample rate in Hz, see WM8731_setSampleRate
+ *
+ *   Output:
+ *               AUDIOOUTPUT_SUCCESS or AUDIOOUTPUT_ERRORRATE
+ */
+signed int AUDIOOUTPUT_setSampleRate(unsigned int rate);
+
+/*
+ *   AUDIOOUTPUT_getSampleRate
+ *
+ *   Output:
+ *               Active sample rate in Hz
+ */
+unsigned int AUDIOOUTPUT_getSampleRate(void);
+
+/*
+ *   AUDIOOUTPUT_frequencyToIncrement
+ *
+ *   Inputs:
+ *               frequency:             Frequency in Hz
+ *
+ *   Output:
+ *               DDS phase increment for the frequency at the active sample rate
+ */
+unsigned int AUDIOOUTPUT_frequencyToIncrement(double frequency);
+
+/*
+ *   AUDIOOUTPUT_noteIncrement
+ *
+ *   Inputs:
+ *               note:                  Note number, see AUDIO_NOTE
+ *
+ *   Output:
+ *               DDS phase increment for the note at the active sample rate
+ */
+unsigned int AUDIOOUTPUT_noteIncrement(unsigned int note);
+
+/*
+ *   AUDIOOUTPUT_getStats
+ *
+ *   Copies the FIFO statistics recorded since the last reset.
+ *
+ *   Inputs:
+ *               stats:                 Struct to copy the statistics into
+ *
+ */
+void AUDIOOUTPUT_getStats(AudioOutputStats *stats);
+
+/*
+ *   AUDIOOUTPUT_resetStats
+ *
+ *   Clears the FIFO statistics.
+ *
+ */
+void AUDIOOUTPUT_resetStats(void);
+
 #endif
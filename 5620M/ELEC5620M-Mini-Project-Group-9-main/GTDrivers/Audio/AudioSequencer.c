@@ -0,0 +1,158 @@
+/*
+ *  DE1-SoC Audio Sequencer
+ * ------------------------------
+ * Description:
+ * Plays music stored as a compact list of note events on the
+ * synthesiser. Each event is 4 bytes: the time since the previous
+ * event, a voice, a note and how long the note is held, all in ticks.
+ * Sequences are normally const tables written by sequence_gen.py
+ * from a text file.
+ *
+ * The sequencer is an audio source that wraps SYNTH_render. Each block
+ * is split at the samples where events are due, so notes start and
+ * stop on the exact sample whatever the block size.
+ *
+ * Company: University of Leeds
+ * Author: Kaif Kutchwala, Emmanuel Leo, Varun Gonsalves
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 19/10/2026 | Creation of driver
+ */
+
+// Include External Libraries
+#include "AudioSequencer.h"  // Include header for the Audio Sequencer
+
+#include "AudioSynth.h"  // Include the synthesiser that plays the notes
+
+// Number of samples in one millisecond
+#define SEQUENCER_SAMPLES_PER_MS (AUDIOOUTPUT_getSampleRate() / 1000)
+
+// Sequence being played, 0 if none
+const Sequence *playing_sequence = 0;
+bool sequence_loop;                    // Start again at the end
+unsigned int sequence_index;           // Index of the next event
+unsigned int sequence_tick_samples;    // Length of a tick in samples
+unsigned int event_countdown;          // Samples until the next event is due
+unsigned int voices_used;              // Mask of voices the sequence has played notes on
+
+// Samples until each voice's note is released, 0 if there is nothing to release
+unsigned int release_countdown[SYNTH_NUM_VOICES];
+
+// Audio source for AUDIOOUTPUT_fill
+AudioSource sequencer_source = {&SEQUENCER_render, 0};
+
+// Helper Methods
+
+// Runs every event that is due now. Events at the same time all run before any
+// samples are rendered.
+void runDueEvents(void) {
+    const SequenceEvent *event;
+
+    while (playing_sequence && (event_countdown == 0)) {
+        event = &playing_sequence->events[sequence_index];
+
+        if (event->note == SEQUENCER_NOTE_END) {
+            // End of the song, go back to the start or finish and
+            // release anything still held
+            if (!sequence_loop) {
+                SEQUENCER_stop();
+                return;
+            }
+            sequence_index = 0;
+        } else {
+            // Start the note if it is one the synthesiser can play
+            if ((event->note < AUDIO_NUM_NOTES) && (event->voice < SYNTH_NUM_VOICES)) {
+                SYNTH_noteOn(event->voice, AUDIOOUTPUT_noteIncrement(event->note));
+                release_countdown[event->voice] = event->duration * sequence_tick_samples;
+                voices_used |= 1 << event->voice;
+            }
+            sequence_index++;
+        }
+
+        event_countdown = playing_sequence->events[sequence_index].delta * sequence_tick_samples;
+    }
+}
+
+// Driver Functions
+
+signed int SEQUENCER_play(const Sequence *new_sequence, bool loop) {
+    unsigned int length = 0;
+    unsigned int i;
+
+    // A looping song with no length would never let time move on
+    for (i = 0; new_sequence->events[i].note != SEQUENCER_NOTE_END; i++) {
+        length += new_sequence->events[i].delta;
+    }
+    length += new_sequence->events[i].delta;
+    if (loop && (length == 0)) return SEQUENCER_INVALIDSEQUENCE;
+
+    SEQUENCER_stop();
+    sequence_loop = loop;
+    sequence_index = 0;
+    sequence_tick_samples = new_sequence->tick_ms * SEQUENCER_SAMPLES_PER_MS;
+    event_countdown = new_sequence->events[0].delta * sequence_tick_samples;
+    playing_sequence = new_sequence;
+    return SEQUENCER_SUCCESS;
+}
+
+void SEQUENCER_stop(void) {
+    unsigned int voice;
+    // Release every note the sequence started
+    for (voice = 0; voice < SYNTH_NUM_VOICES; voice++) {
+        if (voices_used & (1 << voice)) SYNTH_noteOff(voice);
+        release_countdown[voice] = 0;
+    }
+    voices_used = 0;
+    playing_sequence = 0;
+}
+
+bool SEQUENCER_isPlaying(void) {
+    return playing_sequence != 0;
+}
+
+unsigned int SEQUENCER_render(signed int left[], signed int right[], unsigned int frames, void *context) {
+    unsigned int done = 0;
+    unsigned int chunk, rendered, voice, i;
+    (void)context;
+
+    // Nothing to sequence, just play the synthesiser
+    if (!playing_sequence) return SYNTH_render(left, right, frames, 0);
+
+    if (frames > AUDIOOUTPUT_BLOCK_FRAMES) frames = AUDIOOUTPUT_BLOCK_FRAMES;
+
+    while (done < frames) {
+        runDueEvents();
+
+        // Render up to the next sample where something changes
+        chunk = frames - done;
+        if (playing_sequence && (event_countdown < chunk)) chunk = event_countdown;
+        for (voice = 0; voice < SYNTH_NUM_VOICES; voice++) {
+            if (release_countdown[voice] && (release_countdown[voice] < chunk)) chunk = release_countdown[voice];
+        }
+
+        // The synthesiser renders nothing when it is silent, fill that with silence
+        rendered = SYNTH_render(&left[done], &right[done], chunk, 0);
+        for (i = rendered; i < chunk; i++) {
+            left[done + i] = 0;
+            right[done + i] = 0;
+        }
+
+        // Move time on by the samples just rendered
+        if (playing_sequence) event_countdown -= chunk;
+        for (voice = 0; voice < SYNTH_NUM_VOICES; voice++) {
+            if (release_countdown[voice]) {
+                release_countdown[voice] -= chunk;
+                if (release_countdown[voice] == 0) SYNTH_noteOff(voice);
+            }
+        }
+        done += chunk;
+    }
+    return frames;
+}
+
+AudioSource *SEQUENCER_getSource(void) {
+    return &sequencer_source;
+}
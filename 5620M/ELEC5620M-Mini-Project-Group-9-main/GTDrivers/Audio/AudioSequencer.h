@@ -0,0 +1,117 @@
+/*
+ *  DE1-SoC Audio Sequencer
+ * ------------------------------
+ * Description:
+ * Plays music stored as a compact list of note events on the
+ * synthesiser. Each event is 4 bytes: the time since the previous
+ * event, a voice, a note and how long the note is held, all in ticks.
+ * Sequences are normally const tables written by sequence_gen.py
+ * from a text file.
+ *
+ * The sequencer is an audio source that wraps SYNTH_render. Each block
+ * is split at the samples where events are due, so notes start and
+ * stop on the exact sample whatever the block size.
+ *
+ * Company: University of Leeds
+ * Author: Kaif Kutchwala, Emmanuel Leo, Varun Gonsalves
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 19/10/2026 | Creation of driver
+ */
+
+#ifndef AUDIO_SEQUENCER_
+#define AUDIO_SEQUENCER_
+
+#include <stdbool.h>
+
+#include "AudioOutput.h"
+
+// Special note values
+#define SEQUENCER_NOTE_NONE 0xFE  // Event only moves time forward, used for gaps over 255 ticks
+#define SEQUENCER_NOTE_END 0xFF   // Last event of a sequence, its delta is the time to the end of the song
+
+// Define Status codes
+#define SEQUENCER_SUCCESS 0
+#define SEQUENCER_INVALIDSEQUENCE -1
+
+/*
+ * This struct represents a single event in a sequence.
+ */
+typedef struct {
+    unsigned char delta;     // Ticks after the previous event that this event happens
+    unsigned char voice;     // Synthesiser voice to play the note on
+    unsigned char note;      // Note number (see AUDIO_NOTE), SEQUENCER_NOTE_NONE or SEQUENCER_NOTE_END
+    unsigned char duration;  // Ticks the note is held for before it is released, 0 holds it until the next note
+} SequenceEvent;
+
+/*
+ * This struct represents a piece of music.
+ */
+typedef struct {
+    const SequenceEvent *events;  // Events in time order, ending with SEQUENCER_NOTE_END
+    unsigned int tick_ms;         // Length of a tick in milliseconds
+} Sequence;
+
+/*
+ *  SEQUENCER_play
+ *
+ *  Starts playing a sequence from the beginning, replacing any sequence
+ *  already playing. The waveform, envelope and gain of each voice used
+ *  should be set up with the SYNTH_ functions first.
+ *
+ *  Inputs:
+ *              sequence:       Sequence to play
+ *              loop:           true to start again from the beginning at the end
+ *
+ *  Output:
+ *              SEQUENCER_SUCCESS, or SEQUENCER_INVALIDSEQUENCE if a looping
+ *              sequence has no length
+ */
+signed int SEQUENCER_play(const Sequence *sequence, bool loop);
+
+/*
+ *  SEQUENCER_stop
+ *
+ *  Stops the sequence and releases any notes it is holding.
+ */
+void SEQUENCER_stop(void);
+
+/*
+ *  SEQUENCER_isPlaying
+ *
+ *  Output:
+ *              true if a sequence is playing
+ */
+bool SEQUENCER_isPlaying(void);
+
+/*
+ *  SEQUENCER_render
+ *
+ *  Runs the events of the playing sequence and renders the synthesiser.
+ *  Has the same signature as AudioSourceCallback. While a sequence is
+ *  playing every frame asked for is rendered, including silence, so the
+ *  timing stays locked to the codec. Otherwise this is SYNTH_render.
+ *
+ *  Inputs:
+ *              left, right:    Buffers to write 24-bit samples to
+ *              frames:         Number of frames to render (up to AUDIOOUTPUT_BLOCK_FRAMES)
+ *              context:        Unused
+ *
+ *  Output:
+ *              Number of frames rendered
+ */
+unsigned int SEQUENCER_render(signed int left[], signed int right[], unsigned int frames, void *context);
+
+/*
+ *  SEQUENCER_getSource
+ *
+ *  Output:
+ *              AudioSource that renders the sequencer and synthesiser, for
+ *              AUDIOOUTPUT_fill or AUDIOOUTPUT_setSource
+ */
+AudioSource *SEQUENCER_getSource(void);
+
+#endif
@@ -0,0 +1,403 @@
+/*
+ *  DE1-SoC Audio Synthesiser
+ * ------------------------------
+ * Description:
+ * Small polyphonic synthesiser for sound effects and music.
+ * Each voice has a table oscillator (sine, square or triangle),
+ * an ADSR envelope, a gain and a queue of notes to play.
+ * Pre-rendered samples can also be mixed in without any synthesis.
+ * Voices are mixed in fixed point and rendered in blocks through
+ * the AudioSource interface so they can be passed to AUDIOOUTPUT_fill.
+ *
+ * Company: University of Leeds
+ * Author: Kaif Kutchwala, Emmanuel Leo, Varun Gonsalves
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 19/10/2026 | Creation of driver
+ * 19/10/2026 | Add offline note rendering and cached sample playback
+ */
+
+// Include External Libraries
+#include "AudioSynth.h"  // Include header for the Audio Synthesiser
+
+#include "WaveTable.h"  // Include waveform tables used by the oscillators
+
+// Use the NEON mixer when the compiler is targeting a core with NEON
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+// Envelope level that represents full scale (Q28 so a single step can never overflow)
+#define SYNTH_LEVEL_FULL (1 << 28)
+
+// Number of samples in one millisecond
+#define SYNTH_SAMPLES_PER_MS (AUDIOOUTPUT_getSampleRate() / 1000)
+
+// Largest 24-bit sample value that can be sent to the codec
+#define SYNTH_SAMPLE_MAX 8388607
+
+// Envelope stages
+#define SYNTH_STAGE_IDLE 0
+#define SYNTH_STAGE_ATTACK 1
+#define SYNTH_STAGE_DECAY 2
+#define SYNTH_STAGE_SUSTAIN 3
+#define SYNTH_STAGE_RELEASE 4
+
+// Entry in a voice's note queue. A zero increment is a rest.
+typedef struct {
+    unsigned int increment;  // Phase increment of the note
+    unsigned int samples;    // Length of the note in samples
+} SynthNote;
+
+// State of a single voice
+typedef struct {
+    AudioOscillator oscillator;  // DDS oscillator
+    const signed short *table;   // Waveform table used by the oscillator
+    unsigned int stage;          // Current envelope stage
+    signed int level;            // Current envelope level in Q28
+    signed int attack_step;      // Level added per sample in attack
+    signed int decay_step;       // Level removed per sample in decay
+    signed int sustain_level;    // Level held in sustain
+    signed int release_step;     // Level removed per sample in release
+    signed int gain;             // Gain of the voice in Q15
+    bool timed;                  // True if the current note ends after samples_left
+    unsigned int samples_left;   // Samples left in the current note
+    SynthNote queue[SYNTH_QUEUE_LENGTH];  // Notes waiting to be played
+    unsigned int queue_head;              // Index of the next note to play
+    unsigned int queue_count;             // Number of notes waiting
+} SynthVoice;
+
+SynthVoice voices[SYNTH_NUM_VOICES];
+
+// A pre-rendered sample being played
+typedef struct {
+    const signed short *samples;  // Next Q15 sample to play
+    unsigned int remaining;       // Samples left to play, 0 if the slot is free
+    signed int gain;              // Gain of the sample in Q15
+} SynthSample;
+
+SynthSample sample_slots[SYNTH_NUM_SAMPLE_SLOTS];
+
+// Buffers used while rendering a block
+signed short voice_buffer[AUDIOOUTPUT_BLOCK_FRAMES];  // Output of one voice in Q15
+signed int mix_buffer[AUDIOOUTPUT_BLOCK_FRAMES];      // Sum of all voices in Q27
+
+// Audio source for AUDIOOUTPUT_fill
+AudioSource synth_source = {&SYNTH_render, 0};
+
+// Helper Methods
+
+// Converts a time in ms to a per-sample step that moves `range` in that time
+signed int envelopeStep(unsigned int time_ms, signed int range) {
+    unsigned int samples = time_ms * SYNTH_SAMPLES_PER_MS;
+    // A zero time means change in a single sample
+    if (samples == 0) samples = 1;
+    return range / (signed int)samples;
+}
+
+// Starts the next queued note, or releases the voice if the queue is empty
+void startNextNote(SynthVoice *voice) {
+    SynthNote *note;
+    if (voice->queue_count) {
+        note = &voice->queue[voice->queue_head];
+        voice->queue_head = (voice->queue_head + 1) % SYNTH_QUEUE_LENGTH;
+        voice->queue_count--;
+        voice->timed = true;
+        voice->samples_left = note->samples;
+        if (note->increment) {
+            // Keep the phase and level so the change of note does not click
+            voice->oscillator.increment = note->increment;
+            voice->stage = SYNTH_STAGE_ATTACK;
+        } else if (voice->stage != SYNTH_STAGE_IDLE) {
+            // Rests release the previous note
+            voice->stage = SYNTH_STAGE_RELEASE;
+        }
+    } else {
+        voice->timed = false;
+        if (voice->stage != SYNTH_STAGE_IDLE) voice->stage = SYNTH_STAGE_RELEASE;
+    }
+}
+
+// Renders `frames` samples of a voice into voice_buffer in Q15
+void renderVoice(SynthVoice *voice, unsigned int frames) {
+    unsigned int i;
+    for (i = 0; i < frames; i++) {
+        // Move on to the next note when the current one runs out
+        if (voice->timed) {
+            if (voice->samples_left == 0) startNextNote(voice);
+            if (voice->samples_left) voice->samples_left--;
+        }
+
+        // Step the envelope
+        switch (voice->stage) {
+            case SYNTH_STAGE_ATTACK:
+                voice->level += voice->attack_step;
+                if (voice->level >= SYNTH_LEVEL_FULL) {
+                    voice->level = SYNTH_LEVEL_FULL;
+                    voice->stage = SYNTH_STAGE_DECAY;
+                }
+                break;
+            case SYNTH_STAGE_DECAY:
+                voice->level -= voice->decay_step;
+                if (voice->level <= voice->sustain_level) {
+                    voice->level = voice->sustain_level;
+                    voice->stage = SYNTH_STAGE_SUSTAIN;
+                }
+                break;
+            case SYNTH_STAGE_RELEASE:
+                voice->level -= voice->release_step;
+                if (voice->level <= 0) {
+                    voice->level = 0;
+                    voice->stage = SYNTH_STAGE_IDLE;
+                }
+                break;
+        }
+
+        // Oscillator output (Q15) x envelope (Q28 -> Q15) gives Q15
+        voice->oscillator.phase += voice->oscillator.increment;
+        voice_buffer[i] = (signed short)((WT_lookup(voice->table, voice->oscillator.phase) * (voice->level >> 13)) >> 15);
+    }
+}
+
+// Adds samples x gain into mix_buffer
+void mixSamples(const signed short samples[], signed int gain, unsigned int frames) {
+    unsigned int i = 0;
+    // Drop the gain to Q12 so the sum of every voice at full gain still fits in 32 bits
+    signed short mix_gain = (signed short)(gain >> 3);
+#ifdef __ARM_NEON__
+    // Multiply-accumulate 4 samples per instruction
+    for (; i + 4 <= frames; i += 4) {
+        int32x4_t acc = vld1q_s32(&mix_buffer[i]);
+        acc = vmlal_n_s16(acc, vld1_s16(&samples[i]), mix_gain);
+        vst1q_s32(&mix_buffer[i], acc);
+    }
+#endif
+    // Scalar path, also handles any frames left over from the NEON loop
+    for (; i < frames; i++) {
+        mix_buffer[i] += samples[i] * mix_gain;
+    }
+}
+
+// Adds notes to the end of the queue of a voice
+signed int queueVoiceNotes(SynthVoice *v, const AudioNote notes[], unsigned int count) {
+    unsigned int i, index;
+    // Check there is room for the whole sequence
+    if (count > SYNTH_QUEUE_LENGTH - v->queue_count) return SYNTH_QUEUEFULL;
+
+    for (i = 0; i < count; i++) {
+        index = (v->queue_head + v->queue_count) % SYNTH_QUEUE_LENGTH;
+        v->queue[index].increment = (notes[i].frequency == AUDIO_REST) ? 0 : AUDIOOUTPUT_frequencyToIncrement(notes[i].frequency);
+        v->queue[index].samples = notes[i].duration_ms * SYNTH_SAMPLES_PER_MS;
+        v->queue_count++;
+    }
+    // If the voice is not already working through a sequence, start now
+    if (!v->timed) {
+        v->samples_left = 0;
+        v->timed = true;
+    }
+    return SYNTH_SUCCESS;
+}
+
+// Checks a voice number is valid
+bool validVoice(unsigned int voice) {
+    return voice < SYNTH_NUM_VOICES;
+}
+
+// Sets every voice to a sine wave with a short click-free envelope
+signed int SYNTH_initialise(void) {
+    unsigned int voice, slot;
+    for (voice = 0; voice < SYNTH_NUM_VOICES; voice++) {
+        voices[voice].oscillator.phase = 0;
+        voices[voice].oscillator.increment = 0;
+        voices[voice].stage = SYNTH_STAGE_IDLE;
+        voices[voice].level = 0;
+        voices[voice].timed = false;
+        voices[voice].samples_left = 0;
+        voices[voice].queue_head = 0;
+        voices[voice].queue_count = 0;
+        SYNTH_setWaveform(voice, SYNTH_WAVE_SINE);
+        SYNTH_setEnvelope(voice, 5, 50, 70, 30);
+        SYNTH_setGain(voice, 100);
+    }
+    for (slot = 0; slot < SYNTH_NUM_SAMPLE_SLOTS; slot++) {
+        sample_slots[slot].remaining = 0;
+    }
+    return SYNTH_SUCCESS;
+}
+
+// Selects the waveform table for a voice
+signed int SYNTH_setWaveform(unsigned int voice, unsigned int waveform) {
+    if (!validVoice(voice)) return SYNTH_INVALIDVOICE;
+    switch (waveform) {
+        case SYNTH_WAVE_SINE:
+            voices[voice].table = WT_sine;
+            break;
+        case SYNTH_WAVE_SQUARE:
+            voices[voice].table = WT_square;
+            break;
+        case SYNTH_WAVE_TRIANGLE:
+            voices[voice].table = WT_triangle;
+            break;
+        default:
+            return SYNTH_INVALIDWAVE;
+    }
+    return SYNTH_SUCCESS;
+}
+
+// Converts the ADSR times to per-sample steps
+signed int SYNTH_setEnvelope(unsigned int voice, unsigned int attack_ms, unsigned int decay_ms, unsigned int sustain, unsigned int release_ms) {
+    if (!validVoice(voice)) return SYNTH_INVALIDVOICE;
+    if (sustain > 100) sustain = 100;
+    voices[voice].sustain_level = (SYNTH_LEVEL_FULL / 100) * sustain;
+    voices[voice].attack_step = envelopeStep(attack_ms, SYNTH_LEVEL_FULL);
+    voices[voice].decay_step = envelopeStep(decay_ms, SYNTH_LEVEL_FULL - voices[voice].sustain_level);
+    voices[voice].release_step = envelopeStep(release_ms, SYNTH_LEVEL_FULL);
+    // A decay to a sustain of 100% still needs to move on to the sustain stage
+    if (voices[voice].decay_step == 0) voices[voice].decay_step = 1;
+    return SYNTH_SUCCESS;
+}
+
+// Sets the gain of a voice from a 0 - 100 volume
+signed int SYNTH_setGain(unsigned int voice, unsigned int volume) {
+    if (!validVoice(voice)) return SYNTH_INVALIDVOICE;
+    if (volume > 100) volume = 100;
+    voices[voice].gain = (32767 * volume) / 100;
+    return SYNTH_SUCCESS;
+}
+
+// Starts a held note straight away
+signed int SYNTH_noteOn(unsigned int voice, unsigned int increment) {
+    if (!validVoice(voice)) return SYNTH_INVALIDVOICE;
+    voices[voice].queue_count = 0;
+    voices[voice].timed = false;
+    voices[voice].oscillator.increment = increment;
+    voices[voice].stage = SYNTH_STAGE_ATTACK;
+    return SYNTH_SUCCESS;
+}
+
+// Releases the current note
+signed int SYNTH_noteOff(unsigned int voice) {
+    if (!validVoice(voice)) return SYNTH_INVALIDVOICE;
+    if (voices[voice].stage != SYNTH_STAGE_IDLE) voices[voice].stage = SYNTH_STAGE_RELEASE;
+    return SYNTH_SUCCESS;
+}
+
+// Adds notes to the end of a voice's queue
+signed int SYNTH_queueNotes(unsigned int voice, const AudioNote notes[], unsigned int count) {
+    if (!validVoice(voice)) return SYNTH_INVALIDVOICE;
+    return queueVoiceNotes(&voices[voice], notes, count);
+}
+
+// Renders notes with a copy of a voice's settings into a buffer
+signed int SYNTH_renderNotes(unsigned int voice, const AudioNote notes[], unsigned int count, signed short buffer[], unsigned int max_samples) {
+    SynthVoice offline;
+    unsigned int written = 0;
+    unsigned int frames, i;
+    signed int status;
+
+    if (!validVoice(voice)) return SYNTH_INVALIDVOICE;
+
+    // Same waveform and envelope as the voice, but starting from silence
+    offline = voices[voice];
+    offline.oscillator.phase = 0;
+    offline.stage = SYNTH_STAGE_IDLE;
+    offline.level = 0;
+    offline.timed = false;
+    offline.samples_left = 0;
+    offline.queue_head = 0;
+    offline.queue_count = 0;
+    status = queueVoiceNotes(&offline, notes, count);
+    if (status != SYNTH_SUCCESS) return status;
+
+    // Render until the last note has been released
+    while ((written < max_samples) && ((offline.stage != SYNTH_STAGE_IDLE) || offline.timed)) {
+        frames = max_samples - written;
+        if (frames > AUDIOOUTPUT_BLOCK_FRAMES) frames = AUDIOOUTPUT_BLOCK_FRAMES;
+        renderVoice(&offline, frames);
+        for (i = 0; i < frames; i++) {
+            buffer[written + i] = voice_buffer[i];
+        }
+        written += frames;
+    }
+    return (signed int)written;
+}
+
+// Starts a pre-rendered sample in a slot
+signed int SYNTH_playSample(unsigned int slot, const signed short samples[], unsigned int length, unsigned int volume) {
+    if (slot >= SYNTH_NUM_SAMPLE_SLOTS) return SYNTH_INVALIDVOICE;
+    if (volume > 100) volume = 100;
+    // Set the length last so the slot is never played half set up
+    sample_slots[slot].remaining = 0;
+    sample_slots[slot].samples = samples;
+    sample_slots[slot].gain = (32767 * volume) / 100;
+    sample_slots[slot].remaining = length;
+    return SYNTH_SUCCESS;
+}
+
+// Discards queued notes and releases the voice
+signed int SYNTH_stopVoice(unsigned int voice) {
+    if (!validVoice(voice)) return SYNTH_INVALIDVOICE;
+    voices[voice].queue_count = 0;
+    voices[voice].timed = false;
+    return SYNTH_noteOff(voice);
+}
+
+// Returns true if the voice is sounding or has notes waiting
+bool SYNTH_isActive(unsigned int voice) {
+    if (!validVoice(voice)) return false;
+    return (voices[voice].stage != SYNTH_STAGE_IDLE) || voices[voice].timed;
+}
+
+// Renders and mixes every active voice
+unsigned int SYNTH_render(signed int left[], signed int right[], unsigned int frames, void *context) {
+    unsigned int voice, slot, length, i;
+    signed int sample;
+    bool active = false;
+    (void)context;
+
+    if (frames > AUDIOOUTPUT_BLOCK_FRAMES) frames = AUDIOOUTPUT_BLOCK_FRAMES;
+
+    // Clear the mix
+    for (i = 0; i < frames; i++) {
+        mix_buffer[i] = 0;
+    }
+
+    // Render and mix each voice that has something to play
+    for (voice = 0; voice < SYNTH_NUM_VOICES; voice++) {
+        if (!SYNTH_isActive(voice)) continue;
+        active = true;
+        renderVoice(&voices[voice], frames);
+        mixSamples(voice_buffer, voices[voice].gain, frames);
+    }
+
+    // Mix in any pre-rendered samples, no synthesis is needed for these
+    for (slot = 0; slot < SYNTH_NUM_SAMPLE_SLOTS; slot++) {
+        if (!sample_slots[slot].remaining) continue;
+        active = true;
+        length = (sample_slots[slot].remaining < frames) ? sample_slots[slot].remaining : frames;
+        mixSamples(sample_slots[slot].samples, sample_slots[slot].gain, length);
+        sample_slots[slot].samples += length;
+        sample_slots[slot].remaining -= length;
+    }
+
+    // Write nothing if every voice is silent
+    if (!active) return 0;
+
+    // Convert the Q27 mix to 24-bit samples, saturating rather than wrapping
+    for (i = 0; i < frames; i++) {
+        sample = mix_buffer[i] >> 4;
+        if (sample > SYNTH_SAMPLE_MAX) sample = SYNTH_SAMPLE_MAX;
+        if (sample < -SYNTH_SAMPLE_MAX) sample = -SYNTH_SAMPLE_MAX;
+        left[i] = sample;
+        right[i] = sample;
+    }
+    return frames;
+}
+
+// Returns the audio source that renders the synthesiser
+AudioSource *SYNTH_getSource(void) {
+    return &synth_source;
+}
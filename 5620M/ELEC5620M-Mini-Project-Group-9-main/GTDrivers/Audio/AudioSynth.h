@@ -0,0 +1,244 @@
+/*
+ *  DE1-SoC Audio Synthesiser
+ * ------------------------------
+ * Description:
+ * Small polyphonic synthesiser for sound effects and music.
+ * Each voice has a table oscillator (sine, square or triangle),
+ * an ADSR envelope, a gain and a queue of notes to play.
+ * Pre-rendered samples can also be mixed in without any synthesis.
+ * Voices are mixed in fixed point and rendered in blocks through
+ * the AudioSource interface so they can be passed to AUDIOOUTPUT_fill.
+ *
+ * Company: University of Leeds
+ * Author: Kaif Kutchwala, Emmanuel Leo, Varun Gonsalves
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 19/10/2026 | Creation of driver
+ * 19/10/2026 | Add offline note rendering and cached sample playback
+ */
+
+#ifndef AUDIO_SYNTH_
+#define AUDIO_SYNTH_
+
+#include <stdbool.h>
+
+#include "AudioOutput.h"
+
+// Number of voices that can play at the same time. The voices and the
+// sample slots add up in a 32-bit mix that holds 15 of them at full scale,
+// and MathClub/Headless/HeadlessVoices.c measures what each voice costs.
+#define SYNTH_NUM_VOICES 8
+
+// Maximum number of notes waiting on each voice
+#define SYNTH_QUEUE_LENGTH 16
+
+// Number of pre-rendered samples that can play at the same time
+#define SYNTH_NUM_SAMPLE_SLOTS 4
+
+// Waveform Selection Options
+#define SYNTH_WAVE_SINE 0
+#define SYNTH_WAVE_SQUARE 1
+#define SYNTH_WAVE_TRIANGLE 2
+
+// Define Status codes
+#define SYNTH_SUCCESS 0
+#define SYNTH_INVALIDVOICE -1
+#define SYNTH_INVALIDWAVE -2
+#define SYNTH_QUEUEFULL -3
+
+/*
+ *  SYNTH_initialise
+ *
+ *  Silences all voices and sets every voice to a sine wave with a short
+ *  click-free default envelope.
+ *
+ *  Output:
+ *              SYNTH_SUCCESS
+ */
+signed int SYNTH_initialise(void);
+
+/*
+ *  SYNTH_setWaveform
+ *
+ *  Selects the oscillator waveform of a voice.
+ *
+ *  Inputs:
+ *              voice:          Voice to change (0 - SYNTH_NUM_VOICES-1)
+ *              waveform:       SYNTH_WAVE_SINE, SYNTH_WAVE_SQUARE or SYNTH_WAVE_TRIANGLE
+ *
+ *  Output:
+ *              SYNTH_SUCCESS, SYNTH_INVALIDVOICE or SYNTH_INVALIDWAVE
+ */
+signed int SYNTH_setWaveform(unsigned int voice, unsigned int waveform);
+
+/*
+ *  SYNTH_setEnvelope
+ *
+ *  Sets the ADSR envelope of a voice. Times are converted to per-sample
+ *  steps here so rendering stays integer only, using the sample rate
+ *  set with AUDIOOUTPUT_setSampleRate.
+ *
+ *  Inputs:
+ *              voice:          Voice to change (0 - SYNTH_NUM_VOICES-1)
+ *              attack_ms:      Time to rise from silence to full level
+ *              decay_ms:       Time to fall from full level to the sustain level
+ *              sustain:        Level held while the note plays (0 - 100)
+ *              release_ms:     Time to fall from full level to silence after the note ends
+ *
+ *  Output:
+ *              SYNTH_SUCCESS or SYNTH_INVALIDVOICE
+ */
+signed int SYNTH_setEnvelope(unsigned int voice, unsigned int attack_ms, unsigned int decay_ms, unsigned int sustain, unsigned int release_ms);
+
+/*
+ *  SYNTH_setGain
+ *
+ *  Sets the gain of a voice.
+ *
+ *  Inputs:
+ *              voice:          Voice to change (0 - SYNTH_NUM_VOICES-1)
+ *              volume:         Volume of the voice (0 - 100)
+ *
+ *  Output:
+ *              SYNTH_SUCCESS or SYNTH_INVALIDVOICE
+ */
+signed int SYNTH_setGain(unsigned int voice, unsigned int volume);
+
+/*
+ *  SYNTH_noteOn
+ *
+ *  Starts a note on a voice straight away. The note is held at the
+ *  sustain level until SYNTH_noteOff is called. Any queued notes are
+ *  discarded. The oscillator phase and envelope level carry on from
+ *  where they were so there is no click.
+ *
+ *  Inputs:
+ *              voice:          Voice to play on (0 - SYNTH_NUM_VOICES-1)
+ *              increment:      Phase increment of the note, see AUDIOOUTPUT_noteIncrement
+ *
+ *  Output:
+ *              SYNTH_SUCCESS or SYNTH_INVALIDVOICE
+ */
+signed int SYNTH_noteOn(unsigned int voice, unsigned int increment);
+
+/*
+ *  SYNTH_noteOff
+ *
+ *  Moves a voice into its release stage.
+ *
+ *  Inputs:
+ *              voice:          Voice to release (0 - SYNTH_NUM_VOICES-1)
+ *
+ *  Output:
+ *              SYNTH_SUCCESS or SYNTH_INVALIDVOICE
+ */
+signed int SYNTH_noteOff(unsigned int voice);
+
+/*
+ *  SYNTH_queueNotes
+ *
+ *  Adds a sequence of notes to the end of a voice's queue. Each note is
+ *  started when the previous one ends, and the voice is released after
+ *  the last note. Either the whole sequence is queued or none of it is.
+ *
+ *  Inputs:
+ *              voice:          Voice to play on (0 - SYNTH_NUM_VOICES-1)
+ *              notes:          Array of notes to play in order
+ *              count:          Number of notes in the array
+ *
+ *  Output:
+ *              SYNTH_SUCCESS, SYNTH_INVALIDVOICE or SYNTH_QUEUEFULL
+ */
+signed int SYNTH_queueNotes(unsigned int voice, const AudioNote notes[], unsigned int count);
+
+/*
+ *  SYNTH_renderNotes
+ *
+ *  Renders a sequence of notes into a buffer using the waveform and
+ *  envelope of a voice, at full gain. The voice itself is not affected,
+ *  so this can be used at startup to pre-render sound effects for
+ *  SYNTH_playSample. Rendering stops once the last note has been
+ *  released, or when the buffer is full.
+ *
+ *  Inputs:
+ *              voice:          Voice whose settings are used (0 - SYNTH_NUM_VOICES-1)
+ *              notes:          Array of notes to render in order
+ *              count:          Number of notes in the array (up to SYNTH_QUEUE_LENGTH)
+ *              buffer:         Buffer to write Q15 samples to
+ *              max_samples:    Size of the buffer
+ *
+ *  Output:
+ *              Number of samples written, or SYNTH_INVALIDVOICE or SYNTH_QUEUEFULL
+ */
+signed int SYNTH_renderNotes(unsigned int voice, const AudioNote notes[], unsigned int count, signed short buffer[], unsigned int max_samples);
+
+/*
+ *  SYNTH_playSample
+ *
+ *  Plays a pre-rendered sample, such as one from SYNTH_renderNotes.
+ *  The samples are only mixed, so this costs no synthesis. Anything
+ *  already playing in the slot is replaced. The samples must stay in
+ *  memory until they have finished playing.
+ *
+ *  Inputs:
+ *              slot:           Sample slot to play in (0 - SYNTH_NUM_SAMPLE_SLOTS-1)
+ *              samples:        Q15 samples to play
+ *              length:         Number of samples
+ *              volume:         Volume of the sample (0 - 100)
+ *
+ *  Output:
+ *              SYNTH_SUCCESS or SYNTH_INVALIDVOICE if the slot is invalid
+ */
+signed int SYNTH_playSample(unsigned int slot, const signed short samples[], unsigned int length, unsigned int volume);
+
+/*
+ *  SYNTH_stopVoice
+ *
+ *  Discards a voice's queued notes and releases the current one.
+ *
+ *  Inputs:
+ *              voice:          Voice to stop (0 - SYNTH_NUM_VOICES-1)
+ *
+ *  Output:
+ *              SYNTH_SUCCESS or SYNTH_INVALIDVOICE
+ */
+signed int SYNTH_stopVoice(unsigned int voice);
+
+/*
+ *  SYNTH_isActive
+ *
+ *  Output:
+ *              true if the voice is producing sound or has notes queued
+ */
+bool SYNTH_isActive(unsigned int voice);
+
+/*
+ *  SYNTH_render
+ *
+ *  Renders and mixes all active voices. Has the same signature as
+ *  AudioSourceCallback. Returns 0 when every voice and sample slot is
+ *  silent so that nothing is written to the codec while idle.
+ *
+ *  Inputs:
+ *              left, right:    Buffers to write 24-bit samples to
+ *              frames:         Number of frames to render (up to AUDIOOUTPUT_BLOCK_FRAMES)
+ *              context:        Unused
+ *
+ *  Output:
+ *              Number of frames rendered
+ */
+unsigned int SYNTH_render(signed int left[], signed int right[], unsigned int frames, void *context);
+
+/*
+ *  SYNTH_getSource
+ *
+ *  Output:
+ *              AudioSource that renders the synthesiser, for AUDIOOUTPUT_fill
+ *              or AUDIOOUTPUT_setSource
+ */
+AudioSource *SYNTH_getSource(void);
+
+#endif
@@ -0,0 +1,275 @@
+/*
+ *  DE1-SoC WAV Player
+ * ------------------------------
+ * Description:
+ * Streams 16-bit PCM WAV files from the SD card to the audio codec.
+ * The file is read through FatFS into two sector-aligned buffers.
+ * WAVPLAYER_service refills one buffer while the other is drained by
+ * WAVPLAYER_render, which converts the samples to the codec's 24-bit
+ * format. Mono files are played on both channels.
+ *
+ * Company: University of Leeds
+ * Author: Kaif Kutchwala, Emmanuel Leo, Varun Gonsalves
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 19/10/2026 | Creation of driver
+ */
+
+// Include External Libraries
+#include "WavPlayer.h"  // Include header for the WAV Player
+
+#include <string.h>
+
+#include "FatFS/ff.h"  // Include FatFS to read from the SD card
+
+// Size of an SD card sector
+#define WAVPLAYER_SECTOR_SIZE 512
+
+// Size of each stream buffer in bytes
+#define WAVPLAYER_BUFFER_BYTES (WAVPLAYER_BUFFER_SECTORS * WAVPLAYER_SECTOR_SIZE)
+
+// Number of stream buffers
+#define WAVPLAYER_NUM_BUFFERS 2
+
+// Buffers are aligned to a sector so FatFS can read whole sectors straight into them
+#ifdef __ARMCC_VERSION
+#define WAVPLAYER_ALIGNED __align(WAVPLAYER_SECTOR_SIZE)
+#else
+#define WAVPLAYER_ALIGNED __attribute__((aligned(WAVPLAYER_SECTOR_SIZE)))
+#endif
+
+// State of a stream buffer
+typedef struct {
+    unsigned int position;  // Index of the next byte to play
+    unsigned int length;    // Number of bytes read into the buffer
+    bool ready;             // True once filled, false once drained
+} WavBuffer;
+
+WAVPLAYER_ALIGNED unsigned char wav_data[WAVPLAYER_NUM_BUFFERS][WAVPLAYER_BUFFER_BYTES];
+WavBuffer wav_buffers[WAVPLAYER_NUM_BUFFERS];
+unsigned int wav_play_buffer;  // Buffer currently being drained
+
+FIL wav_file;                  // File being played
+bool wav_open = false;         // True while wav_file is open
+unsigned int wav_channels;     // Number of channels in the file (1 or 2)
+unsigned int wav_data_left;    // Bytes of sample data not yet read from the file
+unsigned int wav_underruns;    // Number of times the buffers ran dry
+
+// Audio source for AUDIOOUTPUT_fill
+AudioSource wav_source = {&WAVPLAYER_render, 0};
+
+// Helper Methods
+
+// Reads little endian values from a file header
+unsigned int readLE16(const unsigned char bytes[]) {
+    return bytes[0] | (bytes[1] << 8);
+}
+
+unsigned int readLE32(const unsigned char bytes[]) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+}
+
+// Walks the RIFF chunks of the open file. On success the file is left at the start
+// of the sample data, and data_offset and data_size describe where it is.
+signed int parseWavHeader(unsigned int *data_offset, unsigned int *data_size) {
+    unsigned char header[16];
+    UINT bytes_read;
+    unsigned int chunk_size;
+    unsigned int skip;
+    bool found_format = false;
+
+    // RIFF header: "RIFF", file size, "WAVE"
+    if ((f_read(&wav_file, header, 12, &bytes_read) != FR_OK) || (bytes_read != 12)) return WAVPLAYER_ERRORFILE;
+    if (memcmp(header, "RIFF", 4) || memcmp(&header[8], "WAVE", 4)) return WAVPLAYER_INVALIDFILE;
+
+    while (1) {
+        // Chunk header: ID, size
+        if ((f_read(&wav_file, header, 8, &bytes_read) != FR_OK) || (bytes_read != 8)) return WAVPLAYER_INVALIDFILE;
+        chunk_size = readLE32(&header[4]);
+        skip = chunk_size;
+
+        if (!memcmp(header, "fmt ", 4)) {
+            // Format chunk: format, channels, sample rate, byte rate, block align, bits per sample
+            if (chunk_size < 16) return WAVPLAYER_INVALIDFILE;
+            if ((f_read(&wav_file, header, 16, &bytes_read) != FR_OK) || (bytes_read != 16)) return WAVPLAYER_INVALIDFILE;
+            wav_channels = readLE16(&header[2]);
+            if ((readLE16(&header[0]) != 1) ||                            // Integer PCM only
+                (wav_channels < 1) || (wav_channels > 2) ||               // Mono or stereo
+                (readLE32(&header[4]) != AUDIOOUTPUT_getSampleRate()) ||  // No resampling
+                (readLE16(&header[14]) != 16)) {                          // 16-bit samples
+                return WAVPLAYER_UNSUPPORTED;
+            }
+            found_format = true;
+            skip = chunk_size - 16;
+        } else if (!memcmp(header, "data", 4)) {
+            // Sample data, which must come after the format
+            if (!found_format) return WAVPLAYER_INVALIDFILE;
+            *data_offset = f_tell(&wav_file);
+            *data_size = chunk_size;
+            // Ignore any part of the chunk missing from a truncated file
+            if (*data_size > f_size(&wav_file) - *data_offset) {
+                *data_size = f_size(&wav_file) - *data_offset;
+            }
+            return WAVPLAYER_SUCCESS;
+        }
+
+        // Skip the rest of the chunk, chunks are padded to an even size
+        if (f_lseek(&wav_file, f_tell(&wav_file) + skip + (chunk_size & 1)) != FR_OK) return WAVPLAYER_ERRORFILE;
+    }
+}
+
+// Reads the next part of the file into a buffer. The first skip bytes read
+// are not sample data and are not played.
+void fillWavBuffer(unsigned int index, unsigned int skip) {
+    UINT bytes_read;
+    UINT bytes_to_read = WAVPLAYER_BUFFER_BYTES;
+
+    if (bytes_to_read > wav_data_left + skip) {
+        bytes_to_read = wav_data_left + skip;
+    }
+
+    // Give up on the rest of the file if it can't be read
+    if ((f_read(&wav_file, wav_data[index], bytes_to_read, &bytes_read) != FR_OK) || (bytes_read < skip + 2)) {
+        wav_data_left = 0;
+        return;
+    }
+
+    wav_data_left -= bytes_read - skip;
+    wav_buffers[index].position = skip;
+    wav_buffers[index].length = bytes_read;
+    wav_buffers[index].ready = true;
+}
+
+// Reads the next 16-bit sample from the buffers and returns it as 24-bit.
+// The caller has already checked that there is a sample to read.
+signed int readWavSample(void) {
+    WavBuffer *buffer = &wav_buffers[wav_play_buffer];
+    const unsigned char *bytes = &wav_data[wav_play_buffer][buffer->position];
+
+    // Move on to the other buffer once this one is drained so it can be refilled
+    buffer->position += 2;
+    if (buffer->position + 2 > buffer->length) {
+        buffer->ready = false;
+        wav_play_buffer ^= 1;
+    }
+
+    return ((signed short)(bytes[0] | (bytes[1] << 8))) << 8;
+}
+
+// Driver Functions
+
+signed int WAVPLAYER_open(char filename[]) {
+    unsigned int data_offset;
+    unsigned int data_size;
+    unsigned int skip;
+    unsigned int i;
+    signed int status;
+
+    // Only one file is played at a time
+    WAVPLAYER_close();
+
+    if (f_open(&wav_file, filename, FA_READ) != FR_OK) return WAVPLAYER_ERRORFILE;
+    wav_open = true;
+
+    status = parseWavHeader(&data_offset, &data_size);
+    if (status != WAVPLAYER_SUCCESS) {
+        WAVPLAYER_close();
+        return status;
+    }
+
+    // Read from the start of the sector holding the first sample so every read
+    // after the first header sector is whole, aligned sectors
+    skip = data_offset % WAVPLAYER_SECTOR_SIZE;
+    if (f_lseek(&wav_file, data_offset - skip) != FR_OK) {
+        WAVPLAYER_close();
+        return WAVPLAYER_ERRORFILE;
+    }
+
+    // Fill both buffers before playback starts
+    wav_data_left = data_size;
+    wav_play_buffer = 0;
+    wav_underruns = 0;
+    for (i = 0; i < WAVPLAYER_NUM_BUFFERS; i++) {
+        wav_buffers[i].ready = false;
+        fillWavBuffer(i, (i == 0) ? skip : 0);
+    }
+    return WAVPLAYER_SUCCESS;
+}
+
+void WAVPLAYER_service(void) {
+    unsigned int index;
+    unsigned int i;
+
+    if (!wav_open) return;
+
+    // Refill drained buffers while there is data left, starting with the one
+    // that will be played first so the file is read in order
+    for (i = 0; i < WAVPLAYER_NUM_BUFFERS; i++) {
+        index = (wav_play_buffer + i) % WAVPLAYER_NUM_BUFFERS;
+        if (!wav_buffers[index].ready && wav_data_left) {
+            fillWavBuffer(index, 0);
+        }
+    }
+
+    // Close the file once the last sample has been played
+    if (!WAVPLAYER_isPlaying()) {
+        WAVPLAYER_close();
+    }
+}
+
+unsigned int WAVPLAYER_render(signed int left[], signed int right[], unsigned int frames, void *context) {
+    unsigned int frame_bytes = wav_channels * 2;
+    unsigned int available;
+    unsigned int frame;
+    WavBuffer *buffer;
+    WavBuffer *next;
+    (void)context;
+
+    if (!wav_open) return 0;
+
+    for (frame = 0; frame < frames; frame++) {
+        // Check a whole frame is buffered before reading any of it, as a
+        // stereo frame can be split across the two buffers
+        buffer = &wav_buffers[wav_play_buffer];
+        next = &wav_buffers[wav_play_buffer ^ 1];
+        available = 0;
+        if (buffer->ready) {
+            available = buffer->length - buffer->position;
+            if (next->ready) available += next->length - next->position;
+        }
+        if (available < frame_bytes) {
+            // Out of samples before the end of the file
+            if (wav_data_left) wav_underruns++;
+            break;
+        }
+
+        left[frame] = readWavSample();
+        right[frame] = (wav_channels == 2) ? readWavSample() : left[frame];
+    }
+    return frame;
+}
+
+AudioSource *WAVPLAYER_getSource(void) {
+    return &wav_source;
+}
+
+bool WAVPLAYER_isPlaying(void) {
+    return wav_open && (wav_data_left || wav_buffers[0].ready || wav_buffers[1].ready);
+}
+
+unsigned int WAVPLAYER_getUnderruns(void) {
+    return wav_underruns;
+}
+
+void WAVPLAYER_close(void) {
+    if (wav_open) {
+        f_close(&wav_file);
+        wav_open = false;
+    }
+    wav_buffers[0].ready = false;
+    wav_buffers[1].ready = false;
+    wav_data_left = 0;
+}
@@ -0,0 +1,112 @@
+/*
+ *  DE1-SoC WAV Player
+ * ------------------------------
+ * Description:
+ * Streams 16-bit PCM WAV files from the SD card to the audio codec.
+ * The file is read through FatFS into two sector-aligned buffers.
+ * WAVPLAYER_service refills one buffer while the other is drained by
+ * WAVPLAYER_render, which converts the samples to the codec's 24-bit
+ * format. Mono files are played on both channels.
+ *
+ * Company: University of Leeds
+ * Author: Kaif Kutchwala, Emmanuel Leo, Varun Gonsalves
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 19/10/2026 | Creation of driver
+ */
+
+#ifndef WAV_PLAYER_
+#define WAV_PLAYER_
+
+#include <stdbool.h>
+
+#include "AudioOutput.h"
+
+// Size of each stream buffer in SD card sectors
+#define WAVPLAYER_BUFFER_SECTORS 32
+
+// Define Status codes
+#define WAVPLAYER_SUCCESS 0
+#define WAVPLAYER_ERRORFILE -1     // File could not be opened or read
+#define WAVPLAYER_INVALIDFILE -2   // File is not a WAV file
+#define WAVPLAYER_UNSUPPORTED -3   // File is not 16-bit mono/stereo PCM at the codec sample rate
+
+/*
+ *  WAVPLAYER_open
+ *
+ *  Opens a WAV file, checks its format and fills both buffers so that
+ *  playback can start straight away. Any file already playing is closed.
+ *  The SD card must have been mounted with SDCARD_mount.
+ *
+ *  Inputs:
+ *              filename:       Name of the file to play
+ *
+ *  Output:
+ *              WAVPLAYER_SUCCESS, WAVPLAYER_ERRORFILE, WAVPLAYER_INVALIDFILE
+ *              or WAVPLAYER_UNSUPPORTED
+ */
+signed int WAVPLAYER_open(char filename[]);
+
+/*
+ *  WAVPLAYER_service
+ *
+ *  Refills any buffer that has been drained. Call this regularly
+ *  from the main loop while a file is playing.
+ */
+void WAVPLAYER_service(void);
+
+/*
+ *  WAVPLAYER_render
+ *
+ *  Converts the next frames of the file to 24-bit samples. Has the same
+ *  signature as AudioSourceCallback. Returns fewer frames than asked for
+ *  at the end of the file, or if WAVPLAYER_service has not refilled the
+ *  next buffer in time (an underrun).
+ *
+ *  Inputs:
+ *              left, right:    Buffers to write 24-bit samples to
+ *              frames:         Number of frames to render
+ *              context:        Unused
+ *
+ *  Output:
+ *              Number of frames rendered
+ */
+unsigned int WAVPLAYER_render(signed int left[], signed int right[], unsigned int frames, void *context);
+
+/*
+ *  WAVPLAYER_getSource
+ *
+ *  Output:
+ *              AudioSource that plays the open file, for AUDIOOUTPUT_fill
+ *              or AUDIOOUTPUT_setSource
+ */
+AudioSource *WAVPLAYER_getSource(void);
+
+/*
+ *  WAVPLAYER_isPlaying
+ *
+ *  Output:
+ *              true if a file is open and has samples left to play
+ */
+bool WAVPLAYER_isPlaying(void);
+
+/*
+ *  WAVPLAYER_getUnderruns
+ *
+ *  Output:
+ *              Number of times the player ran out of buffered samples
+ *              before the end of the file since it was opened
+ */
+unsigned int WAVPLAYER_getUnderruns(void);
+
+/*
+ *  WAVPLAYER_close
+ *
+ *  Stops playback and closes the file.
+ */
+void WAVPLAYER_close(void);
+
+#endif
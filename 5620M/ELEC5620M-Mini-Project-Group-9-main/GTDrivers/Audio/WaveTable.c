@@ -0,0 +1,278 @@
+/*
+ * Wave Tables for the DE1-SoC Audio Drivers
+ * -----------------------------------------
+ *
+ * THIS FILE IS GENERATED BY wavetable_gen.py. DO NOT EDIT.
+ *
+ * See WaveTable.h for how the tables are laid out.
+ *
+ */
+
+#include "WaveTable.h"
+
+const signed short WT_sine[WT_SIZE + 1] = {
+         0,    201,    402,    603,    804,   1005,   1206,   1407,   1608,   1809,   2009,   2210,
+      2410,   2611,   2811,   3012,   3212,   3412,   3612,   3811,   4011,   4210,   4410,   4609,
+      4808,   5007,   5205,   5404,   5602,   5800,   5998,   6195,   6393,   6590,   6786,   6983,
+      7179,   7375,   7571,   7767,   7962,   8157,   8351,   8545,   8739,   8933,   9126,   9319,
+      9512,   9704,   9896,  10087,  10278,  10469,  10659,  10849,  11039,  11228,  11417,  11605,
+     11793,  11980,  12167,  12353,  12539,  12725,  12910,  13094,  13279,  13462,  13645,  13828,
+     14010,  14191,  14372,  14553,  14732,  14912,  15090,  15269,  15446,  15623,  15800,  15976,
+     16151,  16325,  16499,  16673,  16846,  17018,  17189,  17360,  17530,  17700,  17869,  18037,
+     18204,  18371,  18537,  18703,  18868,  19032,  19195,  19357,  19519,  19680,  19841,  20000,
+     20159,  20317,  20475,  20631,  20787,  20942,  21096,  21250,  21403,  21554,  21705,  21856,
+     22005,  22154,  22301,  22448,  22594,  22739,  22884,  23027,  23170,  23311,  23452,  23592,
+     23731,  23870,  24007,  24143,  24279,  24413,  24547,  24680,  24811,  24942,  25072,  25201,
+     25329,  25456,  25582,  25708,  25832,  25955,  26077,  26198,  26319,  26438,  26556,  26674,
+     26790,  26905,  27019,  27133,  27245,  27356,  27466,  27575,  27683,  27790,  27896,  28001,
+     28105,  28208,  28310,  28411,  28510,  28609,  28706,  28803,  28898,  28992,  29085,  29177,
+     29268,  29358,  29447,  29534,  29621,  29706,  29791,  29874,  29956,  30037,  30117,  30195,
+     30273,  30349,  30424,  30498,  30571,  30643,  30714,  30783,  30852,  30919,  30985,  31050,
+     31113,  31176,  31237,  31297,  31356,  31414,  31470,  31526,  31580,  31633,  31685,  31736,
+     31785,  31833,  31880,  31926,  31971,  32014,  32057,  32098,  32137,  32176,  32213,  32250,
+     32285,  32318,  32351,  32382,  32412,  32441,  32469,  32495,  32521,  32545,  32567,  32589,
+     32609,  32628,  32646,  32663,  32678,  32692,  32705,  32717,  32728,  32737,  32745,  32752,
+     32757,  32761,  32765,  32766,  32767,  32766,  32765,  32761,  32757,  32752,  32745,  32737,
+     32728,  32717,  32705,  32692,  32678,  32663,  32646,  32628,  32609,  32589,  32567,  32545,
+     32521,  32495,  32469,  32441,  32412,  32382,  32351,  32318,  32285,  32250,  32213,  32176,
+     32137,  32098,  32057,  32014,  31971,  31926,  31880,  31833,  31785,  31736,  31685,  31633,
+     31580,  31526,  31470,  31414,  31356,  31297,  31237,  31176,  31113,  31050,  30985,  30919,
+     30852,  30783,  30714,  30643,  30571,  30498,  30424,  30349,  30273,  30195,  30117,  30037,
+     29956,  29874,  29791,  29706,  29621,  29534,  29447,  29358,  29268,  29177,  29085,  28992,
+     28898,  28803,  28706,  28609,  28510,  28411,  28310,  28208,  28105,  28001,  27896,  27790,
+     27683,  27575,  27466,  27356,  27245,  27133,  27019,  26905,  26790,  26674,  26556,  26438,
+     26319,  26198,  26077,  25955,  25832,  25708,  25582,  25456,  25329,  25201,  25072,  24942,
+     24811,  24680,  24547,  24413,  24279,  24143,  24007,  23870,  23731,  23592,  23452,  23311,
+     23170,  23027,  22884,  22739,  22594,  22448,  22301,  22154,  22005,  21856,  21705,  21554,
+     21403,  21250,  21096,  20942,  20787,  20631,  20475,  20317,  20159,  20000,  19841,  19680,
+     19519,  19357,  19195,  19032,  18868,  18703,  18537,  18371,  18204,  18037,  17869,  17700,
+     17530,  17360,  17189,  17018,  16846,  16673,  16499,  16325,  16151,  15976,  15800,  15623,
+     15446,  15269,  15090,  14912,  14732,  14553,  14372,  14191,  14010,  13828,  13645,  13462,
+     13279,  13094,  12910,  12725,  12539,  12353,  12167,  11980,  11793,  11605,  11417,  11228,
+     11039,  10849,  10659,  10469,  10278,  10087,   9896,   9704,   9512,   9319,   9126,   8933,
+      8739,   8545,   8351,   8157,   7962,   7767,   7571,   7375,   7179,   6983,   6786,   6590,
+      6393,   6195,   5998,   5800,   5602,   5404,   5205,   5007,   4808,   4609,   4410,   4210,
+      4011,   3811,   3612,   3412,   3212,   3012,   2811,   2611,   2410,   2210,   2009,   1809,
+      1608,   1407,   1206,   1005,    804,    603,    402,    201,      0,   -201,   -402,   -603,
+      -804,  -1005,  -1206,  -1407,  -1608,  -1809,  -2009,  -2210,  -2410,  -2611,  -2811,  -3012,
+     -3212,  -3412,  -3612,  -3811,  -4011,  -4210,  -4410,  -4609,  -4808,  -5007,  -5205,  -5404,
+     -5602,  -5800,  -5998,  -6195,  -6393,  -6590,  -6786,  -6983,  -7179,  -7375,  -7571,  -7767,
+     -7962,  -8157,  -8351,  -8545,  -8739,  -8933,  -9126,  -9319,  -9512,  -9704,  -9896, -10087,
+    -10278, -10469, -10659, -10849, -11039, -11228, -11417, -11605, -11793, -11980, -12167, -12353,
+    -12539, -12725, -12910, -13094, -13279, -13462, -13645, -13828, -14010, -14191, -14372, -14553,
+    -14732, -14912, -15090, -15269, -15446, -15623, -15800, -15976, -16151, -16325, -16499, -16673,
+    -16846, -17018, -17189, -17360, -17530, -17700, -17869, -18037, -18204, -18371, -18537, -18703,
+    -18868, -19032, -19195, -19357, -19519, -19680, -19841, -20000, -20159, -20317, -20475, -20631,
+    -20787, -20942, -21096, -21250, -21403, -21554, -21705, -21856, -22005, -22154, -22301, -22448,
+    -22594, -22739, -22884, -23027, -23170, -23311, -23452, -23592, -23731, -23870, -24007, -24143,
+    -24279, -24413, -24547, -24680, -24811, -24942, -25072, -25201, -25329, -25456, -25582, -25708,
+    -25832, -25955, -26077, -26198, -26319, -26438, -26556, -26674, -26790, -26905, -27019, -27133,
+    -27245, -27356, -27466, -27575, -27683, -27790, -27896, -28001, -28105, -28208, -28310, -28411,
+    -28510, -28609, -28706, -28803, -28898, -28992, -29085, -29177, -29268, -29358, -29447, -29534,
+    -29621, -29706, -29791, -29874, -29956, -30037, -30117, -30195, -30273, -30349, -30424, -30498,
+    -30571, -30643, -30714, -30783, -30852, -30919, -30985, -31050, -31113, -31176, -31237, -31297,
+    -31356, -31414, -31470, -31526, -31580, -31633, -31685, -31736, -31785, -31833, -31880, -31926,
+    -31971, -32014, -32057, -32098, -32137, -32176, -32213, -32250, -32285, -32318, -32351, -32382,
+    -32412, -32441, -32469, -32495, -32521, -32545, -32567, -32589, -32609, -32628, -32646, -32663,
+    -32678, -32692, -32705, -32717, -32728, -32737, -32745, -32752, -32757, -32761, -32765, -32766,
+    -32767, -32766, -32765, -32761, -32757, -32752, -32745, -32737, -32728, -32717, -32705, -32692,
+    -32678, -32663, -32646, -32628, -32609, -32589, -32567, -32545, -32521, -32495, -32469, -32441,
+    -32412, -32382, -32351, -32318, -32285, -32250, -32213, -32176, -32137, -32098, -32057, -32014,
+    -31971, -31926, -31880, -31833, -31785, -31736, -31685, -31633, -31580, -31526, -31470, -31414,
+    -31356, -31297, -31237, -31176, -31113, -31050, -30985, -30919, -30852, -30783, -30714, -30643,
+    -30571, -30498, -30424, -30349, -30273, -30195, -30117, -30037, -29956, -29874, -29791, -29706,
+    -29621, -29534, -29447, -29358, -29268, -29177, -29085, -28992, -28898, -28803, -28706, -28609,
+    -28510, -28411, -28310, -28208, -28105, -28001, -27896, -27790, -27683, -27575, -27466, -27356,
+    -27245, -27133, -27019, -26905, -26790, -26674, -26556, -26438, -26319, -26198, -26077, -25955,
+    -25832, -25708, -25582, -25456, -25329, -25201, -25072, -24942, -24811, -24680, -24547, -24413,
+    -24279, -24143, -24007, -23870, -23731, -23592, -23452, -23311, -23170, -23027, -22884, -22739,
+    -22594, -22448, -22301, -22154, -22005, -21856, -21705, -21554, -21403, -21250, -21096, -20942,
+    -20787, -20631, -20475, -20317, -20159, -20000, -19841, -19680, -19519, -19357, -19195, -19032,
+    -18868, -18703, -18537, -18371, -18204, -18037, -17869, -17700, -17530, -17360, -17189, -17018,
+    -16846, -16673, -16499, -16325, -16151, -15976, -15800, -15623, -15446, -15269, -15090, -14912,
+    -14732, -14553, -14372, -14191, -14010, -13828, -13645, -13462, -13279, -13094, -12910, -12725,
+    -12539, -12353, -12167, -11980, -11793, -11605, -11417, -11228, -11039, -10849, -10659, -10469,
+    -10278, -10087,  -9896,  -9704,  -9512,  -9319,  -9126,  -8933,  -8739,  -8545,  -8351,  -8157,
+     -7962,  -7767,  -7571,  -7375,  -7179,  -6983,  -6786,  -6590,  -6393,  -6195,  -5998,  -5800,
+     -5602,  -5404,  -5205,  -5007,  -4808,  -4609,  -4410,  -4210,  -4011,  -3811,  -3612,  -3412,
+     -3212,  -3012,  -2811,  -2611,  -2410,  -2210,  -2009,  -1809,  -1608,  -1407,  -1206,  -1005,
+      -804,   -603,   -402,   -201,      0,
+};
+
+const signed short WT_square[WT_SIZE + 1] = {
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767,
+     32767,  32767,  32767,  32767,  32767,  32767,  32767,  32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767, -32767,
+    -32767, -32767, -32767, -32767,  32767,
+};
+
+const signed short WT_triangle[WT_SIZE + 1] = {
+         0,    128,    256,    384,    512,    640,    768,    896,   1024,   1152,   1280,   1408,
+      1536,   1664,   1792,   1920,   2048,   2176,   2304,   2432,   2560,   2688,   2816,   2944,
+      3072,   3200,   3328,   3456,   3584,   3712,   3840,   3968,   4096,   4224,   4352,   4480,
+      4608,   4736,   4864,   4992,   5120,   5248,   5376,   5504,   5632,   5760,   5888,   6016,
+      6144,   6272,   6400,   6528,   6656,   6784,   6912,   7040,   7168,   7296,   7424,   7552,
+      7680,   7808,   7936,   8064,   8192,   8320,   8448,   8576,   8704,   8832,   8960,   9088,
+      9216,   9344,   9472,   9600,   9728,   9856,   9984,  10112,  10240,  10368,  10496,  10624,
+     10752,  10880,  11008,  11136,  11264,  11392,  11520,  11648,  11776,  11904,  12032,  12160,
+     12288,  12416,  12544,  12672,  12800,  12928,  13056,  13184,  13312,  13440,  13568,  13696,
+     13824,  13952,  14080,  14208,  14336,  14464,  14592,  14720,  14848,  14976,  15104,  15232,
+     15360,  15488,  15616,  15744,  15872,  16000,  16128,  16256,  16384,  16511,  16639,  16767,
+     16895,  17023,  17151,  17279,  17407,  17535,  17663,  17791,  17919,  18047,  18175,  18303,
+     18431,  18559,  18687,  18815,  18943,  19071,  19199,  19327,  19455,  19583,  19711,  19839,
+     19967,  20095,  20223,  20351,  20479,  20607,  20735,  20863,  20991,  21119,  21247,  21375,
+     21503,  21631,  21759,  21887,  22015,  22143,  22271,  22399,  22527,  22655,  22783,  22911,
+     23039,  23167,  23295,  23423,  23551,  23679,  23807,  23935,  24063,  24191,  24319,  24447,
+     24575,  24703,  24831,  24959,  25087,  25215,  25343,  25471,  25599,  25727,  25855,  25983,
+     26111,  26239,  26367,  26495,  26623,  26751,  26879,  27007,  27135,  27263,  27391,  27519,
+     27647,  27775,  27903,  28031,  28159,  28287,  28415,  28543,  28671,  28799,  28927,  29055,
+     29183,  29311,  29439,  29567,  29695,  29823,  29951,  30079,  30207,  30335,  30463,  30591,
+     30719,  30847,  30975,  31103,  31231,  31359,  31487,  31615,  31743,  31871,  31999,  32127,
+     32255,  32383,  32511,  32639,  32767,  32639,  32511,  32383,  32255,  32127,  31999,  31871,
+     31743,  31615,  31487,  31359,  31231,  31103,  30975,  30847,  30719,  30591,  30463,  30335,
+     30207,  30079,  29951,  29823,  29695,  29567,  29439,  29311,  29183,  29055,  28927,  28799,
+     28671,  28543,  28415,  28287,  28159,  28031,  27903,  27775,  27647,  27519,  27391,  27263,
+     27135,  27007,  26879,  26751,  26623,  26495,  26367,  26239,  26111,  25983,  25855,  25727,
+     25599,  25471,  25343,  25215,  25087,  24959,  24831,  24703,  24575,  24447,  24319,  24191,
+     24063,  23935,  23807,  23679,  23551,  23423,  23295,  23167,  23039,  22911,  22783,  22655,
+     22527,  22399,  22271,  22143,  22015,  21887,  21759,  21631,  21503,  21375,  21247,  21119,
+     20991,  20863,  20735,  20607,  20479,  20351,  20223,  20095,  19967,  19839,  19711,  19583,
+     19455,  19327,  19199,  19071,  18943,  18815,  18687,  18559,  18431,  18303,  18175,  18047,
+     17919,  17791,  17663,  17535,  17407,  17279,  17151,  17023,  16895,  16767,  16639,  16511,
+     16384,  16256,  16128,  16000,  15872,  15744,  15616,  15488,  15360,  15232,  15104,  14976,
+     14848,  14720,  14592,  14464,  14336,  14208,  14080,  13952,  13824,  13696,  13568,  13440,
+     13312,  13184,  13056,  12928,  12800,  12672,  12544,  12416,  12288,  12160,  12032,  11904,
+     11776,  11648,  11520,  11392,  11264,  11136,  11008,  10880,  10752,  10624,  10496,  10368,
+     10240,  10112,   9984,   9856,   9728,   9600,   9472,   9344,   9216,   9088,   8960,   8832,
+      8704,   8576,   8448,   8320,   8192,   8064,   7936,   7808,   7680,   7552,   7424,   7296,
+      7168,   7040,   6912,   6784,   6656,   6528,   6400,   6272,   6144,   6016,   5888,   5760,
+      5632,   5504,   5376,   5248,   5120,   4992,   4864,   4736,   4608,   4480,   4352,   4224,
+      4096,   3968,   3840,   3712,   3584,   3456,   3328,   3200,   3072,   2944,   2816,   2688,
+      2560,   2432,   2304,   2176,   2048,   1920,   1792,   1664,   1536,   1408,   1280,   1152,
+      1024,    896,    768,    640,    512,    384,    256,    128,      0,   -128,   -256,   -384,
+      -512,   -640,   -768,   -896,  -1024,  -1152,  -1280,  -1408,  -1536,  -1664,  -1792,  -1920,
+     -2048,  -2176,  -2304,  -2432,  -2560,  -2688,  -2816,  -2944,  -3072,  -3200,  -3328,  -3456,
+     -3584,  -3712,  -3840,  -3968,  -4096,  -4224,  -4352,  -4480,  -4608,  -4736,  -4864,  -4992,
+     -5120,  -5248,  -5376,  -5504,  -5632,  -5760,  -5888,  -6016,  -6144,  -6272,  -6400,  -6528,
+     -6656,  -6784,  -6912,  -7040,  -7168,  -7296,  -7424,  -7552,  -7680,  -7808,  -7936,  -8064,
+     -8192,  -8320,  -8448,  -8576,  -8704,  -8832,  -8960,  -9088,  -9216,  -9344,  -9472,  -9600,
+     -9728,  -9856,  -9984, -10112, -10240, -10368, -10496, -10624, -10752, -10880, -11008, -11136,
+    -11264, -11392, -11520, -11648, -11776, -11904, -12032, -12160, -12288, -12416, -12544, -12672,
+    -12800, -12928, -13056, -13184, -13312, -13440, -13568, -13696, -13824, -13952, -14080, -14208,
+    -14336, -14464, -14592, -14720, -14848, -14976, -15104, -15232, -15360, -15488, -15616, -15744,
+    -15872, -16000, -16128, -16256, -16384, -16511, -16639, -16767, -16895, -17023, -17151, -17279,
+    -17407, -17535, -17663, -17791, -17919, -18047, -18175, -18303, -18431, -18559, -18687, -18815,
+    -18943, -19071, -19199, -19327, -19455, -19583, -19711, -19839, -19967, -20095, -20223, -20351,
+    -20479, -20607, -20735, -20863, -20991, -21119, -21247, -21375, -21503, -21631, -21759, -21887,
+    -22015, -22143, -22271, -22399, -22527, -22655, -22783, -22911, -23039, -23167, -23295, -23423,
+    -23551, -23679, -23807, -23935, -24063, -24191, -24319, -24447, -24575, -24703, -24831, -24959,
+    -25087, -25215, -25343, -25471, -25599, -25727, -25855, -25983, -26111, -26239, -26367, -26495,
+    -26623, -26751, -26879, -27007, -27135, -27263, -27391, -27519, -27647, -27775, -27903, -28031,
+    -28159, -28287, -28415, -28543, -28671, -28799, -28927, -29055, -29183, -29311, -29439, -29567,
+    -29695, -29823, -29951, -30079, -30207, -30335, -30463, -30591, -30719, -30847, -30975, -31103,
+    -31231, -31359, -31487, -31615, -31743, -31871, -31999, -32127, -32255, -32383, -32511, -32639,
+    -32767, -32639, -32511, -32383, -32255, -32127, -31999, -31871, -31743, -31615, -31487, -31359,
+    -31231, -31103, -30975, -30847, -30719, -30591, -30463, -30335, -30207, -30079, -29951, -29823,
+    -29695, -29567, -29439, -29311, -29183, -29055, -28927, -28799, -28671, -28543, -28415, -28287,
+    -28159, -28031, -27903, -27775, -27647, -27519, -27391, -27263, -27135, -27007, -26879, -26751,
+    -26623, -26495, -26367, -26239, -26111, -25983, -25855, -25727, -25599, -25471, -25343, -25215,
+    -25087, -24959, -24831, -24703, -24575, -24447, -24319, -24191, -24063, -23935, -23807, -23679,
+    -23551, -23423, -23295, -23167, -23039, -22911, -22783, -22655, -22527, -22399, -22271, -22143,
+    -22015, -21887, -21759, -21631, -21503, -21375, -21247, -21119, -20991, -20863, -20735, -20607,
+    -20479, -20351, -20223, -20095, -19967, -19839, -19711, -19583, -19455, -19327, -19199, -19071,
+    -18943, -18815, -18687, -18559, -18431, -18303, -18175, -18047, -17919, -17791, -17663, -17535,
+    -17407, -17279, -17151, -17023, -16895, -16767, -16639, -16511, -16384, -16256, -16128, -16000,
+    -15872, -15744, -15616, -15488, -15360, -15232, -15104, -14976, -14848, -14720, -14592, -14464,
+    -14336, -14208, -14080, -13952, -13824, -13696, -13568, -13440, -13312, -13184, -13056, -12928,
+    -12800, -12672, -12544, -12416, -12288, -12160, -12032, -11904, -11776, -11648, -11520, -11392,
+    -11264, -11136, -11008, -10880, -10752, -10624, -10496, -10368, -10240, -10112,  -9984,  -9856,
+     -9728,  -9600,  -9472,  -9344,  -9216,  -9088,  -8960,  -8832,  -8704,  -8576,  -8448,  -8320,
+     -8192,  -8064,  -7936,  -7808,  -7680,  -7552,  -7424,  -7296,  -7168,  -7040,  -6912,  -6784,
+     -6656,  -6528,  -6400,  -6272,  -6144,  -6016,  -5888,  -5760,  -5632,  -5504,  -5376,  -5248,
+     -5120,  -4992,  -4864,  -4736,  -4608,  -4480,  -4352,  -4224,  -4096,  -3968,  -3840,  -3712,
+     -3584,  -3456,  -3328,  -3200,  -3072,  -2944,  -2816,  -2688,  -2560,  -2432,  -2304,  -2176,
+     -2048,  -1920,  -1792,  -1664,  -1536,  -1408,  -1280,  -1152,  -1024,   -896,   -768,   -640,
+      -512,   -384,   -256,   -128,      0,
+};
@@ -0,0 +1,51 @@
+/*
+ * Wave Tables for the DE1-SoC Audio Drivers
+ * -----------------------------------------
+ *
+ * Each table holds one full cycle of a waveform as
+ * WT_SIZE signed Q15 samples (+/-32767 is full scale).
+ * A guard entry equal to the first sample is added at
+ * the end so interpolation never needs to wrap.
+ *
+ * The tables are indexed with a 32-bit phase where 2^32
+ * is one full cycle. The top WT_BITS bits select the
+ * table entry and the next WT_FRACBITS bits are used to
+ * linearly interpolate to the following entry:
+ *
+ *    sample = WT_lookup(WT_sine, phase);
+ *
+ * The table contents are generated by wavetable_gen.py.
+ *
+ */
+
+#ifndef WAVETABLE_H_
+#define WAVETABLE_H_
+
+#define WT_BITS 10               // Number of phase bits used to index the table
+#define WT_SIZE (1 << WT_BITS)   // Number of entries in one cycle (1024)
+#define WT_FRACBITS 15           // Number of phase bits used to interpolate
+
+// Accuracy of the sine at full scale against sin() at the same phase, as
+// measured by MathClub/Headless/HeadlessWaveTable.c. The worst sample is
+// 2.5 steps of the table out (-82.3 dBFS): half a step from rounding the
+// table, one from the interpolation rounding down and one because the
+// table peaks at 32767, not 32768. The largest spur is -96.4 dBFS and
+// all the noise and distortion together -93.0 dBFS.
+#define WT_MAX_ERROR_DBFS -81.0  // Worst error of any sample
+#define WT_MAX_SPUR_DBFS -95.0   // Largest spur in the spectrum
+#define WT_MAX_NOISE_DBFS -92.0  // All noise and distortion
+
+extern const signed short WT_sine[WT_SIZE + 1];
+extern const signed short WT_square[WT_SIZE + 1];
+extern const signed short WT_triangle[WT_SIZE + 1];
+
+// Returns the table value at the given phase, linearly interpolated
+// between neighbouring entries. Result is in Q15.
+__forceinline static signed int WT_lookup(const signed short table[], unsigned int phase) {
+    unsigned int index = phase >> (32 - WT_BITS);
+    signed int frac = (phase >> (32 - WT_BITS - WT_FRACBITS)) & ((1 << WT_FRACBITS) - 1);
+    signed int sample = table[index];
+    return sample + (((table[index + 1] - sample) * frac) >> WT_FRACBITS);
+}
+
+#endif /* WAVETABLE_H_ */
@@ -0,0 +1,123 @@
+# Sequence generator Python script
+# Compiles a text song file into a const Sequence for AudioSequencer.
+#
+# Run with: python sequence_gen.py song.txt Song.c song_name
+# The output is written to Song.c, overwriting the old copy.
+#
+# Song file format, one item per line, '#' starts a comment:
+#   tick <ms>                          Length of a tick in milliseconds
+#   <time> <voice> <note> <length>     Play note (e.g. C4, F#3, Bb5) on voice at
+#                                      tick <time> and hold it for <length> ticks
+#   end <time>                         Song ends (and loops) at tick <time>
+# Times are absolute and notes may be listed in any order.
+
+# Imports
+import sys
+
+# Constants, must match AudioSequencer.h
+NOTE_NONE = 'SEQUENCER_NOTE_NONE'
+NOTE_END = 'SEQUENCER_NOTE_END'
+MAX_TICKS = 255
+
+# Must match SYNTH_NUM_VOICES in AudioSynth.h
+NUM_VOICES = 8
+
+SEMITONES = {'C': 0, 'D': 2, 'E': 4, 'F': 5, 'G': 7, 'A': 9, 'B': 11}
+
+HEADER = '''/*
+ * Sequence {name}
+ * -----------------------------------------
+ *
+ * THIS FILE IS GENERATED BY sequence_gen.py FROM {source}. DO NOT EDIT.
+ *
+ */
+
+#include "Audio/AudioSequencer.h"
+'''
+
+
+def fail(line_number, message):
+    sys.exit('line {}: {}'.format(line_number, message))
+
+
+def parse_note(text, line_number):
+    # Returns (octave, semitone) for names such as C4, F#3 and Bb5
+    if len(text) < 2 or text[0].upper() not in SEMITONES:
+        fail(line_number, 'bad note ' + text)
+    semitone = SEMITONES[text[0].upper()]
+    rest = text[1:]
+    if rest[0] == '#':
+        semitone += 1
+        rest = rest[1:]
+    elif rest[0] == 'b':
+        semitone -= 1
+        rest = rest[1:]
+    octave = int(rest)
+    # B#3 is C4 and Cb4 is B3
+    octave += semitone // 12
+    semitone %= 12
+    if not 0 <= octave <= 8:
+        fail(line_number, 'note out of range ' + text)
+    return octave, semitone
+
+
+def parse(path):
+    tick_ms = None
+    end = None
+    notes = []
+    with open(path) as song:
+        for line_number, line in enumerate(song, 1):
+            words = line.split('#')[0].split()
+            if not words:
+                continue
+            if words[0] == 'tick':
+                tick_ms = int(words[1])
+            elif words[0] == 'end':
+                end = int(words[1])
+            elif len(words) == 4:
+                length = int(words[3])
+                if not 0 <= length <= MAX_TICKS:
+                    fail(line_number, 'note length must be 0 - {} ticks'.format(MAX_TICKS))
+                voice = int(words[1])
+                if not 0 <= voice < NUM_VOICES:
+                    fail(line_number, 'voice must be 0 - {}'.format(NUM_VOICES - 1))
+                notes.append((int(words[0]), voice, parse_note(words[2], line_number), length))
+            else:
+                fail(line_number, 'expected <time> <voice> <note> <length>')
+    if tick_ms is None or end is None:
+        sys.exit('song needs a tick and an end line')
+    notes.sort(key=lambda note: note[0])
+    if notes and notes[-1][0] > end:
+        sys.exit('notes after the end of the song')
+    return tick_ms, end, notes
+
+
+def events(notes, end):
+    # Converts absolute times to deltas, adding empty events for gaps over 255 ticks
+    now = 0
+    for time, voice, note, length in notes + [(end, 0, None, 0)]:
+        while time - now > MAX_TICKS:
+            yield MAX_TICKS, 0, NOTE_NONE, 0
+            now += MAX_TICKS
+        if note is None:
+            yield time - now, 0, NOTE_END, 0
+        else:
+            yield time - now, voice, 'AUDIO_NOTE({}, {})'.format(*note), length
+        now = time
+
+
+def main():
+    if len(sys.argv) != 4:
+        sys.exit('usage: python sequence_gen.py song.txt Song.c song_name')
+    source, output, name = sys.argv[1:]
+    tick_ms, end, notes = parse(source)
+    with open(output, 'w') as out:
+        out.write(HEADER.format(name=name, source=source))
+        out.write('\nconst SequenceEvent {}_events[] = {{\n'.format(name))
+        for event in events(notes, end):
+            out.write('    {{{}, {}, {}, {}}},\n'.format(*event))
+        out.write('};\n')
+        out.write('\nconst Sequence {0} = {{{0}_events, {1}}};\n'.format(name, tick_ms))
+
+
+main()
@@ -0,0 +1,62 @@
+# Wave table generator Python script
+# Generates WaveTable.c for the DE1-SoC audio drivers.
+#
+# Run from this folder with: python wavetable_gen.py
+# The output is written to WaveTable.c, overwriting the old copy.
+
+# Imports
+import math
+
+# Constants
+# WT_BITS:  Number of phase bits used to index the table (1024 entries)
+WT_BITS = 10
+WT_SIZE = 1 << WT_BITS
+# WT_PEAK:  Peak value of each table (Q15 full scale)
+WT_PEAK = 32767
+
+HEADER = '''/*
+ * Wave Tables for the DE1-SoC Audio Drivers
+ * -----------------------------------------
+ *
+ * THIS FILE IS GENERATED BY wavetable_gen.py. DO NOT EDIT.
+ *
+ * See WaveTable.h for how the tables are laid out.
+ *
+ */
+
+#include "WaveTable.h"
+'''
+
+
+def sine(i):
+    return int(round(WT_PEAK * math.sin(2 * math.pi * i / WT_SIZE)))
+
+
+def square(i):
+    return WT_PEAK if i < WT_SIZE // 2 else -WT_PEAK
+
+
+def triangle(i):
+    # Starts at zero and rises like the sine so all tables are in phase
+    quarter = WT_SIZE // 4
+    if i < quarter:
+        return int(round(WT_PEAK * i / quarter))
+    if i < 3 * quarter:
+        return int(round(WT_PEAK * (2 * quarter - i) / quarter))
+    return int(round(WT_PEAK * (i - WT_SIZE) / quarter))
+
+
+def write_table(out, name, func):
+    # One extra guard entry (equal to entry 0) so interpolation never needs to wrap
+    values = [func(i % WT_SIZE) for i in range(WT_SIZE + 1)]
+    out.write('\nconst signed short {}[WT_SIZE + 1] = {{\n'.format(name))
+    for row in range(0, len(values), 12):
+        out.write('    ' + ', '.join('{:6d}'.format(v) for v in values[row:row + 12]) + ',\n')
+    out.write('};\n')
+
+
+with open('WaveTable.c', 'w') as out:
+    out.write(HEADER)
+    write_table(out, 'WT_sine', sine)
+    write_table(out, 'WT_square', square)
+    write_table(out, 'WT_triangle', triangle)
@@ -8,64 +8,245 @@
 
 //Driver Base Address
 volatile unsigned int *wm8731_base_ptr = 0x0;
+#ifdef WM8731_HOST
+//On a host the base address points here, so the FIFO pointers are still valid
+unsigned int wm8731_host_registers[4];
+#endif
 //Driver Initialised
 bool wm8731_initialised = false;
+//Shadow copy of the codec registers. The codec registers can't be read
+//back, so this is used to avoid re-sending values the codec already has.
+unsigned short wm8731_registers[WM8731_NUM_REGISTERS];
+//Register values staged by WM8731_setRegister for the next commit
+unsigned short wm8731_staged[WM8731_NUM_REGISTERS];
+//Bit mask of the shadow registers that match the codec
+unsigned int wm8731_registersValid = 0;
+//Current sample rate in Hz
+unsigned int wm8731_sampleRate = 48000;
 
 //
 // Useful Defines
 //
 
-//WM8731 ARM Address Offsets
-#define WM8731_CONTROL    (0x0/sizeof(unsigned int))
-#define WM8731_FIFOSPACE  (0x4/sizeof(unsigned int))
-#define WM8731_LEFTFIFO   (0x8/sizeof(unsigned int))
-#define WM8731_RIGHTFIFO  (0xC/sizeof(unsigned int))
-
-//I2C Register Address Offsets
-#define WM8731_I2C_LEFTINCNTRL   (0x00/sizeof(unsigned short))
-#define WM8731_I2C_RIGHTINCNTRL  (0x02/sizeof(unsigned short))
-#define WM8731_I2C_LEFTOUTCNTRL  (0x04/sizeof(unsigned short))
-#define WM8731_I2C_RIGHTOUTCNTRL (0x06/sizeof(unsigned short))
-#define WM8731_I2C_ANLGPATHCNTRL (0x08/sizeof(unsigned short))
-#define WM8731_I2C_DGTLPATHCNTRL (0x0A/sizeof(unsigned short))
-#define WM8731_I2C_POWERCNTRL    (0x0C/sizeof(unsigned short))
-#define WM8731_I2C_DATAFMTCNTRL  (0x0E/sizeof(unsigned short))
-#define WM8731_I2C_SMPLINGCNTRL  (0x10/sizeof(unsigned short))
-#define WM8731_I2C_ACTIVECNTRL   (0x12/sizeof(unsigned short))
+//Register access. A host build reads and writes a model of the audio controller instead.
+#ifdef WM8731_HOST
+#define wm8731_readRegister(reg)         WM8731_hostRead(reg)
+#define wm8731_writeRegister(reg, value) WM8731_hostWrite(reg, value)
+#else
+#define wm8731_readRegister(reg)         (wm8731_base_ptr[reg])
+#define wm8731_writeRegister(reg, value) (wm8731_base_ptr[reg] = (value))
+#endif
+
+//I2C Address of the codec
+#define WM8731_I2C_ADDRESS 0x1A
+
+//Output volume register bits
+#define WM8731_OUTVOL_0DB   0x79     //Volume value for 0dB
+#define WM8731_OUTVOL_MUTE  0x2F     //Any volume value below 0x30 mutes
+#define WM8731_OUTVOL_ZCEN  (1<<7)   //Only change volume at a zero crossing
+
+//Left input and output register bit to write the same value to both channels
+#define WM8731_LR_BOTH      (1<<8)
+
+//Digital path register bits
+#define WM8731_DGTLPATH_DEEMPH (3<<1) //De-emphasis rate select
+#define WM8731_DGTLPATH_DACMU  (1<<3) //DAC soft mute
+
+//Most register writes sent in one I2C batch
+#define WM8731_MAX_BATCH 16
+
+//I2C transactions for a batch of register writes, and the 16bit commands they send
+HPS_I2C_Transaction wm8731_transactions[WM8731_MAX_BATCH];
+unsigned char wm8731_commands[WM8731_MAX_BATCH][2];
+
+//Registers and values of the batch being sent, how many of its writes were
+//submitted, and the first error submitting them
+unsigned int wm8731_batchRegs[WM8731_MAX_BATCH];
+unsigned short wm8731_batchValues[WM8731_MAX_BATCH];
+unsigned int wm8731_batched = 0;
+signed int wm8731_batchStatus = WM8731_SUCCESS;
+//Next step of WM8731_initialiseStep
+unsigned int wm8731_initStep = 0;
+
+//Submit codec register writes in order as one I2C batch, without waiting for them.
+//The writes go back to back, so this is quicker than sending them one at a time.
+void wm8731_submitRegisters( const unsigned int regs[], const unsigned short values[], unsigned int count ) {
+    signed int status;
+    unsigned int i;
+    wm8731_batched = 0;
+    wm8731_batchStatus = WM8731_SUCCESS;
+    if (count > WM8731_MAX_BATCH) {
+        wm8731_batchStatus = HPS_I2C_INVALIDLEN;
+        return;
+    }
+    for (i = 0; i < count; i++) {
+        wm8731_batchRegs[i] = regs[i];
+        wm8731_batchValues[i] = values[i];
+        //Big-endian: 7bit register address then 9bit value
+        wm8731_commands[i][0] = (unsigned char)((regs[i] << 1) | (values[i] >> 8));
+        wm8731_commands[i][1] = (unsigned char)values[i];
+        wm8731_transactions[i].address = WM8731_I2C_ADDRESS;
+        wm8731_transactions[i].write_data = wm8731_commands[i];
+        wm8731_transactions[i].write_length = 2;
+        wm8731_transactions[i].read_length = 0;
+        wm8731_transactions[i].callback = 0;
+        status = HPS_I2C_submit(0, &wm8731_transactions[i]);
+        if (status != HPS_I2C_SUCCESS) {
+            wm8731_batchStatus = status;
+            break;
+        }
+        wm8731_batched++;
+    }
+}
+
+//Check if the submitted batch is still being sent. The batch completes in
+//order, so once the last write is done all are.
+bool wm8731_batchBusy( void ) {
+    return wm8731_batched && (wm8731_transactions[wm8731_batched - 1].status == HPS_I2C_PENDING);
+}
+
+//Update the shadow with the writes of a finished batch
+signed int wm8731_finishRegisters( void ) {
+    signed int status = wm8731_batchStatus;
+    unsigned int reg;
+    unsigned short value;
+    unsigned int mask;
+    bool both;
+    unsigned int i;
+    for (i = 0; i < wm8731_batched; i++) {
+        reg = wm8731_batchRegs[i];
+        value = wm8731_batchValues[i];
+        //A left register write with the "both" bit also sets the right register
+        both = ((reg == WM8731_I2C_LEFTINCNTRL) || (reg == WM8731_I2C_LEFTOUTCNTRL)) && (value & WM8731_LR_BOTH);
+        mask = both ? (3 << reg) : (1 << reg);
+        if (wm8731_transactions[i].status == HPS_I2C_SUCCESS) {
+            wm8731_registers[reg] = both ? (value & ~WM8731_LR_BOTH) : value;
+            if (both) wm8731_registers[reg + 1] = wm8731_registers[reg];
+            wm8731_registersValid |= mask;
+        } else {
+            //Unknown what the codec has now, so always send the next write
+            wm8731_registersValid &= ~mask;
+            if (status == WM8731_SUCCESS) status = wm8731_transactions[i].status;
+        }
+    }
+    wm8731_batched = 0;
+    return status;
+}
+
+//Write codec registers in order as one I2C batch and update the shadow.
+signed int wm8731_writeRegisters( const unsigned int regs[], const unsigned short values[], unsigned int count ) {
+    wm8731_submitRegisters(regs, values, count);
+    if (wm8731_batched) HPS_I2C_wait(0, &wm8731_transactions[wm8731_batched - 1]);
+    return wm8731_finishRegisters();
+}
+
+//Work out the writes needed to commit the staged registers, in the order they
+//must be sent. Returns the number of writes, 0 if the codec is up to date.
+unsigned int wm8731_buildCommit( unsigned int regs[], unsigned short values[] ) {
+    unsigned int count = 0;
+    unsigned int changed = 0;
+    unsigned short power = wm8731_staged[WM8731_I2C_POWERCNTRL];
+    bool powerOutLast;
+    bool restart;
+    unsigned int reg;
+    //Find the registers that differ from the codec
+    for (reg = 0; reg < WM8731_NUM_REGISTERS; reg++) {
+        if (!(wm8731_registersValid & (1 << reg)) || (wm8731_registers[reg] != wm8731_staged[reg])) changed |= (1 << reg);
+    }
+    if (!changed) return 0;
+    //Power up everything but the output first, and the output once the rest is set up
+    powerOutLast = (changed & (1 << WM8731_I2C_POWERCNTRL)) && !(power & WM8731_POWER_OUT) &&
+                   !((wm8731_registersValid & (1 << WM8731_I2C_POWERCNTRL)) && !(wm8731_registers[WM8731_I2C_POWERCNTRL] & WM8731_POWER_OUT));
+    if (changed & (1 << WM8731_I2C_POWERCNTRL)) {
+        regs[count] = WM8731_I2C_POWERCNTRL; values[count++] = powerOutLast ? (power | WM8731_POWER_OUT) : power;
+    }
+    //Stop the digital interface while the sample rate or data format changes
+    restart = (changed & ((1 << WM8731_I2C_SMPLINGCNTRL) | (1 << WM8731_I2C_DATAFMTCNTRL))) &&
+              (wm8731_registersValid & (1 << WM8731_I2C_ACTIVECNTRL)) && (wm8731_registers[WM8731_I2C_ACTIVECNTRL] & 1);
+    if (restart) {
+        regs[count] = WM8731_I2C_ACTIVECNTRL; values[count++] = 0x00;
+    }
+    for (reg = 0; reg < WM8731_I2C_ACTIVECNTRL; reg++) {
+        if (!(changed & (1 << reg)) || (reg == WM8731_I2C_POWERCNTRL)) continue;
+        regs[count] = reg;
+        values[count] = wm8731_staged[reg];
+        //Send a matching left/right pair as one write
+        if (((reg == WM8731_I2C_LEFTINCNTRL) || (reg == WM8731_I2C_LEFTOUTCNTRL)) &&
+            (changed & (1 << (reg + 1))) && (wm8731_staged[reg] == wm8731_staged[reg + 1])) {
+            values[count] |= WM8731_LR_BOTH;
+            reg++;
+        }
+        count++;
+    }
+    if (restart ? (wm8731_staged[WM8731_I2C_ACTIVECNTRL] != 0x00) : (changed & (1 << WM8731_I2C_ACTIVECNTRL))) {
+        regs[count] = WM8731_I2C_ACTIVECNTRL; values[count++] = wm8731_staged[WM8731_I2C_ACTIVECNTRL];
+    }
+    if (powerOutLast) {
+        regs[count] = WM8731_I2C_POWERCNTRL; values[count++] = power;
+    }
+    return count;
+}
 
 //Initialise Audio Controller
 signed int WM8731_initialise ( unsigned int base_address ) {
     signed int status;
-    //Set the local base address pointer
-    wm8731_base_ptr = (unsigned int *) base_address;
-    //Ensure I2C Controller "I2C1" is initialised
-    if (!HPS_I2C_isInitialised(0)) {
-        status = HPS_I2C_initialise(0);
-        if (status != HPS_I2C_SUCCESS) return status;
-    }
-    //Initialise the WM8731 codec over I2C. See Page 46 of datasheet
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_POWERCNTRL   <<9) | 0x12); //Power-up chip. Leave mic off as not used.
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_LEFTINCNTRL  <<9) | 0x17); //+4.5dB Volume. Unmute.
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_RIGHTINCNTRL <<9) | 0x17); //+4.5dB Volume. Unmute.
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_LEFTOUTCNTRL <<9) | 0x70); //-24dB Volume. Unmute.
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_RIGHTOUTCNTRL<<9) | 0x70); //-24dB Volume. Unmute.
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_ANLGPATHCNTRL<<9) | 0x12); //Use Line In. Disable Bypass. Use DAC
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_DGTLPATHCNTRL<<9) | 0x06); //Enable High-Pass filter. 48kHz sample rate.
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_DATAFMTCNTRL <<9) | 0x4E); //I2S Mode, 24bit, Master Mode (do not change this!)
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_SMPLINGCNTRL <<9) | 0x00); //Normal Mode, 48kHz sample rate
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_ACTIVECNTRL  <<9) | 0x01); //Enable Codec
-    if (status != HPS_I2C_SUCCESS) return status;
-    status = HPS_I2C_write16b(0, 0x1A, (WM8731_I2C_POWERCNTRL   <<9) | 0x02); //Power-up output.
+    do {
+        status = WM8731_initialiseStep(base_address);
+    } while (status == WM8731_PENDING);
+    return status;
+}
+
+//Initialise Audio Codec in steps
+signed int WM8731_initialiseStep ( unsigned int base_address ) {
+    //Register values after initialisation, in register order. See Page 46 of datasheet
+    static const unsigned short initValues[WM8731_NUM_REGISTERS] = {
+        0x17, //Left In: +4.5dB Volume. Unmute.
+        0x17, //Right In: +4.5dB Volume. Unmute.
+        0x70, //Left Out: -24dB Volume. Unmute.
+        0x70, //Right Out: -24dB Volume. Unmute.
+        0x12, //Analogue Path: Use Line In. Disable Bypass. Use DAC
+        0x06, //Digital Path: Enable High-Pass filter. 48kHz de-emphasis.
+        0x02, //Power: Power-up chip and output. Leave mic off as not used.
+        0x4E, //Data Format: I2S Mode, 24bit, Master Mode (do not change this!)
+        0x00, //Sampling: Normal Mode, 48kHz sample rate
+        0x01  //Active: Enable Codec
+    };
+    unsigned int regs[WM8731_MAX_BATCH];
+    unsigned short values[WM8731_MAX_BATCH];
+    unsigned int reg;
+    signed int status;
+    if (wm8731_initStep == 0) {
+        //Set the local base address pointer
+#ifdef WM8731_HOST
+        wm8731_base_ptr = wm8731_host_registers;
+#else
+        wm8731_base_ptr = (unsigned int *) base_address;
+#endif
+        wm8731_initialised = false;
+        //Ensure I2C Controller "I2C1" is initialised
+        if (!HPS_I2C_isInitialised(0)) {
+            status = HPS_I2C_initialise(0);
+            if (status != HPS_I2C_SUCCESS) return status;
+        }
+        //Initialise the WM8731 codec over I2C. The codec state is unknown so every
+        //register is sent, in nine writes: power with the output off, the input
+        //pair and the output pair as one write each, analogue path, digital path,
+        //data format, sampling, active, then power again with the output on.
+        wm8731_registersValid = 0;
+        for (reg = 0; reg < WM8731_NUM_REGISTERS; reg++) {
+            wm8731_staged[reg] = initValues[reg];
+        }
+        wm8731_submitRegisters(regs, values, wm8731_buildCommit(regs, values));
+        wm8731_initStep = 1;
+        return WM8731_PENDING;
+    }
+    //Keep the writes moving until they are all sent
+    HPS_I2C_service(0);
+    if (wm8731_batchBusy()) return WM8731_PENDING;
+    wm8731_initStep = 0;
+    status = wm8731_finishRegisters();
     if (status != HPS_I2C_SUCCESS) return status;
+    wm8731_sampleRate = 48000;
     //Check if the base pointer is valid. This allows us to use the library to initialise the I2C side only.
     if (base_address == 0x0) return WM8731_ERRORNOINIT;
     //Mark as initialised so later functions know we are ready
@@ -85,7 +266,7 @@ signed int WM8731_clearFIFO( bool adc, bool dac) {
     unsigned int cntrl;
     if (!WM8731_isInitialised()) return WM8731_ERRORNOINIT; //not initialised
     //Read in current control value
-    cntrl = wm8731_base_ptr[WM8731_CONTROL];
+    cntrl = wm8731_readRegister(WM8731_CONTROL);
     //Calculate new value - with corresponding bits for clearing adc and/or dac FIFOs
     if (adc) {
         cntrl |= (1<<2);
@@ -94,7 +275,7 @@ signed int WM8731_clearFIFO( bool adc, bool dac) {
         cntrl |= (1<<3);
     }
     //Assert reset flags
-    wm8731_base_ptr[WM8731_CONTROL] = cntrl;
+    wm8731_writeRegister(WM8731_CONTROL, cntrl);
     //Clear the flags
     if (adc) {
         cntrl &= ~(1<<2);
@@ -103,11 +284,92 @@ signed int WM8731_clearFIFO( bool adc, bool dac) {
         cntrl &= ~(1<<3);
     }
     //Then clear reset flags
-    wm8731_base_ptr[WM8731_CONTROL] = cntrl;
+    wm8731_writeRegister(WM8731_CONTROL, cntrl);
     //And done.
     return WM8731_SUCCESS; //success
 }
 
+//Set Output Volume
+signed int WM8731_setOutputVolume( signed int db ) {
+    unsigned short value;
+    //Convert to the register value, 1dB per step
+    if (db > 6) db = 6;
+    if (db < -73) {
+        value = WM8731_OUTVOL_MUTE;
+    } else {
+        value = (unsigned short)(WM8731_OUTVOL_0DB + db);
+    }
+    value |= WM8731_OUTVOL_ZCEN;
+    //Sent as one write to both channels if they change together
+    wm8731_staged[WM8731_I2C_LEFTOUTCNTRL] = value;
+    wm8731_staged[WM8731_I2C_RIGHTOUTCNTRL] = value;
+    return WM8731_commit();
+}
+
+//Set Sample Rate
+signed int WM8731_setSampleRate( unsigned int rate ) {
+    unsigned short sampling;
+    unsigned short deemphasis;
+    signed int status;
+    //Normal mode with the 12.288MHz MCLK, so BOSR is 0. See Table 18 of datasheet
+    switch (rate) {
+        case 8000:  sampling = (0x3 << 2); deemphasis = (0x0 << 1); break; //No 8kHz de-emphasis
+        case 32000: sampling = (0x6 << 2); deemphasis = (0x1 << 1); break;
+        case 48000: sampling = (0x0 << 2); deemphasis = (0x3 << 1); break;
+        case 96000: sampling = (0x7 << 2); deemphasis = (0x0 << 1); break; //No 96kHz de-emphasis
+        default: return WM8731_INVALIDRATE;
+    }
+    if (rate == wm8731_sampleRate) return WM8731_SUCCESS;
+    //Commit stops the digital interface while the sample rate changes
+    wm8731_staged[WM8731_I2C_SMPLINGCNTRL] = sampling;
+    wm8731_staged[WM8731_I2C_DGTLPATHCNTRL] = (wm8731_staged[WM8731_I2C_DGTLPATHCNTRL] & ~WM8731_DGTLPATH_DEEMPH) | deemphasis;
+    status = WM8731_commit();
+    if (status != HPS_I2C_SUCCESS) return status;
+    wm8731_sampleRate = rate;
+    return WM8731_SUCCESS;
+}
+
+//Get Sample Rate
+unsigned int WM8731_getSampleRate( void ) {
+    return wm8731_sampleRate;
+}
+
+//Soft Mute
+signed int WM8731_softMute( bool mute ) {
+    if (mute) {
+        wm8731_staged[WM8731_I2C_DGTLPATHCNTRL] |= WM8731_DGTLPATH_DACMU;
+    } else {
+        wm8731_staged[WM8731_I2C_DGTLPATHCNTRL] &= ~WM8731_DGTLPATH_DACMU;
+    }
+    return WM8731_commit();
+}
+
+//Set Register
+signed int WM8731_setRegister( unsigned int reg, unsigned short value ) {
+    if ((reg >= WM8731_NUM_REGISTERS) || (value > 0x1FF)) return WM8731_INVALIDREG;
+    wm8731_staged[reg] = value;
+    return WM8731_SUCCESS;
+}
+
+//Get Register
+unsigned short WM8731_getRegister( unsigned int reg ) {
+    if (reg >= WM8731_NUM_REGISTERS) return 0;
+    return wm8731_staged[reg];
+}
+
+//Commit Registers
+signed int WM8731_commit( void ) {
+    unsigned int regs[WM8731_MAX_BATCH];
+    unsigned short values[WM8731_MAX_BATCH];
+    return wm8731_writeRegisters(regs, values, wm8731_buildCommit(regs, values));
+}
+
+//Set Power Down
+signed int WM8731_setPowerDown( unsigned int blocks ) {
+    wm8731_staged[WM8731_I2C_POWERCNTRL] = blocks & 0x7F;
+    return WM8731_commit();
+}
+
 //Get FIFO Space Address
 volatile unsigned char* WM8731_getFIFOSpacePtr( void ) {
     return (unsigned char*)&wm8731_base_ptr[WM8731_FIFOSPACE];
@@ -13,6 +13,12 @@
  * -----------+-------------------------------
  * 20/09/2017 | Creation of driver
  * 20/10/2017 | Change to include status codes
+ * 19/10/2026 | Add output volume and soft mute with shadow registers
+ * 19/10/2026 | Add selectable sample rate
+ * 19/10/2026 | Send register writes as queued I2C batches
+ * 19/10/2026 | Add staged register writes with commit and power down
+ * 19/10/2026 | Add stepped initialisation that does not wait for the I2C writes
+ * 19/10/2026 | Add WM8731_HOST to run on a model of the audio controller
  *
  */
 
@@ -25,6 +31,37 @@
 //Error Codes
 #define WM8731_SUCCESS      0
 #define WM8731_ERRORNOINIT -1
+#define WM8731_INVALIDRATE -8 //Below the HPS_I2C codes which can also be returned
+#define WM8731_INVALIDREG  -9
+#define WM8731_PENDING      1 //Initialisation still in progress
+
+//I2C Register Address Offsets
+#define WM8731_I2C_LEFTINCNTRL   (0x00/sizeof(unsigned short))
+#define WM8731_I2C_RIGHTINCNTRL  (0x02/sizeof(unsigned short))
+#define WM8731_I2C_LEFTOUTCNTRL  (0x04/sizeof(unsigned short))
+#define WM8731_I2C_RIGHTOUTCNTRL (0x06/sizeof(unsigned short))
+#define WM8731_I2C_ANLGPATHCNTRL (0x08/sizeof(unsigned short))
+#define WM8731_I2C_DGTLPATHCNTRL (0x0A/sizeof(unsigned short))
+#define WM8731_I2C_POWERCNTRL    (0x0C/sizeof(unsigned short))
+#define WM8731_I2C_DATAFMTCNTRL  (0x0E/sizeof(unsigned short))
+#define WM8731_I2C_SMPLINGCNTRL  (0x10/sizeof(unsigned short))
+#define WM8731_I2C_ACTIVECNTRL   (0x12/sizeof(unsigned short))
+#define WM8731_NUM_REGISTERS     10
+
+//Power Down Register Bits
+#define WM8731_POWER_LINEIN  (1<<0)
+#define WM8731_POWER_MIC     (1<<1)
+#define WM8731_POWER_ADC     (1<<2)
+#define WM8731_POWER_DAC     (1<<3)
+#define WM8731_POWER_OUT     (1<<4)
+#define WM8731_POWER_OSC     (1<<5)
+#define WM8731_POWER_CLKOUT  (1<<6)
+
+//Audio Controller Register Offsets
+#define WM8731_CONTROL    (0x0/sizeof(unsigned int))
+#define WM8731_FIFOSPACE  (0x4/sizeof(unsigned int))
+#define WM8731_LEFTFIFO   (0x8/sizeof(unsigned int))
+#define WM8731_RIGHTFIFO  (0xC/sizeof(unsigned int))
 
 //FIFO Space Offsets
 #define WM8731_RARC 0
@@ -34,9 +71,21 @@
 
 //Initialise Audio Codec
 // - base_address is memory-mapped address of audio controller
+// - Define WM8731_HOST to build for a host computer. The audio controller
+//   registers are then reached through WM8731_hostRead and WM8731_hostWrite,
+//   whatever base_address is given, as long as it is not 0. The codec is
+//   reached through HPS_I2C, so build that for the host too.
 // - returns 0 if successful
 signed int WM8731_initialise ( unsigned int base_address );
 
+//Initialise Audio Codec in steps
+// - Starts the I2C writes of WM8731_initialise and returns without waiting for
+//   them, so other work can be done meanwhile. Call again until it is done.
+// - base_address is memory-mapped address of audio controller
+// - returns WM8731_PENDING while the writes are being sent, then the status
+//   WM8731_initialise would have returned
+signed int WM8731_initialiseStep ( unsigned int base_address );
+
 //Check if driver initialised
 // - Returns true if driver previously initialised
 // - WM8731_initialise() must be called if false.
@@ -46,6 +95,53 @@ bool WM8731_isInitialised( void );
 // - returns 0 if successful
 signed int WM8731_clearFIFO( bool adc, bool dac);
 
+//Set Output Volume
+// - Sets the headphone/line output volume of both channels in one I2C write
+// - db is the volume in dB, from -73 to +6 in 1dB steps. Lower values mute.
+// - The change is made at a zero crossing so it does not click
+// - returns 0 if successful
+signed int WM8731_setOutputVolume( signed int db );
+
+//Set Sample Rate
+// - rate is the ADC and DAC sample rate in Hz: 8000, 32000, 48000 or 96000
+// - The codec is stopped while the rate changes. De-emphasis is matched
+//   to the new rate where the codec supports it.
+// - returns 0 if successful, or WM8731_INVALIDRATE if the rate is not supported
+signed int WM8731_setSampleRate( unsigned int rate );
+
+//Get Sample Rate
+// - returns the sample rate in Hz, 48000 after initialisation
+unsigned int WM8731_getSampleRate( void );
+
+//Soft Mute
+// - mute = true ramps the DAC output down to silence, false ramps it back up
+// - returns 0 if successful
+signed int WM8731_softMute( bool mute );
+
+//Set Register
+// - Stages a new value for a codec register. Nothing is sent until WM8731_commit().
+// - reg is one of the WM8731_I2C_ register offsets, value is the 9bit value
+// - returns 0 if successful, or WM8731_INVALIDREG
+signed int WM8731_setRegister( unsigned int reg, unsigned short value );
+
+//Get Register
+// - returns the staged value of a codec register
+unsigned short WM8731_getRegister( unsigned int reg );
+
+//Commit Registers
+// - Sends the staged registers that differ from what the codec holds, as one
+//   batch of back to back I2C writes. Matching left/right pairs are sent as
+//   one write. The codec is stopped while the sample rate or data format
+//   change, and the output is powered up last.
+// - returns 0 if successful. Registers that failed are sent again next time.
+signed int WM8731_commit( void );
+
+//Set Power Down
+// - blocks is the WM8731_POWER_ bits of the codec blocks to power down. Any
+//   not given are powered up.
+// - returns 0 if successful
+signed int WM8731_setPowerDown( unsigned int blocks );
+
 //Get FIFO Space Address
 volatile unsigned char* WM8731_getFIFOSpacePtr( void );
 
@@ -55,4 +151,14 @@ volatile unsigned int* WM8731_getLeftFIFOPtr( void );
 //Get Right FIFO Address
 volatile unsigned int* WM8731_getRightFIFOPtr( void );
 
+#ifdef WM8731_HOST
+//Audio controller access on a host
+// - Every read and write of the audio controller registers, by this driver
+//   and by the audio output driver, goes through these, which a model of
+//   the audio controller must provide.
+// - reg is one of the audio controller register offsets above.
+unsigned int WM8731_hostRead(unsigned int reg);
+void WM8731_hostWrite(unsigned int reg, unsigned int value);
+#endif
+
 #endif /*DE1SoC_WM8731_H_*/
@@ -0,0 +1,180 @@
+/**
+ * Delay.c
+ *
+ * Delays that do not stop the caller, sharing HPS SP Timer 1
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "Delay.h"
+
+#include "HPS_Watchdog/HPS_Watchdog.h"
+
+#ifndef DELAY_HOST
+// HPS SP Timer 1, clocked at 100MHz with no prescaler
+volatile unsigned int *delay_timer_ptr = (unsigned int *)0xFFC09000;
+
+// SP Timer register offsets
+#define DELAY_TIMER_LOAD (0x00 / sizeof(unsigned int))
+#define DELAY_TIMER_VALUE (0x04 / sizeof(unsigned int))
+#define DELAY_TIMER_CONTROL (0x08 / sizeof(unsigned int))
+
+// Control value to count down from the load value and reload, with the IRQ masked
+#define DELAY_TIMER_RUN 0x7
+
+// Timer value at the last clock update
+unsigned int delay_last_value;
+#endif
+
+// Clock started
+bool delay_running = false;
+
+// Delay clock in ticks, extended to 64-bits
+unsigned long long delay_ticks = 0;
+
+// Pending delays as a binary min-heap on deadline, the earliest at index 0
+DelayEvent *delay_heap[DELAY_MAX_PENDING];
+unsigned int delay_count = 0;
+
+// Helper Functions
+
+// Brings the delay clock up to date, starting it on first use
+unsigned long long delay_now(void) {
+#ifndef DELAY_HOST
+    unsigned int value;
+    if (!delay_running) {
+        // Count down from the largest value, wrapping every 42.9 seconds
+        delay_timer_ptr[DELAY_TIMER_CONTROL] = 0;
+        delay_timer_ptr[DELAY_TIMER_LOAD] = 0xFFFFFFFF;
+        delay_timer_ptr[DELAY_TIMER_CONTROL] = DELAY_TIMER_RUN;
+        delay_last_value = 0xFFFFFFFF;
+        delay_running = true;
+    }
+    // The timer counts down, so the time passed is the drop in value, modulo the wrap
+    value = delay_timer_ptr[DELAY_TIMER_VALUE];
+    delay_ticks += delay_last_value - value;
+    delay_last_value = value;
+#endif
+    return delay_ticks;
+}
+
+// Moves the delay at index up the heap until its parent is earlier
+void delay_siftUp(unsigned int index) {
+    DelayEvent *delay = delay_heap[index];
+    unsigned int parent;
+    while (index) {
+        parent = (index - 1) / 2;
+        if (delay_heap[parent]->deadline <= delay->deadline) break;
+        delay_heap[index] = delay_heap[parent];
+        delay_heap[index]->index = index;
+        index = parent;
+    }
+    delay_heap[index] = delay;
+    delay->index = index;
+}
+
+// Moves the delay at index down the heap until its children are later
+void delay_siftDown(unsigned int index) {
+    DelayEvent *delay = delay_heap[index];
+    unsigned int child;
+    while ((child = index * 2 + 1) < delay_count) {
+        // Pick the earlier child
+        if ((child + 1 < delay_count) && (delay_heap[child + 1]->deadline < delay_heap[child]->deadline)) child++;
+        if (delay->deadline <= delay_heap[child]->deadline) break;
+        delay_heap[index] = delay_heap[child];
+        delay_heap[index]->index = index;
+        index = child;
+    }
+    delay_heap[index] = delay;
+    delay->index = index;
+}
+
+// Takes a pending delay out of the heap
+void delay_remove(DelayEvent *delay) {
+    unsigned int index = delay->index;
+    delay->pending = false;
+    delay_count--;
+    if (index == delay_count) return;
+    // Fill the gap with the last delay, and move it to where it belongs
+    delay_heap[index] = delay_heap[delay_count];
+    delay_heap[index]->index = index;
+    if (index && (delay_heap[index]->deadline < delay_heap[(index - 1) / 2]->deadline)) {
+        delay_siftUp(index);
+    } else {
+        delay_siftDown(index);
+    }
+}
+
+// Finishes a delay that is due and runs its callback
+void delay_finish(DelayEvent *delay) {
+    delay_remove(delay);
+    if (delay->callback) delay->callback(delay->context);
+}
+
+// Driver Functions
+
+signed int Delay_after(DelayEvent *delay, unsigned int us, DelayCallback callback, void *context) {
+    if (delay->pending) delay_remove(delay);
+    if (delay_count >= DELAY_MAX_PENDING) return DELAY_ERRORFULL;
+    // Round up to the next tick, so a delay is never done early and one
+    // started from a callback never runs in the same service
+    delay->deadline = delay_now() + (unsigned long long)us * DELAY_TICKS_PER_US + 1;
+    delay->callback = callback;
+    delay->context = context;
+    delay->pending = true;
+    delay_heap[delay_count] = delay;
+    delay_siftUp(delay_count++);
+    return DELAY_SUCCESS;
+}
+
+bool Delay_isDone(DelayEvent *delay) {
+    if (!delay->pending) return true;
+    if (delay->deadline > delay_now()) return false;
+    delay_finish(delay);
+    return true;
+}
+
+void Delay_cancel(DelayEvent *delay) {
+    if (delay->pending) delay_remove(delay);
+}
+
+void Delay_service(void) {
+    unsigned long long now = delay_now();
+    while (delay_count && (delay_heap[0]->deadline <= now)) {
+        delay_finish(delay_heap[0]);
+    }
+}
+
+void Delay_wait(unsigned int us) {
+    unsigned long long end = delay_now() + (unsigned long long)us * DELAY_TICKS_PER_US;
+#ifdef DELAY_HOST
+    delay_ticks = end;
+#else
+    while (delay_now() < end) {
+        ResetWDT();
+    }
+#endif
+}
+
+unsigned int Delay_nextUs(void) {
+    unsigned long long now = delay_now();
+    if (!delay_count || (delay_heap[0]->deadline <= now)) return 0;
+    return (unsigned int)((delay_heap[0]->deadline - now + DELAY_TICKS_PER_US - 1) / DELAY_TICKS_PER_US);
+}
+
+unsigned long long Delay_nowUs(void) {
+    return delay_now() / DELAY_TICKS_PER_US;
+}
+
+#ifdef DELAY_HOST
+void Delay_advance(unsigned int us) {
+    unsigned long long end = delay_ticks + (unsigned long long)us * DELAY_TICKS_PER_US;
+    while (delay_count && (delay_heap[0]->deadline <= end)) {
+        delay_ticks = delay_heap[0]->deadline;
+        delay_finish(delay_heap[0]);
+    }
+    delay_ticks = end;
+}
+#endif
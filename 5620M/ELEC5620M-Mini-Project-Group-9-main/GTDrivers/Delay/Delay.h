@@ -0,0 +1,144 @@
+/**
+ * Delay.h
+ *
+ * Delays that do not stop the caller. Each delay runs a callback, or
+ * can be polled with Delay_isDone, once its time is up. All pending
+ * delays share HPS SP Timer 1, which runs freely at 100MHz as the
+ * delay clock. They are kept in a heap ordered by deadline, so
+ * checking for due delays only looks at the earliest.
+ *
+ * There is no interrupt, so Delay_service must be called regularly
+ * (at least every 42 seconds, the period of the timer) from the main
+ * loop for callbacks to run.
+ *
+ * Define DELAY_HOST to build for a host computer. The delay clock is
+ * then virtual time, only moved on by Delay_advance and Delay_wait, so
+ * driver state machines can be run step by step with exact timing.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef DELAY_H_
+#define DELAY_H_
+
+#include <stdbool.h>
+
+#define DELAY_SUCCESS 0
+#define DELAY_ERRORFULL 1
+
+// Most delays that can be pending at once
+#define DELAY_MAX_PENDING 16
+
+// Ticks per microsecond of the delay clock
+#define DELAY_TICKS_PER_US 100
+
+// Function called when a delay is done
+typedef void (*DelayCallback)(void *context);
+
+/**
+ * DelayEvent
+ *
+ * A pending delay. The struct belongs to the caller and must stay in
+ * memory until the delay is done or cancelled. It must start zeroed
+ * (as globals are), after that the fields are used by the driver.
+ **/
+typedef struct {
+    unsigned long long deadline;  // Delay clock tick the delay is done at
+    DelayCallback callback;       // Function to call when done, or 0
+    void *context;                // Passed to the callback
+    bool pending;                 // True until the delay is done or cancelled
+    unsigned int index;           // Position in the heap
+} DelayEvent;
+
+/**
+ * Delay_after
+ *
+ * Starts a delay. A delay that is already pending is restarted.
+ *
+ * Inputs:
+ * 		delay:		delay to start
+ * 		us:			time until the delay is done in microseconds
+ * 		callback:	function to call when it is done, or 0 to poll with Delay_isDone
+ * 		context:	passed to the callback
+ *
+ * Outputs:
+ * 		DELAY_SUCCESS, or DELAY_ERRORFULL if DELAY_MAX_PENDING delays are pending
+ **/
+signed int Delay_after(DelayEvent *delay, unsigned int us, DelayCallback callback, void *context);
+
+/**
+ * Delay_isDone
+ *
+ * Checks whether a delay is done. A delay found to be done here has
+ * its callback run straight away, rather than from Delay_service.
+ *
+ * Inputs:
+ * 		delay:	delay to check
+ *
+ * Outputs:
+ * 		true once the delay is done or if it was cancelled
+ **/
+bool Delay_isDone(DelayEvent *delay);
+
+/**
+ * Delay_cancel
+ *
+ * Stops a pending delay without running its callback.
+ *
+ * Inputs:
+ * 		delay:	delay to cancel
+ **/
+void Delay_cancel(DelayEvent *delay);
+
+/**
+ * Delay_service
+ *
+ * Runs the callbacks of every delay that is done, earliest first.
+ * Callbacks may start new delays.
+ **/
+void Delay_service(void);
+
+/**
+ * Delay_wait
+ *
+ * Waits for a time without using the heap, resetting the watchdog
+ * while waiting. Callbacks of other delays are not run meanwhile.
+ *
+ * Inputs:
+ * 		us:	time to wait in microseconds
+ **/
+void Delay_wait(unsigned int us);
+
+/**
+ * Delay_nextUs
+ *
+ * Outputs:
+ * 		Time until the earliest pending delay is done in microseconds,
+ * 		rounded up, or 0 if one is already done or none are pending
+ **/
+unsigned int Delay_nextUs(void);
+
+/**
+ * Delay_nowUs
+ *
+ * Outputs:
+ * 		Time of the delay clock in microseconds
+ **/
+unsigned long long Delay_nowUs(void);
+
+#ifdef DELAY_HOST
+/**
+ * Delay_advance
+ *
+ * Moves virtual time on and runs the callbacks of the delays that are
+ * done, each with the clock set to its deadline.
+ *
+ * Inputs:
+ * 		us:	time to move on in microseconds
+ **/
+void Delay_advance(unsigned int us);
+#endif
+
+#endif /* DELAY_H_ */
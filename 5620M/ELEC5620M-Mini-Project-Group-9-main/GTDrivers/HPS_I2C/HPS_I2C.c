@@ -1,14 +1,19 @@
-
 #include "HPS_I2C.h"
-#include "../HPS_Watchdog/HPS_Watchdog.h"
-
-#include <math.h>
 
 //I2C Controller Base Addresses
 volatile unsigned int *i2c_base_ptr[2] = {(unsigned int *)0xFFC04000,(unsigned int *)0xFFC05000};
 
 //Driver global static variables (visible only to this .c file)
 bool i2c_initialised[2] = {false,false};
+//Transaction queue. Transactions from the head up to i2c_load are in the
+//FIFOs, i2c_load is being loaded, and the rest are waiting.
+HPS_I2C_Transaction *i2c_head[2] = {0,0};
+HPS_I2C_Transaction *i2c_tail[2] = {0,0};
+HPS_I2C_Transaction *i2c_load[2] = {0,0};
+//Read commands sent whose data has not yet been taken from the RX FIFO
+unsigned int i2c_readsPending[2] = {0,0};
+//Bytes written by transactions that completed successfully
+unsigned int i2c_bytesSent[2] = {0,0};
 
 #define HPS_I2C_CON	    (0x00/sizeof(unsigned int))
 #define HPS_I2C_TAR     (0x04/sizeof(unsigned int))
@@ -18,25 +23,61 @@ bool i2c_initialised[2] = {false,false};
 #define HPS_I2C_FSHCNT  (0x1C/sizeof(unsigned int))
 #define HPS_I2C_FSLCNT  (0x20/sizeof(unsigned int))
 #define HPS_I2C_IRQFLG  (0x2C/sizeof(unsigned int))
+#define HPS_I2C_IRQMSK  (0x30/sizeof(unsigned int))
+#define HPS_I2C_IRQRAW  (0x34/sizeof(unsigned int))
+#define HPS_I2C_RXTL    (0x38/sizeof(unsigned int))
+#define HPS_I2C_TXTL    (0x3C/sizeof(unsigned int))
 #define HPS_I2C_CLRTXA  (0x54/sizeof(unsigned int))
+#define HPS_I2C_CLRSTP  (0x60/sizeof(unsigned int))
 #define HPS_I2C_ENABLE  (0x6C/sizeof(unsigned int))
 #define HPS_I2C_STATUS  (0x70/sizeof(unsigned int))
+#define HPS_I2C_TXFLR   (0x74/sizeof(unsigned int))
+#define HPS_I2C_RXFLR   (0x78/sizeof(unsigned int))
+
+//Data command bits
+#define HPS_I2C_CMD_READ    (1 << 8)
+#define HPS_I2C_CMD_STOP    (1 << 9)
+#define HPS_I2C_CMD_RESTART (1 << 10)
+
+//IRQ bits
+#define HPS_I2C_IRQ_RXFULL  (1 << 2)
+#define HPS_I2C_IRQ_TXEMPTY (1 << 4)
+#define HPS_I2C_IRQ_TXABORT (1 << 6)
+#define HPS_I2C_IRQ_STOP    (1 << 9)
+
+//Status bits
+#define HPS_I2C_STATUS_MSTACT (1 << 5)
+
+//Depth of the TX and RX FIFOs
+#define HPS_I2C_FIFO_DEPTH 64
+
+//Register access. A host build reads and writes a model of the controller instead.
+#ifdef HPS_I2C_HOST
+#define i2c_readRegister(controller_id, reg)         HPS_I2C_hostRead(controller_id, reg)
+#define i2c_writeRegister(controller_id, reg, value) HPS_I2C_hostWrite(controller_id, reg, value)
+#else
+#define i2c_readRegister(controller_id, reg)         (i2c_base_ptr[controller_id][reg])
+#define i2c_writeRegister(controller_id, reg, value) (i2c_base_ptr[controller_id][reg] = (value))
+#endif
 
 //Initialise HPS I2C Controller
 // - controller is id of the I2C controller to initialised.
 // - DE1-SoC uses ID 0 for Accelerometer/VGA/Audio/ADC. ID 1 for LTC 14pin Hdr.
 // - Returns true if successful.
 signed int HPS_I2C_initialise(unsigned int controller_id){
+#ifndef HPS_I2C_HOST
 	//Local variables
     unsigned int* gpio1_base_ptr = (unsigned int*) 0xFF709000;
+#endif
     //Calculate I2C clock high/low parameters
 
     //Check if valid I2C controller id.
     if (controller_id > 1) return HPS_I2C_INVALIDID; //invalid id.
 
     //Ensure I2C disabled for configuration
-    i2c_base_ptr[controller_id][HPS_I2C_ENABLE] = 0x00;
+    i2c_writeRegister(controller_id, HPS_I2C_ENABLE, 0x00);
 
+#ifndef HPS_I2C_HOST
     //If I2C controller ID 0, make sure GPIO is configured to route external I2C mux on DE1-SoC to HPS
     if (controller_id == 0) {
         gpio1_base_ptr[1] = gpio1_base_ptr[1] | (1 << 19); //Make sure bit 19 (GPIO48) is an output
@@ -48,15 +89,24 @@ signed int HPS_I2C_initialise(unsigned int controller_id){
         gpio1_base_ptr[1] = gpio1_base_ptr[1] | (1 << 11); //Make sure bit 11 (GPIO40) is an output
         gpio1_base_ptr[0] = gpio1_base_ptr[0] | (1 << 11); //Then set it high.
     }
+#endif
     
     //Configure the I2C peripheral
-    i2c_base_ptr[controller_id][HPS_I2C_CON   ] = 0x65;     //I2C master mode, 400kHz, 7-bit address
+    i2c_writeRegister(controller_id, HPS_I2C_CON, 0x65);     //I2C master mode, 400kHz, 7-bit address
     //See "Hard Processor System Technical Reference Manual" section 20 for magic calculations of HCNT/LCNT
-    i2c_base_ptr[controller_id][HPS_I2C_FSHCNT] = 60; //I2C clock high parameter for 400kHz
-    i2c_base_ptr[controller_id][HPS_I2C_FSLCNT] = 130; //I2C clock low parameter for 400kHz
+    i2c_writeRegister(controller_id, HPS_I2C_FSHCNT, 60); //I2C clock high parameter for 400kHz
+    i2c_writeRegister(controller_id, HPS_I2C_FSLCNT, 130); //I2C clock low parameter for 400kHz
+    //IRQs are only unmasked while there are transactions to service
+    i2c_writeRegister(controller_id, HPS_I2C_IRQMSK, 0x00);
+    i2c_writeRegister(controller_id, HPS_I2C_RXTL, 0);                      //RX IRQ as soon as any data arrives
+    i2c_writeRegister(controller_id, HPS_I2C_TXTL, HPS_I2C_FIFO_DEPTH / 2); //TX IRQ once half empty
+    i2c_head[controller_id] = 0;
+    i2c_tail[controller_id] = 0;
+    i2c_load[controller_id] = 0;
+    i2c_readsPending[controller_id] = 0;
 
     //Enable the I2C peripheral
-    i2c_base_ptr[controller_id][HPS_I2C_ENABLE] = 0x01;     //I2C enabled
+    i2c_writeRegister(controller_id, HPS_I2C_ENABLE, 0x01);     //I2C enabled
 
     //Now initialised
     i2c_initialised[controller_id] = true;
@@ -104,31 +154,190 @@ signed int HPS_I2C_write32b(unsigned int controller_id, unsigned char address, u
     return HPS_I2C_write(controller_id, address, data_arr, sizeof(data_arr));
 }
 signed int HPS_I2C_write(unsigned int controller_id, unsigned char address, unsigned char data[], unsigned int length){
-    //Validate write request
+    //Nothing to read, so this is a write-then-read with no read
+    if (length == 0) return HPS_I2C_INVALIDLEN; //invalid length. Must send at least one byte.
+    return HPS_I2C_read(controller_id, address, data, length, 0, 0);
+}
+
+
+//Function to write then read data
+// - controller is id of the I2C controller to use.
+// - Returns 0 if successful.
+signed int HPS_I2C_read(unsigned int controller_id, unsigned char address, const unsigned char write_data[], unsigned int write_length, unsigned char read_data[], unsigned int read_length){
+    HPS_I2C_Transaction transaction;
+    signed int status;
+    //Queue the transfer behind anything already submitted, then wait for it.
+    transaction.address = address;
+    transaction.write_data = write_data;
+    transaction.write_length = write_length;
+    transaction.read_data = read_data;
+    transaction.read_length = read_length;
+    transaction.callback = 0;
+    transaction.context = 0;
+    status = HPS_I2C_submit(controller_id, &transaction);
+    if (status != HPS_I2C_SUCCESS) return status;
+    return HPS_I2C_wait(controller_id, &transaction);
+}
+
+
+//Finish the transaction at the head of the queue
+void i2c_complete(unsigned int controller_id, signed int status){
+    HPS_I2C_Transaction *transaction = i2c_head[controller_id];
+    i2c_head[controller_id] = transaction->next;
+    if (!transaction->next) i2c_tail[controller_id] = 0;
+    if (status == HPS_I2C_SUCCESS) i2c_bytesSent[controller_id] += transaction->write_length;
+    //Status last, as the caller may reuse the transaction as soon as it changes
+    if (transaction->callback) transaction->callback(status, transaction->context);
+    transaction->status = status;
+}
+
+//Load commands for queued transactions into the TX FIFO while there is space
+void i2c_loadFIFO(unsigned int controller_id){
+    HPS_I2C_Transaction *transaction;
+    unsigned int datcmd;
+    while ((transaction = i2c_load[controller_id]) && (i2c_readRegister(controller_id, HPS_I2C_TXFLR) < HPS_I2C_FIFO_DEPTH)) {
+        if (!transaction->written && !transaction->requested) {
+            //Starting a new transaction. The target address can only change
+            //once everything before it has finished.
+            if ((i2c_readRegister(controller_id, HPS_I2C_TAR) & 0x3FF) != transaction->address) {
+                if ((transaction != i2c_head[controller_id]) || (i2c_readRegister(controller_id, HPS_I2C_STATUS) & HPS_I2C_STATUS_MSTACT)) return;
+                i2c_writeRegister(controller_id, HPS_I2C_TAR, transaction->address); //Load the target address as 7bit address in master mode
+            }
+        }
+        if (transaction->written < transaction->write_length) {
+            //Next byte to send
+            datcmd = transaction->write_data[transaction->written++];
+        } else {
+            //Next byte to read. Don't ask for more than the RX FIFO can hold.
+            if (i2c_readsPending[controller_id] >= HPS_I2C_FIFO_DEPTH) return;
+            datcmd = HPS_I2C_CMD_READ;
+            if ((transaction->requested == 0) && transaction->write_length) {
+                datcmd |= HPS_I2C_CMD_RESTART; //Turn the bus around after the write
+            }
+            transaction->requested++;
+            i2c_readsPending[controller_id]++;
+        }
+        if ((transaction->written == transaction->write_length) && (transaction->requested == transaction->read_length)) {
+            //Last command of the transaction. Set the "stop" bit so the controller issues end of I2C transaction
+            datcmd |= HPS_I2C_CMD_STOP;
+            i2c_load[controller_id] = transaction->next;
+        }
+        i2c_writeRegister(controller_id, HPS_I2C_DATCMD, datcmd);
+    }
+}
+
+//Collect read data from the RX FIFO. It arrives in the order the transactions were loaded.
+void i2c_readFIFO(unsigned int controller_id){
+    HPS_I2C_Transaction *transaction = i2c_head[controller_id];
+    unsigned char data;
+    while (i2c_readRegister(controller_id, HPS_I2C_RXFLR)) {
+        data = (unsigned char)i2c_readRegister(controller_id, HPS_I2C_DATCMD);
+        while (transaction && (transaction->received == transaction->read_length)) transaction = transaction->next;
+        if (transaction) transaction->read_data[transaction->received++] = data;
+        i2c_readsPending[controller_id]--;
+    }
+}
+
+//Queue a transaction
+// - controller is id of the I2C controller to use.
+// - Returns 0 if queued.
+signed int HPS_I2C_submit(unsigned int controller_id, HPS_I2C_Transaction *transaction){
+    //Validate request
     if (controller_id > 1) return HPS_I2C_INVALIDID; //invalid id.
     if (!HPS_I2C_isInitialised(controller_id)) return HPS_I2C_ERRORNOINIT; //not initialised
-    if (i2c_base_ptr[controller_id][HPS_I2C_STATUS] & (1 << 5)) return HPS_I2C_BUSY; //I2C master busy
-    if (length == 0) return HPS_I2C_INVALIDLEN; //invalid length. Must send at least one byte.
-    if (length > 255) return HPS_I2C_INVALIDLEN; //Transfer too long. FIFO has space for 1 address and 255 data words. Could add throttling later.
-    //If a valid controller and the master is not currently busy, perform our transfer
-    i2c_base_ptr[controller_id][HPS_I2C_TAR] = address; //Load the target address as 7bit address in master mode
-    //Load the transmit data into the TX FIFO
-    do {
-        unsigned int datcmd = (unsigned int)*data++; //Get the next data and pad to unsigned int.
-        if (length == 1) { //If this is the last word
-            datcmd |= (1<<9); //Set the "stop" bit of the datcmd register so controller issues end of I2C transaction
+    if (!transaction->write_length && !transaction->read_length) return HPS_I2C_INVALIDLEN; //Must transfer at least one byte.
+    //Reset driver state
+    transaction->status = HPS_I2C_PENDING;
+    transaction->written = 0;
+    transaction->requested = 0;
+    transaction->received = 0;
+    transaction->next = 0;
+    //Add to the end of the queue with the IRQ masked so the service can't run part way through
+    i2c_writeRegister(controller_id, HPS_I2C_IRQMSK, 0x00);
+    if (i2c_tail[controller_id]) {
+        i2c_tail[controller_id]->next = transaction;
+    } else {
+        i2c_head[controller_id] = transaction;
+    }
+    i2c_tail[controller_id] = transaction;
+    if (!i2c_load[controller_id]) i2c_load[controller_id] = transaction;
+    //Start it straight away if the bus is free
+    HPS_I2C_service(controller_id);
+    return HPS_I2C_SUCCESS;
+}
+
+//Run the transaction engine
+// - controller is id of the I2C controller to service.
+void HPS_I2C_service(unsigned int controller_id){
+    HPS_I2C_Transaction *transaction;
+    if ((controller_id > 1) || !i2c_initialised[controller_id]) return;
+    //Stop the IRQ running this at the same time
+    i2c_writeRegister(controller_id, HPS_I2C_IRQMSK, 0x00);
+    //Check for a TX abort. The controller flushes the TX FIFO, so every
+    //transaction that was loaded has failed.
+    if (i2c_readRegister(controller_id, HPS_I2C_IRQRAW) & HPS_I2C_IRQ_TXABORT) {
+        while (i2c_readRegister(controller_id, HPS_I2C_RXFLR)) (void)i2c_readRegister(controller_id, HPS_I2C_DATCMD); //Discard read data
+        while (i2c_head[controller_id] && (i2c_head[controller_id] != i2c_load[controller_id])) {
+            i2c_complete(controller_id, HPS_I2C_ABORTED);
         }
-        i2c_base_ptr[controller_id][HPS_I2C_DATCMD] = datcmd;
-    } while (--length); //Repeat while there is more data to send
-    //Wait for master to finish
-    while (i2c_base_ptr[controller_id][HPS_I2C_STATUS] & (1 << 5)) {
-        //Check for a TX abort IRQ
-        if (i2c_base_ptr[controller_id][HPS_I2C_IRQFLG] & (1 << 6)){
-            i2c_base_ptr[controller_id][HPS_I2C_CLRTXA] = 1; //Clear TX abort flag.
-            return HPS_I2C_ABORTED; //Aborted if any of the abort flags are set.
+        //Including any part loaded
+        transaction = i2c_head[controller_id];
+        if (transaction && (transaction->written || transaction->requested)) {
+            i2c_load[controller_id] = transaction->next;
+            i2c_complete(controller_id, HPS_I2C_ABORTED);
         }
-        ResetWDT();
+        i2c_readsPending[controller_id] = 0;
+        (void)i2c_readRegister(controller_id, HPS_I2C_CLRTXA); //Reading clears the TX abort flag, which lets the TX FIFO be used again.
     }
-    //And done.
-    return HPS_I2C_SUCCESS; //success
+    i2c_readFIFO(controller_id);
+    (void)i2c_readRegister(controller_id, HPS_I2C_CLRSTP); //Reading clears the stop detected IRQ
+    //Load more commands, completing transactions whenever the bus goes idle
+    //as that may let one with a different address start.
+    do {
+        i2c_loadFIFO(controller_id);
+        if (i2c_readRegister(controller_id, HPS_I2C_TXFLR)) break;
+        //The FIFO is empty. If a transaction is part loaded the controller holds
+        //the bus for it, otherwise it is sending the last byte. Until the bus is
+        //idle, leave the rest to the stop IRQ or the next service call.
+        transaction = i2c_load[controller_id];
+        if (transaction && (transaction->written || transaction->requested)) break;
+        if (i2c_readRegister(controller_id, HPS_I2C_STATUS) & HPS_I2C_STATUS_MSTACT) break;
+        if (i2c_readRegister(controller_id, HPS_I2C_IRQRAW) & HPS_I2C_IRQ_TXABORT) break; //Failed, handled on the next service
+        //Everything fully loaded has now been sent
+        i2c_readFIFO(controller_id);
+        transaction = i2c_head[controller_id];
+        if (!transaction || (transaction == i2c_load[controller_id])) break;
+        do {
+            i2c_complete(controller_id, HPS_I2C_SUCCESS);
+            transaction = i2c_head[controller_id];
+        } while (transaction && (transaction != i2c_load[controller_id]));
+    } while (i2c_load[controller_id]);
+    //Unmask the IRQs needed for what is left to do
+    if (i2c_head[controller_id]) {
+        i2c_writeRegister(controller_id, HPS_I2C_IRQMSK, HPS_I2C_IRQ_TXABORT | HPS_I2C_IRQ_STOP | HPS_I2C_IRQ_RXFULL | (i2c_load[controller_id] ? HPS_I2C_IRQ_TXEMPTY : 0));
+    }
+}
+
+//Wait for a transaction to complete
+// - controller is id of the I2C controller it was submitted to.
+// - Returns the status of the transaction.
+signed int HPS_I2C_wait(unsigned int controller_id, HPS_I2C_Transaction *transaction){
+    while (transaction->status == HPS_I2C_PENDING) {
+        HPS_I2C_service(controller_id);
+    }
+    return transaction->status;
+}
+
+//Check if all queued transactions have completed
+// - controller is id of the I2C controller to check.
+bool HPS_I2C_isIdle(unsigned int controller_id){
+    if (controller_id > 1) return true; //invalid id.
+    return i2c_head[controller_id] == 0;
+}
+
+//Get the number of bytes sent
+// - controller is id of the I2C controller to check.
+unsigned int HPS_I2C_getBytesSent(unsigned int controller_id){
+    if (controller_id > 1) return 0; //invalid id.
+    return i2c_bytesSent[controller_id];
 }
@@ -14,6 +14,9 @@
  * 20/09/2017 | Creation of driver
  * 20/10/2017 | Change to include status codes
  * 13/07/2019 | Support Controller ID 1 (LTC Hdr)
+ * 19/10/2026 | Add queued transactions with reads and callbacks
+ * 19/10/2026 | Count bytes sent
+ * 19/10/2026 | Add HPS_I2C_HOST to run on a model of the controller
  *
  */
 
@@ -29,6 +32,36 @@
 #define HPS_I2C_BUSY        -3
 #define HPS_I2C_INVALIDLEN  -4
 #define HPS_I2C_ABORTED     -5
+#define HPS_I2C_PENDING      1 //Transaction queued or in progress
+
+//Completion callback for a queued transaction
+// - status is HPS_I2C_SUCCESS or HPS_I2C_ABORTED.
+// - context is the value given in the transaction.
+// - Called from HPS_I2C_service(), so from the I2C IRQ if it is used.
+typedef void (*HPS_I2C_Callback)(signed int status, void *context);
+
+//I2C transaction
+// - Writes write_length bytes then, after a repeated start, reads read_length
+//   bytes. Either length may be 0, but not both.
+// - The transaction and its buffers belong to the caller, and must not be
+//   changed or reused until status is no longer HPS_I2C_PENDING.
+typedef struct HPS_I2C_Transaction HPS_I2C_Transaction;
+struct HPS_I2C_Transaction {
+    //Set by the caller
+    unsigned char address;           //7bit I2C slave device address
+    const unsigned char *write_data; //Bytes to send
+    unsigned int write_length;
+    unsigned char *read_data;        //Buffer for bytes read
+    unsigned int read_length;
+    HPS_I2C_Callback callback;       //Called on completion, or 0 for none
+    void *context;                   //Passed to the callback
+    //Set by the driver
+    volatile signed int status;      //HPS_I2C_PENDING until complete
+    unsigned int written;            //Write commands loaded into the TX FIFO
+    unsigned int requested;          //Read commands loaded into the TX FIFO
+    unsigned int received;           //Bytes read from the RX FIFO
+    HPS_I2C_Transaction *next;       //Next transaction in the queue
+};
 
 //Initialise HPS I2C Controller
 // - controller is id of the I2C controller to initialised.
@@ -47,9 +80,60 @@ bool HPS_I2C_isInitialised(unsigned int controller_id);
 // - 7bit address is I2C slave device address
 // - data is data to be sent (8bit, 16bit, 32bit or array respectively)
 // - Returns 0 if successful.
+// - Blocks until the transfer completes. There is no limit on length.
 signed int HPS_I2C_write8b(unsigned int controller_id, unsigned char address, unsigned char data);
 signed int HPS_I2C_write16b(unsigned int controller_id, unsigned char address, unsigned short data);
 signed int HPS_I2C_write32b(unsigned int controller_id, unsigned char address, unsigned int data);
 signed int HPS_I2C_write(unsigned int controller_id, unsigned char address, unsigned char data[], unsigned int length);
 
+//Function to write then read data
+// - controller is id of the I2C controller to use.
+// - address is I2C slave device address
+// - write_data (e.g. a register number) is sent, then read_length bytes are
+//   read into read_data after a repeated start. write_length may be 0.
+// - Blocks until the transfer completes. Returns 0 if successful.
+signed int HPS_I2C_read(unsigned int controller_id, unsigned char address, const unsigned char write_data[], unsigned int write_length, unsigned char read_data[], unsigned int read_length);
+
+//Queue a transaction
+// - controller is id of the I2C controller to use.
+// - transaction is started once those queued before it finish. Transactions
+//   to the same address run back to back without waiting for the CPU, so a
+//   batch of register writes can be submitted together.
+// - Returns 0 if queued, in which case the callback will always be called.
+signed int HPS_I2C_submit(unsigned int controller_id, HPS_I2C_Transaction *transaction);
+
+//Run the transaction engine
+// - controller is id of the I2C controller to service.
+// - Refills the TX FIFO, collects read data and completes transactions.
+// - Either call this from the I2C IRQ handler (IRQ 190 for ID 0, 191 for
+//   ID 1), which the driver enables while transactions are queued, or poll it.
+void HPS_I2C_service(unsigned int controller_id);
+
+//Wait for a transaction to complete
+// - controller is id of the I2C controller it was submitted to.
+// - Polls HPS_I2C_service() until done, so works with or without the IRQ.
+// - Returns the status of the transaction.
+signed int HPS_I2C_wait(unsigned int controller_id, HPS_I2C_Transaction *transaction);
+
+//Check if all queued transactions have completed
+// - controller is id of the I2C controller to check.
+bool HPS_I2C_isIdle(unsigned int controller_id);
+
+//Get the number of bytes sent
+// - controller is id of the I2C controller to check.
+// - Returns the data bytes written by successful transactions since power on,
+//   not counting address bytes. Wraps at 2^32.
+unsigned int HPS_I2C_getBytesSent(unsigned int controller_id);
+
+#ifdef HPS_I2C_HOST
+//Register access on a host
+// - Define HPS_I2C_HOST to build for a host computer. Every register read
+//   and write then goes through these, which a model of the controller
+//   must provide, and the pin mux GPIO is left alone.
+// - reg is the byte offset of the register in the HPS Technical Reference
+//   Manual divided by 4, the index used with the base address pointer.
+unsigned int HPS_I2C_hostRead(unsigned int controller_id, unsigned int reg);
+void HPS_I2C_hostWrite(unsigned int controller_id, unsigned int reg, unsigned int value);
+#endif
+
 #endif /* HPS_I2C_H_ */
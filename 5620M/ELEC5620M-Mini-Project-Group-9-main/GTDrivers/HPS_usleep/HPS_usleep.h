@@ -7,16 +7,15 @@
  * function which allows the processor to be stalled for
  * x microseconds.
  * 
- * Delays up to ~2.09 seconds are supported. This is to
- * ensure the watchdog won't time out before the delay is
- * finished. This corresponds to a value of 0x200000 us.
- * The watchdog will be reset just before the delay starts
- * and just after it finishes.
+ * This is a thin wrapper around Delay_wait. The watchdog
+ * is reset while waiting, so there is no limit on the delay.
+ * Drivers that can do other work while waiting should use
+ * Delay_after instead.
  * 
- * The delay is performed using the HPS SP1 Timer at base
- * address 0xFFC09000. This is a hardware timer in the SoC
- * HPS bridge, so does not conflict with the ARM A9 private
- * timer module.
+ * The delay is timed using the HPS SP1 Timer at base
+ * address 0xFFC09000, which is shared with the Delay
+ * driver. This is a hardware timer in the SoC HPS bridge,
+ * so does not conflict with the ARM A9 private timer module.
  *
  * Company: University of Leeds
  * Author: T Carpenter
@@ -15,13 +15,18 @@
  * 05/02/2017 | Creation of driver
  * 20/10/2017 | Update driver to match new styles
  * 06/05/2023 | Modify driver for Mini-Project
+ * 19/10/2026 | Split initialisation into steps that can run alongside other work
+ * 19/10/2026 | Leave watchdog resets to the supervisor
+ * 19/10/2026 | Profile LCD_update
+ * 19/10/2026 | Trace LCD_update
  */
 
 #include "LCD.h"
 
-#include "../HPS_Watchdog/HPS_Watchdog.h"
 #include "../HPS_usleep/HPS_usleep.h"  //some useful delay routines
 #include "BasicFont/BasicFont.h"
+#include "Profiler/Profiler.h"
+#include "Tracer/Tracer.h"
 
 //
 // Driver global static variables (visible only to this .c file)
@@ -33,6 +38,9 @@ volatile unsigned short *lcd_hwbase_ptr = 0x0;  // 0xFF200080
 // Driver Initialised
 bool lcd_initialised = false;
 
+// Next step of LCD_initialiseStep
+unsigned int lcd_init_step = 0;
+
 // Store pixel contents of screen in a variable
 unsigned short screen[LCD_WIDTH * LCD_HEIGHT];
 
@@ -214,53 +222,78 @@ void sortCoordinates(int array[][2], int rows, int key) {
 }
 
 signed int LCD_initialise(unsigned int pio_base_address, unsigned int pio_hw_base_address) {
+    unsigned int wait_us;
+    signed int status;
+
+    // Run each step of the start up sequence, sleeping for the delays between them
+    do {
+        status = LCD_initialiseStep(pio_base_address, pio_hw_base_address, &wait_us);
+        if (status == LCD_PENDING) usleep(wait_us);
+    } while (status == LCD_PENDING);
+    return status;
+}
+
+signed int LCD_initialiseStep(unsigned int pio_base_address, unsigned int pio_hw_base_address, unsigned int *wait_us) {
     unsigned int regVal;
     unsigned int idx;
 
-    // Set the local base address pointers
-    lcd_pio_ptr = (unsigned int *)pio_base_address;
-    lcd_hwbase_ptr = (unsigned short *)pio_hw_base_address;
-
-    // Initialise LCD PIO direction
-    // Read-Modify-Write
-    regVal = lcd_pio_ptr[LCD_PIO_DIR];                                          // Read
-    regVal = regVal | (LCD_CMDDATMASK | LCD_LCD_ON | LCD_RESETn | LCD_HW_OPT);  // All data/cmd bits are outputs
-    lcd_pio_ptr[LCD_PIO_DIR] = regVal;                                          // Write
-
-    // Initialise LCD data/control register.
-    // Read-Modify-Write
-    regVal = lcd_pio_ptr[LCD_PIO_DATA];                                          // Read
-    regVal = regVal & ~(LCD_CMDDATMASK | LCD_LCD_ON | LCD_RESETn | LCD_HW_OPT);  // Mask all data/cmd bits
-    regVal = regVal | (LCD_CSn | LCD_WRn | LCD_RDn);                             // Deselect Chip and set write and read signals to idle.
+    switch (lcd_init_step) {
+        case 0:
+            // Set the local base address pointers
+            lcd_pio_ptr = (unsigned int *)pio_base_address;
+            lcd_hwbase_ptr = (unsigned short *)pio_hw_base_address;
+            lcd_initialised = false;
+
+            // Initialise LCD PIO direction
+            // Read-Modify-Write
+            regVal = lcd_pio_ptr[LCD_PIO_DIR];                                          // Read
+            regVal = regVal | (LCD_CMDDATMASK | LCD_LCD_ON | LCD_RESETn | LCD_HW_OPT);  // All data/cmd bits are outputs
+            lcd_pio_ptr[LCD_PIO_DIR] = regVal;                                          // Write
+
+            // Initialise LCD data/control register.
+            // Read-Modify-Write
+            regVal = lcd_pio_ptr[LCD_PIO_DATA];                                          // Read
+            regVal = regVal & ~(LCD_CMDDATMASK | LCD_LCD_ON | LCD_RESETn | LCD_HW_OPT);  // Mask all data/cmd bits
+            regVal = regVal | (LCD_CSn | LCD_WRn | LCD_RDn);                             // Deselect Chip and set write and read signals to idle.
 #ifdef HARDWARE_OPTIMISED
-    regVal = regVal | LCD_HW_OPT;  // Enable HW opt bit.
+            regVal = regVal | LCD_HW_OPT;  // Enable HW opt bit.
 #endif
-    lcd_pio_ptr[LCD_PIO_DATA] = regVal;  // Write
-
-    // LCD requires specific reset sequence:
-    LCD_powerConfig(true);  // turn on for 1ms
-    usleep(1000);
-    LCD_powerConfig(false);  // then off for 10ms
-    usleep(10000);
-    LCD_powerConfig(true);  // finally back on and wait 120ms for LCD to power on
-    usleep(120000);
-
-    // Upload Initialisation Data
-    for (idx = 0; idx < LCD_INIT_DATA_LEN; idx++) {
-        LCD_write(LCD_initData[idx][0], LCD_initData[idx][1]);
-    }
+            lcd_pio_ptr[LCD_PIO_DATA] = regVal;  // Write
 
-    // Allow 120ms time for LCD to wake up
-    usleep(120000);
+            // LCD requires specific reset sequence:
+            LCD_powerConfig(true);  // turn on for 1ms
+            *wait_us = 1000;
+            break;
+        case 1:
+            LCD_powerConfig(false);  // then off for 10ms
+            *wait_us = 10000;
+            break;
+        case 2:
+            LCD_powerConfig(true);  // finally back on and wait 120ms for LCD to power on
+            *wait_us = 120000;
+            break;
+        case 3:
+            // Upload Initialisation Data
+            for (idx = 0; idx < LCD_INIT_DATA_LEN; idx++) {
+                LCD_write(LCD_initData[idx][0], LCD_initData[idx][1]);
+            }
 
-    // Turn on display drivers
-    LCD_write(false, 0x0029);
+            // Allow 120ms time for LCD to wake up
+            *wait_us = 120000;
+            break;
+        default:
+            // Turn on display drivers
+            LCD_write(false, 0x0029);
 
-    // Mark as initialised so later functions know we are ready
-    lcd_initialised = true;
+            // Mark as initialised so later functions know we are ready
+            lcd_initialised = true;
+            lcd_init_step = 0;
 
-    // And clear the display
-    return LCD_clearDisplay(LCD_BLACK);
+            // And clear the display
+            return LCD_clearDisplay(LCD_BLACK);
+    }
+    lcd_init_step++;
+    return LCD_PENDING;
 }
 
 // Check if driver initialised
@@ -336,8 +369,6 @@ void LCD_powerConfig(bool isOn) {
 signed int LCD_clearDisplay(unsigned short colour) {
     signed int status;
     unsigned int idx;
-    // Reset watchdog.
-    ResetWDT();
     // Define window as entire display (LCD_setWindow will check if we are initialised).
     status = LCD_setWindow(0, 0, LCD_WIDTH, LCD_HEIGHT);
     if (status != LCD_SUCCESS)
@@ -691,12 +722,17 @@ signed int LCD_update() {
     if (!LCD_isInitialised())
         return LCD_ERRORNOINIT;
 
+    PROF_BEGIN(PROF_LCD_UPDATE);
+    TRACE_BEGIN(TRACE_LCD_FLUSH, 0);
     // Set full display as window
     status = LCD_setWindow(0, 0, LCD_WIDTH, LCD_HEIGHT);
     length = LCD_HEIGHT * LCD_WIDTH;
 
-    if (status != LCD_SUCCESS)
+    if (status != LCD_SUCCESS) {
+        TRACE_END(TRACE_LCD_FLUSH, 0);
+        PROF_END(PROF_LCD_UPDATE);
         return status;
+    }
 
     // For each pixel in 'screen' array
     for (id = 0; id < length; id++) {
@@ -707,5 +743,7 @@ signed int LCD_update() {
     }
 
     // Done
+    TRACE_END(TRACE_LCD_FLUSH, 0);
+    PROF_END(PROF_LCD_UPDATE);
     return LCD_SUCCESS;
 }
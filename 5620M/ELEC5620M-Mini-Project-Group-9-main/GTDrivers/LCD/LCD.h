@@ -15,6 +15,7 @@
  * 05/02/2017 | Creation of driver
  * 20/10/2017 | Update driver to match new styles
  * 06/05/2023 | Modify driver for Mini-Project
+ * 19/10/2026 | Split initialisation into steps that can run alongside other work
  */
 
 #ifndef DE1SoC_LCD_H_
@@ -36,6 +37,7 @@
 #define LCD_ERRORNOINIT -1
 #define LCD_INVALIDSIZE -4
 #define LCD_INVALIDSHAPE -6
+#define LCD_PENDING 1
 
 // Size of the LCD
 #define LCD_WIDTH 240
@@ -55,6 +57,12 @@
 //  - Returns 0 if successful
 signed int LCD_initialise(unsigned int pio_base_address, unsigned int pio_hw_base_address);
 
+// Function to run the next step of initialising the LCD, for doing other work
+// during the LCD's reset and wake up delays. Call again once wait_us has passed.
+//  - Returns LCD_PENDING with wait_us set while there are steps left
+//  - Returns 0 once the LCD is initialised and cleared
+signed int LCD_initialiseStep(unsigned int pio_base_address, unsigned int pio_hw_base_address, unsigned int *wait_us);
+
 // Check if driver initialised
 //  - returns true if initialised
 bool LCD_isInitialised(void);
@@ -63,15 +63,10 @@ signed int LED_write(unsigned int value){
     return LED_SUCCESS;
 }
 
-//Use all 10 LEDs to show value in the min-max range
-//The LEDs will light from left to right 
-//The number of LEDs that light up is proportional to the value
-//in the min-max range
-unsigned int LED_setValueInRange(float min, float max, float value){
+//Get the register value that lights the LEDs in proportion to
+//value in the min-max range, from left to right
+unsigned int LED_rangeToValue(float min, float max, float value){
 	int led_value;
-	int led_register_value;
-
-    if (!LED_isInitialised()) return LED_ERRORNOINIT;
 
     //If value is above maximum, set equal to maximum
     if(value > max)
@@ -80,9 +75,18 @@ unsigned int LED_setValueInRange(float min, float max, float value){
     //Convert value from min-max range to 0-10 range    
     led_value = (value/(max-min))*10;
     //Get the LED register value for the display value
-    led_register_value = LED_mappings[led_value];
+    return LED_mappings[led_value];
+}
+
+//Use all 10 LEDs to show value in the min-max range
+//The LEDs will light from left to right 
+//The number of LEDs that light up is proportional to the value
+//in the min-max range
+unsigned int LED_setValueInRange(float min, float max, float value){
+    if (!LED_isInitialised()) return LED_ERRORNOINIT;
+
     // Write the register value to the pointer
-    LED_write(led_register_value);
+    LED_write(LED_rangeToValue(min, max, value));
 
     return LED_SUCCESS;
 }
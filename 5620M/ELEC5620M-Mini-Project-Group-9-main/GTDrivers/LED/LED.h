@@ -38,6 +38,18 @@ bool LED_isInitialised( void );
 */
 signed int LED_write(unsigned int value);
 
+/*
+ * LED_rangeToValue
+ * This function gives the register value LED_setValueInRange would
+ * write, without writing it, so it can be buffered.
+ * 
+ * Input:
+ *    min:     minimum value
+ *    max:     maximum value
+ *    value:   value in the min max range
+*/
+unsigned int LED_rangeToValue(float min, float max, float value);
+
 /*
  * LED_setValueInRange
  * This function will use all 10 LEDs to diplay a value in the 
@@ -0,0 +1,144 @@
+/**
+ * OutputBuffer.c
+ *
+ * Implementation of the output write buffer
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "OutputBuffer.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "LED/LED.h"
+#include "Servo/DE1SoC_Servo.h"
+#include "SevenSeg/SevenSeg.h"
+
+// Buffered registers: the LEDs, then each seven segment display, then each servo
+#define OUTPUTBUFFER_LEDS 0
+#define OUTPUTBUFFER_SEVENSEG (OUTPUTBUFFER_LEDS + 1)
+#define OUTPUTBUFFER_SERVO (OUTPUTBUFFER_SEVENSEG + OUTPUTBUFFER_NUM_SEVENSEG)
+#define OUTPUTBUFFER_NUM_REGISTERS (OUTPUTBUFFER_SERVO + OUTPUTBUFFER_NUM_SERVOS)
+
+// A buffered register
+typedef struct {
+    unsigned int value;     // Last value set
+    unsigned int hardware;  // Value last written to the hardware
+    bool pending;           // Set since the last commit
+    bool known;             // Written since the buffer was initialised
+} OutputRegister;
+
+OutputRegister outputbuffer_registers[OUTPUTBUFFER_NUM_REGISTERS];
+
+// Values set since the last commit
+unsigned int outputbuffer_frame_requested = 0;
+
+OutputBufferStats outputbuffer_stats;
+
+// Helper Functions
+
+// Buffers a value for a register
+void outputbuffer_set(unsigned int id, unsigned int value) {
+    outputbuffer_registers[id].value = value;
+    outputbuffer_registers[id].pending = true;
+    outputbuffer_frame_requested++;
+}
+
+// Writes a register to the hardware, returning false if it could not be
+// written yet
+bool outputbuffer_write(unsigned int id, unsigned int value) {
+    if (id == OUTPUTBUFFER_LEDS) return LED_write(value) == LED_SUCCESS;
+    if (id < OUTPUTBUFFER_SERVO) {
+        return SevenSeg_write(id - OUTPUTBUFFER_SEVENSEG, (unsigned char)value) == SEVENSEG_SUCCESS;
+    }
+    return Servo_pulseWidth(id - OUTPUTBUFFER_SERVO, (signed char)value) == SERVO_SUCCESS;
+}
+
+// Driver Functions
+
+void OutputBuffer_initialise(void) {
+    unsigned int id;
+    for (id = 0; id < OUTPUTBUFFER_NUM_REGISTERS; id++) {
+        outputbuffer_registers[id].pending = false;
+        outputbuffer_registers[id].known = false;
+    }
+    outputbuffer_frame_requested = 0;
+    OutputBuffer_resetStats();
+}
+
+void OutputBuffer_setLEDs(unsigned int value) {
+    outputbuffer_set(OUTPUTBUFFER_LEDS, value);
+}
+
+signed int OutputBuffer_setSevenSeg(unsigned int display, unsigned char value) {
+    if (display >= OUTPUTBUFFER_NUM_SEVENSEG) return OUTPUTBUFFER_ERRORINVALID;
+    outputbuffer_set(OUTPUTBUFFER_SEVENSEG + display, value);
+    return OUTPUTBUFFER_SUCCESS;
+}
+
+signed int OutputBuffer_setServo(unsigned int servo_id, signed char width) {
+    if (servo_id >= OUTPUTBUFFER_NUM_SERVOS) return OUTPUTBUFFER_ERRORINVALID;
+    // Kept as a byte so it compares equal to the value written
+    outputbuffer_set(OUTPUTBUFFER_SERVO + servo_id, (unsigned char)width);
+    return OUTPUTBUFFER_SUCCESS;
+}
+
+void OutputBuffer_commit(void) {
+    OutputRegister *reg;
+    unsigned int id, written = 0;
+
+    for (id = 0; id < OUTPUTBUFFER_NUM_REGISTERS; id++) {
+        reg = &outputbuffer_registers[id];
+        if (!reg->pending) continue;
+        if (reg->known && (reg->value == reg->hardware)) {
+            // Already showing this value
+            reg->pending = false;
+        } else if (outputbuffer_write(id, reg->value)) {
+            reg->hardware = reg->value;
+            reg->known = true;
+            reg->pending = false;
+            written++;
+        }
+        // A register that could not be written, such as a busy servo,
+        // stays pending for the next commit
+    }
+
+    outputbuffer_stats.frames++;
+    outputbuffer_stats.requested += outputbuffer_frame_requested;
+    outputbuffer_stats.written += written;
+    if (outputbuffer_frame_requested > outputbuffer_stats.max_requested) {
+        outputbuffer_stats.max_requested = outputbuffer_frame_requested;
+    }
+    if (written > outputbuffer_stats.max_written) outputbuffer_stats.max_written = written;
+    outputbuffer_frame_requested = 0;
+}
+
+void OutputBuffer_getStats(OutputBufferStats *stats) {
+    *stats = outputbuffer_stats;
+}
+
+void OutputBuffer_resetStats(void) {
+    outputbuffer_stats.frames = 0;
+    outputbuffer_stats.requested = 0;
+    outputbuffer_stats.written = 0;
+    outputbuffer_stats.max_requested = 0;
+    outputbuffer_stats.max_written = 0;
+}
+
+void OutputBuffer_print(void) {
+    OutputBufferStats *stats = &outputbuffer_stats;
+    unsigned long long saved = (stats->requested > stats->written) ? stats->requested - stats->written : 0;
+    unsigned int frames = stats->frames ? stats->frames : 1;
+
+    printf("Output writes over %u frames: %llu requested, %llu made, %llu saved\n", stats->frames,
+           stats->requested, stats->written, saved);
+    // Per frame to two decimal places
+    printf("Per frame: %u.%02u requested (max %u), %u.%02u made (max %u), %u.%02u saved\n",
+           (unsigned int)(stats->requested / frames), (unsigned int)(stats->requested * 100 / frames % 100),
+           stats->max_requested, (unsigned int)(stats->written / frames),
+           (unsigned int)(stats->written * 100 / frames % 100), stats->max_written, (unsigned int)(saved / frames),
+           (unsigned int)(saved * 100 / frames % 100));
+}
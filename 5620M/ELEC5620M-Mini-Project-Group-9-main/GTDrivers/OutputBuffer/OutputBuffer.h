@@ -0,0 +1,124 @@
+/**
+ * OutputBuffer.h
+ *
+ * Buffer of the writes to the LEDs, seven segment displays and servo
+ * made in a frame. Each register keeps only the last value set, and
+ * OutputBuffer_commit at the end of the frame writes only the registers
+ * whose value differs from what was last written to the hardware. A
+ * screen that sets the same outputs every frame then makes no writes.
+ *
+ * The values last written are remembered rather than read back, so the
+ * registers must not be written by anything else once buffering starts.
+ * A servo that is busy keeps its value for the next commit, where
+ * writing it directly would lose it.
+ *
+ * Every value set would have been a register write without the buffer,
+ * so the statistics count the writes saved.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef OUTPUTBUFFER_H_
+#define OUTPUTBUFFER_H_
+
+#define OUTPUTBUFFER_SUCCESS 0
+#define OUTPUTBUFFER_ERRORINVALID 1
+
+// Number of seven segment displays and servos buffered
+#define OUTPUTBUFFER_NUM_SEVENSEG 6
+#define OUTPUTBUFFER_NUM_SERVOS 4
+
+/**
+ * OutputBufferStats
+ *
+ * Writes buffered and made since the statistics were last reset.
+ **/
+typedef struct {
+    unsigned int frames;                 // Commits
+    unsigned long long requested;        // Values set, each a write without the buffer
+    unsigned long long written;          // Register writes made
+    unsigned int max_requested;          // Most values set in one frame
+    unsigned int max_written;            // Most register writes made in one frame
+} OutputBufferStats;
+
+/**
+ * OutputBuffer_initialise
+ *
+ * Empties the buffer and forgets the hardware values, so every register
+ * is written the first time it is set. Also resets the statistics.
+ **/
+void OutputBuffer_initialise(void);
+
+/**
+ * OutputBuffer_setLEDs
+ *
+ * Sets the value of the LED register, written at the next commit.
+ *
+ * Inputs:
+ * 		value:	LED register value, one bit for each LED
+ **/
+void OutputBuffer_setLEDs(unsigned int value);
+
+/**
+ * OutputBuffer_setSevenSeg
+ *
+ * Sets the segments of a seven segment display, written at the next
+ * commit. See SevenSeg_encodeWord and SevenSeg_encodeNumber.
+ *
+ * Inputs:
+ * 		display:	index of the display (0-5)
+ * 		value:		segments to light
+ *
+ * Outputs:
+ * 		OUTPUTBUFFER_SUCCESS or OUTPUTBUFFER_ERRORINVALID
+ **/
+signed int OutputBuffer_setSevenSeg(unsigned int display, unsigned char value);
+
+/**
+ * OutputBuffer_setServo
+ *
+ * Sets the pulse width of a servo, written at the next commit the servo
+ * is not busy. See Servo_rangeToPulseWidth.
+ *
+ * Inputs:
+ * 		servo_id:	index of the servo
+ * 		width:		pulse width, as for Servo_pulseWidth
+ *
+ * Outputs:
+ * 		OUTPUTBUFFER_SUCCESS or OUTPUTBUFFER_ERRORINVALID
+ **/
+signed int OutputBuffer_setServo(unsigned int servo_id, signed char width);
+
+/**
+ * OutputBuffer_commit
+ *
+ * Writes each register set since the last commit whose value differs
+ * from the hardware. Call once at the end of each frame.
+ **/
+void OutputBuffer_commit(void);
+
+/**
+ * OutputBuffer_getStats
+ *
+ * Inputs:
+ * 		stats:	filled in with the statistics
+ **/
+void OutputBuffer_getStats(OutputBufferStats *stats);
+
+/**
+ * OutputBuffer_resetStats
+ *
+ * Clears the statistics. The buffer and hardware values are kept.
+ **/
+void OutputBuffer_resetStats(void);
+
+/**
+ * OutputBuffer_print
+ *
+ * Prints the writes requested, made and saved per frame.
+ **/
+void OutputBuffer_print(void);
+
+#endif /* OUTPUTBUFFER_H_ */
@@ -0,0 +1,74 @@
+/**
+ * Profiler.c
+ *
+ * Cycle counting profiler using the Cortex-A9 PMU cycle counter
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "Profiler.h"
+
+void Profiler_startCounter(void) {
+#if defined(__ARMCC_VERSION)
+    register unsigned int pmcr __asm("cp15:0:c9:c12:0");
+    register unsigned int pmcntenset __asm("cp15:0:c9:c12:1");
+    // Enable the PMU counters and reset the cycle counter, counting every cycle
+    pmcr = (pmcr & ~(1 << 3)) | (1 << 2) | (1 << 0);
+    // Enable the cycle counter
+    pmcntenset = (1u << 31);
+#elif defined(__arm__)
+    unsigned int pmcr;
+    __asm__ volatile("mrc p15, 0, %0, c9, c12, 0" : "=r"(pmcr));
+    pmcr = (pmcr & ~(1 << 3)) | (1 << 2) | (1 << 0);
+    __asm__ volatile("mcr p15, 0, %0, c9, c12, 0" : : "r"(pmcr));
+    __asm__ volatile("mcr p15, 0, %0, c9, c12, 1" : : "r"(1u << 31));
+#endif
+}
+
+#ifdef PROFILER_ENABLED
+
+// Names of the scopes, in PROF_ id order
+const char *profiler_names[PROF_NUM_SCOPES] = {
+    "lcd_update",
+    "draw_main_menu",
+    "draw_pause_menu",
+    "draw_message",
+    "draw_question",
+    "draw_option",
+    "audio_play_tone",
+    "audio_fill",
+    "sd_read",
+    "sd_write"};
+
+// Measurements of every scope
+ProfilerScope profiler_scopes[PROF_NUM_SCOPES];
+
+void Profiler_initialise(void) {
+    Profiler_startCounter();
+    Profiler_reset();
+}
+
+void Profiler_reset(void) {
+    unsigned int id;
+    for (id = 0; id < PROF_NUM_SCOPES; id++) {
+        profiler_scopes[id].name = profiler_names[id];
+        profiler_scopes[id].count = 0;
+        profiler_scopes[id].min = 0xFFFFFFFF;
+        profiler_scopes[id].max = 0;
+        profiler_scopes[id].total = 0;
+    }
+}
+
+const ProfilerScope *Profiler_getScope(unsigned int id) {
+    if (id >= PROF_NUM_SCOPES) return 0;
+    return &profiler_scopes[id];
+}
+
+unsigned int Profiler_getMean(unsigned int id) {
+    if ((id >= PROF_NUM_SCOPES) || !profiler_scopes[id].count) return 0;
+    return (unsigned int)(profiler_scopes[id].total / profiler_scopes[id].count);
+}
+
+#endif /* PROFILER_ENABLED */
@@ -0,0 +1,151 @@
+/**
+ * Profiler.h
+ *
+ * Cycle counting profiler. Code to be measured is put between
+ * PROF_BEGIN(id) and PROF_END(id), and each scope keeps the number of
+ * calls and the minimum, total and maximum cycles taken in a static
+ * table, to be read in the debugger or with Profiler_getScope.
+ *
+ * On the board the cycles are read from the Cortex-A9 PMU cycle
+ * counter (PMCCNTR), which counts at the 900MHz CPU clock and wraps
+ * every 4.7 seconds, so each scope must take less than that. On a
+ * host the counter is CLOCK_MONOTONIC in nanoseconds.
+ *
+ * Globally define PROFILER_ENABLED to use the profiler. Otherwise the
+ * macros and functions compile to nothing, apart from Profiler_cycles
+ * and Profiler_startCounter which the tracer also uses.
+ *
+ * Scopes are not reentrant: a scope must end before it begins again.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+// Profiling scopes, named in Profiler.c
+#define PROF_LCD_UPDATE 0          // LCD_update
+#define PROF_DRAW_MAINMENU 1       // GraphicsEngine_drawMainMenu
+#define PROF_DRAW_PAUSEMENU 2      // GraphicsEngine_drawPauseMenu
+#define PROF_DRAW_MESSAGE 3        // GraphicsEngine_drawMessage
+#define PROF_DRAW_QUESTION 4       // GraphicsEngine_drawQuestion
+#define PROF_DRAW_OPTION 5         // GraphicsEngine_drawOption
+#define PROF_AUDIO_PLAYTONE 6      // AUDIOOUTPUT_playTone
+#define PROF_AUDIO_FILL 7          // AUDIOOUTPUT_fill
+#define PROF_SD_READ 8             // SDCARD_readLine and SDCARD_readFile
+#define PROF_SD_WRITE 9            // SDCARD_writeToFile
+#define PROF_NUM_SCOPES 10
+
+#if !defined(__ARMCC_VERSION) && !defined(__arm__)
+#include <time.h>
+#endif
+
+// Function to read the cycle counter
+__forceinline static unsigned int Profiler_cycles(void) {
+#if defined(__ARMCC_VERSION)
+    register unsigned int pmccntr __asm("cp15:0:c9:c13:0");
+    return pmccntr;
+#elif defined(__arm__)
+    unsigned int pmccntr;
+    __asm__ volatile("mrc p15, 0, %0, c9, c13, 0" : "=r"(pmccntr));
+    return pmccntr;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned int)((unsigned long long)now.tv_sec * 1000000000ULL + now.tv_nsec);
+#endif
+}
+
+/**
+ * Profiler_startCounter
+ *
+ * Enables the PMU and starts the cycle counter from zero. The counter
+ * is also used by the tracer, so this is built with or without
+ * PROFILER_ENABLED.
+ **/
+void Profiler_startCounter(void);
+
+#ifdef PROFILER_ENABLED
+
+/**
+ * ProfilerScope
+ *
+ * Measurements of one scope. Times are in cycles (nanoseconds on a host).
+ **/
+typedef struct {
+    const char *name;           // Name of the scope
+    unsigned int count;         // Number of times the scope ended
+    unsigned int min;           // Shortest time, 0xFFFFFFFF if never run
+    unsigned int max;           // Longest time
+    unsigned long long total;   // Sum of every time, for the mean
+    unsigned int start;         // Counter value when the scope began
+} ProfilerScope;
+
+extern ProfilerScope profiler_scopes[PROF_NUM_SCOPES];
+
+// Function to start timing a scope
+__forceinline static void Profiler_begin(unsigned int id) {
+    profiler_scopes[id].start = Profiler_cycles();
+}
+
+// Function to stop timing a scope and add the time to its measurements
+__forceinline static void Profiler_end(unsigned int id) {
+    unsigned int cycles = Profiler_cycles() - profiler_scopes[id].start;
+    ProfilerScope *scope = &profiler_scopes[id];
+    scope->count++;
+    scope->total += cycles;
+    if (cycles < scope->min) scope->min = cycles;
+    if (cycles > scope->max) scope->max = cycles;
+}
+
+#define PROF_BEGIN(id) Profiler_begin(id)
+#define PROF_END(id) Profiler_end(id)
+
+/**
+ * Profiler_initialise
+ *
+ * Starts the cycle counter and clears every scope.
+ **/
+void Profiler_initialise(void);
+
+/**
+ * Profiler_reset
+ *
+ * Clears the measurements of every scope.
+ **/
+void Profiler_reset(void);
+
+/**
+ * Profiler_getScope
+ *
+ * Inputs:
+ * 		id:	one of the PROF_ scope ids
+ *
+ * Outputs:
+ * 		Measurements of the scope, or 0 if the id is not valid
+ **/
+const ProfilerScope *Profiler_getScope(unsigned int id);
+
+/**
+ * Profiler_getMean
+ *
+ * Inputs:
+ * 		id:	one of the PROF_ scope ids
+ *
+ * Outputs:
+ * 		Mean time of the scope, 0 if it has not run
+ **/
+unsigned int Profiler_getMean(unsigned int id);
+
+#else
+
+#define PROF_BEGIN(id) ((void)0)
+#define PROF_END(id) ((void)0)
+#define Profiler_initialise() ((void)0)
+#define Profiler_reset() ((void)0)
+
+#endif /* PROFILER_ENABLED */
+
+#endif /* PROFILER_H_ */
@@ -21,13 +21,19 @@
 #include <string.h>
 
 #include "FatFS/ff.h"
+#include "Profiler/Profiler.h"
+#include "Tracer/Tracer.h"
 
 FATFS FatFs; // Instance of the variable to handle format of the file system to be used with limited resources such as ROM/RAM
 FIL Fil; // Instance of the data structure for open file/directory information
 
 // Function used to Mount the SD Card to initiliase the file system
-void SDCARD_mount() {
-    f_mount(&FatFs, "", 0);
+signed int SDCARD_mount() {
+    // Mount now rather than on first access, so the card is identified
+    // at a time chosen by the caller. If it fails FatFS tries again on
+    // the next access.
+    if (f_mount(&FatFs, "", 1) != FR_OK) return SDCARD_ERRORNOINIT;
+    return SDCARD_SUCCESS;
 }
 
 // This function will create a file.
@@ -49,6 +55,8 @@ void SDCARD_writeToFile(char filename[], char text[]) {
     // Pointer to the variable to return number of bytes written
     UINT bw;
 
+    PROF_BEGIN(PROF_SD_WRITE);
+    TRACE_BEGIN(TRACE_SD_WRITE, 0);
     // open the file, if it doesnt exist create the file
     fr = f_open(&Fil, filename, FA_WRITE | FA_CREATE_ALWAYS);
     // If operation was succesful
@@ -59,6 +67,33 @@ void SDCARD_writeToFile(char filename[], char text[]) {
 
     // close the file regardless
     fr = f_close(&Fil);
+    TRACE_END(TRACE_SD_WRITE, 0);
+    PROF_END(PROF_SD_WRITE);
+}
+
+// This function will add to the end of the file.
+void SDCARD_appendToFile(char filename[], char text[]) {
+    FRESULT fr;
+
+    // length is the number of characters in the text
+    UINT length = strlen(text);
+    // Pointer to the variable to return number of bytes written
+    UINT bw;
+
+    PROF_BEGIN(PROF_SD_WRITE);
+    TRACE_BEGIN(TRACE_SD_WRITE, 0);
+    // open the file at its end, if it doesnt exist create the file
+    fr = f_open(&Fil, filename, FA_WRITE | FA_OPEN_APPEND);
+    // If operation was succesful
+    if (fr == FR_OK) {
+        // write the text to the file
+        f_write(&Fil, text, length, &bw);
+    }
+
+    // close the file regardless
+    fr = f_close(&Fil);
+    TRACE_END(TRACE_SD_WRITE, 0);
+    PROF_END(PROF_SD_WRITE);
 }
 
 // This function will return the contents of the specified file
@@ -66,6 +101,8 @@ void SDCARD_writeToFile(char filename[], char text[]) {
 void SDCARD_readLine(char filename[], unsigned int length, char line[]) {
     FRESULT fr;
 
+    PROF_BEGIN(PROF_SD_READ);
+    TRACE_BEGIN(TRACE_SD_READ, 0);
     // Open file in read mode
     fr = f_open(&Fil, filename, FA_READ);
     // if file is found
@@ -75,6 +112,8 @@ void SDCARD_readLine(char filename[], unsigned int length, char line[]) {
     }
     // close the file
     fr = f_close(&Fil);
+    TRACE_END(TRACE_SD_READ, 0);
+    PROF_END(PROF_SD_READ);
 }
 
 // Function to read the entire file
@@ -83,6 +122,9 @@ unsigned int SDCARD_readFile(char filename[], char **lines) {
 
     // initialise number of lines read to 0
     int num_lines_read = 0;
+
+    PROF_BEGIN(PROF_SD_READ);
+    TRACE_BEGIN(TRACE_SD_READ, 0);
     // open the file in read mode
     fr = f_open(&Fil, filename, FA_READ);
     // if file found
@@ -96,6 +138,8 @@ unsigned int SDCARD_readFile(char filename[], char **lines) {
     }
     // close the file
     fr = f_close(&Fil);
+    TRACE_END(TRACE_SD_READ, 0);
+    PROF_END(PROF_SD_READ);
 
     return num_lines_read;
 }
@@ -41,9 +41,25 @@ void SDCARD_createFile(char filename[]);
 void SDCARD_writeToFile(char filename[], char text[]);
 
 /*
- * Function used to Mount the SD Card to initiliase the file system
+ * SDCARD_appendToFile
+ * This function will add text to the end of the file.
+ * The file is created if it does not exist.
+ *
+ * Input:
+ *    filename:     the name of the file to be added to
+ *    text:         the text to be added to the file
+ */
+void SDCARD_appendToFile(char filename[], char text[]);
+
+/*
+ * Function used to Mount the SD Card to initiliase the file system.
+ * The card is identified and its file system read straight away.
+ *
+ * Output:
+ *     SDCARD_SUCCESS, or SDCARD_ERRORNOINIT if the card could not be
+ *     mounted. The mount is tried again when the card is next accessed.
  */
-void SDCARD_mount(void);
+signed int SDCARD_mount(void);
 
 /*
  * SDCARD_readFile
@@ -18,6 +18,7 @@
  * 31/10/2017 | Creation of driver
  * 08/05/2023 | Addition of Servo_setPosition to set the
  * 			  |	position correctly
+ * 19/10/2026 | Addition of Servo_rangeToPulseWidth
  *
  */
 #include "../Servo/DE1SoC_Servo.h"
@@ -215,15 +216,21 @@ signed int Servo_pulseWidth( unsigned int servo_id, signed char width) {
     return status;
 }
 
-//Function used to set the position of the servo given the 
-//servo id,min-max range and position of servo
-void Servo_setPositionInRange(int servo_id, float min, float max, float position){
+//Function used to get the pulse width of a position in the
+//min-max range
+signed char Servo_rangeToPulseWidth(float min, float max, float position){
     //get the position as a percentage of the range
 	float percentage = position/(max-min);
     //use percentage to determine servo position
 	int servo_position = (254*percentage)-127;
+	return (signed char)servo_position;
+}
+
+//Function used to set the position of the servo given the 
+//servo id,min-max range and position of servo
+void Servo_setPositionInRange(int servo_id, float min, float max, float position){
     //set servo position
-	Servo_pulseWidth(servo_id, servo_position);
+	Servo_pulseWidth(servo_id, Servo_rangeToPulseWidth(min, max, position));
 }
 
 
@@ -18,6 +18,7 @@
  * 31/10/2017 | Creation of driver
  * 08/05/2023 | Addition of Servo_setPosition to set the
  *            |	position correctly
+ * 19/10/2026 | Addition of Servo_rangeToPulseWidth
  *
  */
 
@@ -106,6 +107,18 @@ signed int Servo_calibrate( unsigned int servo_id, signed char calibration);
 signed int Servo_pulseWidth( unsigned int servo_id, signed char width);
 
 
+/*
+ * Servo_rangeToPulseWidth
+ *
+ * This function gives the pulse width Servo_setPositionInRange would set,
+ * without setting it, so it can be buffered.
+ * Input:
+ * 		min:		minimum value
+ * 		max:		maximum value
+ * 		position:	position of servo
+*/
+signed char Servo_rangeToPulseWidth(float min, float max, float position);
+
 /*
  * Servo_setValueInRange
  *
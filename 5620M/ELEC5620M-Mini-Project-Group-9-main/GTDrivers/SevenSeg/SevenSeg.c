@@ -140,38 +140,47 @@ signed int SevenSeg_write(unsigned int display, unsigned char value) {
     return SEVENSEG_SUCCESS;
 }
 
-// Display a character on the specified display.
-signed int SevenSeg_displayCharacter(unsigned int display, char character) {
-    int character_index;
-    unsigned char display_value;
-
-    // Return error code if driver not initialised
-    if (!SevenSeg_isInitialised()) return SEVENSEG_ERRORNOINIT;
-
+// Get the segments that show a character
+unsigned char SevenSeg_encodeCharacter(char character) {
     // Find the index of character from display characters
-    character_index = findIndex(display_characters, num_display_characters, character);
+    int character_index = findIndex(display_characters, num_display_characters, character);
 
     // If value is found find corresponding seven segment mapping
     // Else set display value to mapping for whitespace
-    display_value = sevenseg_mappings[(character_index == -1) ? whitespace_index : character_index];
+    return sevenseg_mappings[(character_index == -1) ? whitespace_index : (unsigned int)character_index];
+}
+
+// Display a character on the specified display.
+signed int SevenSeg_displayCharacter(unsigned int display, char character) {
+    // Return error code if driver not initialised
+    if (!SevenSeg_isInitialised()) return SEVENSEG_ERRORNOINIT;
 
     // Display character on the display starting from left
-    SevenSeg_write(display, display_value);
+    SevenSeg_write(display, SevenSeg_encodeCharacter(character));
     return SEVENSEG_SUCCESS;
 }
 
+// Get the segments of each display that show a word from left to right
+void SevenSeg_encodeWord(char word[6], unsigned char values[MAX_DISPLAYABLE_CHARACTERS]) {
+    int loop_index;
+
+    // Loop through each character in word, the first on the leftmost display
+    for (loop_index = 0; loop_index < 6; loop_index++) {
+        values[5 - loop_index] = SevenSeg_encodeCharacter((char)word[loop_index]);
+    }
+}
+
 // Display a word using all 6 seven segment displays from left to right
 signed int SevenSeg_displayWord(char word[6]) {
-    int loop_index;
+    unsigned char values[MAX_DISPLAYABLE_CHARACTERS];
+    int display;
 
     // Return error code if driver not initialised
     if (!SevenSeg_isInitialised()) return SEVENSEG_ERRORNOINIT;
 
-    // Loop through each character in word
-    for (loop_index = 0; loop_index < 6; loop_index++) {
-        // Store hex value and
-        // Display character on the display starting from left
-        SevenSeg_displayCharacter(5 - loop_index, (char)word[loop_index]);
+    SevenSeg_encodeWord(word, values);
+    for (display = 0; display < MAX_DISPLAYABLE_CHARACTERS; display++) {
+        SevenSeg_write(display, values[display]);
     }
     return SEVENSEG_SUCCESS;
 }
@@ -189,24 +198,35 @@ signed int SevenSeg_displayDigit(unsigned int display, int digit) {
     return SEVENSEG_SUCCESS;
 }
 
-// Display a number using all 6 seven segment displays from left to right.
-// If the number is longer than 6 digits only the last 6 digits are displayed.
-signed int SevenSeg_displayNumber(int number) {
+// Get the segments of each display that show a number.
+// If the number is longer than 6 digits only the last 6 digits are shown.
+void SevenSeg_encodeNumber(int number, unsigned char values[MAX_DISPLAYABLE_CHARACTERS]) {
     // Initialise digits to all be white space characters
     int digits[MAX_DISPLAYABLE_CHARACTERS] = {whitespace_index, whitespace_index, whitespace_index, whitespace_index, whitespace_index, whitespace_index};
-    int num_digits = countNumDigits(number);
     int i;
 
-    // Return error code if driver not initialised
-    if (!SevenSeg_isInitialised()) return SEVENSEG_ERRORNOINIT;
-
     // int *digits = convertIntToArrayOfDigits(number);
     // Store the digits in the number in `digits`
     getDigitsInNumber(number, digits);
 
-    // Write every digit (or whitespace character) to the displays left-to-right
+    // Every digit (or whitespace character) for the displays left-to-right
     for (i = 0; i < MAX_DISPLAYABLE_CHARACTERS; i++) {
-        SevenSeg_displayDigit(i, *(digits + i));
+        values[i] = sevenseg_mappings[digits[i]];
+    }
+}
+
+// Display a number using all 6 seven segment displays from left to right.
+// If the number is longer than 6 digits only the last 6 digits are displayed.
+signed int SevenSeg_displayNumber(int number) {
+    unsigned char values[MAX_DISPLAYABLE_CHARACTERS];
+    int display;
+
+    // Return error code if driver not initialised
+    if (!SevenSeg_isInitialised()) return SEVENSEG_ERRORNOINIT;
+
+    SevenSeg_encodeNumber(number, values);
+    for (display = 0; display < MAX_DISPLAYABLE_CHARACTERS; display++) {
+        SevenSeg_write(display, values[display]);
     }
 
     return SEVENSEG_SUCCESS;
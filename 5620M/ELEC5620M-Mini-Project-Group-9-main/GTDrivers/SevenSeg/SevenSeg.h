@@ -62,6 +62,30 @@ signed int SevenSeg_write(unsigned int display, unsigned char value);
  */
 signed int SevenSeg_displayCharacter(unsigned int display, char character);
 
+/**
+ * SevenSeg_encodeCharacter
+ *
+ * Get the segments that show a character, without writing them.
+ *
+ * Inputs:
+ * 		character:		the character to show, unknown characters are blank
+ *
+ * Output: Returns the byte that shows the character
+ */
+unsigned char SevenSeg_encodeCharacter(char character);
+
+/**
+ * SevenSeg_encodeWord
+ *
+ * Get the segments SevenSeg_displayWord would write to each display,
+ * without writing them, so they can be buffered.
+ *
+ * Inputs:
+ * 		word:		The word to be shown (max length = 6)
+ * 		values:		Filled in with the byte for each display (0-5)
+ */
+void SevenSeg_encodeWord(char word[6], unsigned char values[MAX_DISPLAYABLE_CHARACTERS]);
+
 /**
  * SevenSeg_displayWord
  *
@@ -89,6 +113,18 @@ signed int SevenSeg_displayWord(char word[6]);
  */
 signed int SevenSeg_displayDigit(unsigned int display, int number);
 
+/**
+ * SevenSeg_encodeNumber
+ *
+ * Get the segments SevenSeg_displayNumber would write to each display,
+ * without writing them, so they can be buffered.
+ *
+ * Inputs:
+ * 		number:		The number to be shown.
+ * 		values:		Filled in with the byte for each display (0-5)
+ */
+void SevenSeg_encodeNumber(int number, unsigned char values[MAX_DISPLAYABLE_CHARACTERS]);
+
 /**
  * SevenSeg_displayNumber
  *
@@ -0,0 +1,78 @@
+/*
+ *  DE1-SoC Startup Sequencer
+ * ------------------------------
+ * Description:
+ * Runs the bring-up of several drivers at once. Each driver's start up
+ * is split into steps, and a step that has to wait (such as the LCD's
+ * 120ms wake up) says how long for. While one task waits, the steps of
+ * the others are run, so the waits overlap instead of adding up.
+ *
+ * Company: University of Leeds
+ * Author: Kaif Kutchwala, Emmanuel Leo, Varun Gonsalves
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 19/10/2026 | Creation of driver
+ * 19/10/2026 | Wait for each task on a Delay
+ */
+
+// Include External Libraries
+#include "Startup.h"  // Include header for the Startup Sequencer
+
+#include "Delay/Delay.h"                // Time the waits and the tasks
+#include "HPS_Watchdog/HPS_Watchdog.h"  // Reset the watchdog while waiting
+
+// Driver Functions
+
+signed int STARTUP_run(StartupTask tasks[], unsigned int count) {
+    unsigned long long start = Delay_nowUs();
+    unsigned long long before;
+    unsigned long long now;
+    unsigned int remaining = count;
+    unsigned int wait_us;
+    signed int status = STARTUP_SUCCESS;
+    StartupTask *task;
+    bool stepped;
+    unsigned int i;
+
+    for (i = 0; i < count; i++) {
+        tasks[i].status = STARTUP_PENDING;
+        Delay_cancel(&tasks[i].ready);  // Ready straight away
+        tasks[i].elapsed_us = 0;
+        tasks[i].busy_us = 0;
+    }
+
+    while (remaining) {
+#ifndef DELAY_HOST
+        ResetWDT();
+#endif
+        // Run a step of each task that is ready, in priority order
+        stepped = false;
+        for (i = 0; i < count; i++) {
+            task = &tasks[i];
+            if (task->status != STARTUP_PENDING) continue;
+            if (!Delay_isDone(&task->ready)) continue;
+
+            before = Delay_nowUs();
+            wait_us = 0;
+            task->status = task->step(&wait_us, task->context);
+            now = Delay_nowUs();
+            task->busy_us += (unsigned int)(now - before);
+            stepped = true;
+
+            if (task->status == STARTUP_PENDING) {
+                // With no room for the delay, wait for it here instead
+                if (Delay_after(&task->ready, wait_us, 0, 0) != DELAY_SUCCESS) Delay_wait(wait_us);
+            } else {
+                task->elapsed_us = (unsigned int)(now - start);
+                remaining--;
+                if ((task->status != STARTUP_SUCCESS) && (status == STARTUP_SUCCESS)) status = task->status;
+            }
+        }
+        // Every task is waiting, so wait for the first to be ready
+        if (!stepped) Delay_wait(Delay_nextUs());
+    }
+    return status;
+}
@@ -0,0 +1,80 @@
+/*
+ *  DE1-SoC Startup Sequencer
+ * ------------------------------
+ * Description:
+ * Runs the bring-up of several drivers at once. Each driver's start up
+ * is split into steps, and a step that has to wait (such as the LCD's
+ * 120ms wake up) says how long for. While one task waits, the steps of
+ * the others are run, so the waits overlap instead of adding up.
+ *
+ * Tasks are run in the order they are listed whenever they are ready,
+ * so list the ones with the tightest waits first. A step runs to the
+ * end once started, so long steps delay the others.
+ *
+ * Each wait is a delay on the Delay driver's clock, so with DELAY_HOST
+ * defined the sequence runs in virtual time, with steps that move it on
+ * by Delay_advance standing in for the drivers.
+ *
+ * The time each task took is recorded in its StartupTask.
+ *
+ * Company: University of Leeds
+ * Author: Kaif Kutchwala, Emmanuel Leo, Varun Gonsalves
+ *
+ * Change Log:
+ *
+ * Date       | Changes
+ * -----------+----------------------------------
+ * 19/10/2026 | Creation of driver
+ * 19/10/2026 | Wait for each task on a Delay
+ */
+
+#ifndef STARTUP_
+#define STARTUP_
+
+// Define Status codes
+#define STARTUP_SUCCESS 0
+#define STARTUP_PENDING 1  // Task has more steps to run
+
+#include "Delay/Delay.h"
+
+/*
+ * Function that runs the next step of a task.
+ *
+ * Returns STARTUP_PENDING with wait_us set to how long to wait before the
+ * next step, STARTUP_SUCCESS once the task is finished, or any other value
+ * if it failed. wait_us is 0 on entry.
+ */
+typedef signed int (*StartupStep)(unsigned int *wait_us, void *context);
+
+/*
+ * This struct represents one task for STARTUP_run. Only the name, step and
+ * context need to be set, the rest is filled in by STARTUP_run. It must
+ * start zeroed, as globals are, as it holds a DelayEvent.
+ */
+typedef struct {
+    const char *name;               // Name of the task, to identify it when debugging
+    StartupStep step;               // Function that runs each step
+    void *context;                  // Passed to step
+    signed int status;              // STARTUP_PENDING while running, then the last status from step
+    DelayEvent ready;               // Done once the next step can run
+    unsigned int elapsed_us;        // Time from the start of STARTUP_run until the task finished
+    unsigned int busy_us;           // Time spent running the task's steps
+} StartupTask;
+
+/*
+ *  STARTUP_run
+ *
+ *  Runs every task until they have all finished, resetting the watchdog
+ *  while waiting. Tasks that fail do not stop the others. Times are on
+ *  the delay clock, see Delay_nowUs.
+ *
+ *  Inputs:
+ *              tasks:          Tasks to run, in priority order
+ *              count:          Number of tasks
+ *
+ *  Output:
+ *              STARTUP_SUCCESS, or the status of the first task to fail
+ */
+signed int STARTUP_run(StartupTask tasks[], unsigned int count);
+
+#endif
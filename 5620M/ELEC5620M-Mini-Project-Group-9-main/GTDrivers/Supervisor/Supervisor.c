@@ -0,0 +1,46 @@
+/**
+ * Supervisor.c
+ *
+ * Watchdog supervisor, resetting the watchdog only while the main loop
+ * is still running
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "Supervisor.h"
+
+#include "HPS_Watchdog/HPS_Watchdog.h"
+#include "Timer/Timer.h"
+
+// Kicks counted by Supervisor_kick, and the count at the last check
+unsigned int supervisor_kicks = 0;
+unsigned int supervisor_last_kicks = 0;
+
+// Periodic check
+TimerEvent supervisor_timer;
+
+// Helper Functions
+
+// Resets the watchdog if the loop has been kicked since the last check
+void supervisor_check(void *context) {
+    (void)context;
+    if (supervisor_kicks == supervisor_last_kicks) return;
+    supervisor_last_kicks = supervisor_kicks;
+    ResetWDT();
+}
+
+// Driver Functions
+
+signed int Supervisor_initialise(void) {
+    supervisor_last_kicks = supervisor_kicks;
+    if (Timer_addPeriodic(&supervisor_timer, SUPERVISOR_CHECK_MS * 1000, &supervisor_check, 0) != TIMER_SUCCESS) {
+        return SUPERVISOR_ERRORNOINIT;
+    }
+    return SUPERVISOR_SUCCESS;
+}
+
+void Supervisor_kick(void) {
+    supervisor_kicks++;
+}
@@ -0,0 +1,52 @@
+/**
+ * Supervisor.h
+ *
+ * Watchdog supervisor for the main loop. The loop kicks the supervisor
+ * once a pass, and a periodic software timer resets the hardware
+ * watchdog only if the loop has been kicked since the last check. The
+ * board is then reset if the loop hangs, or if it keeps running but no
+ * longer services the software timers, rather than the hang being
+ * hidden by watchdog resets from inside other loops.
+ *
+ * This is a single kick from the main loop. Every part of the game runs
+ * in the same loop, so no part can stop while the rest carry on, and
+ * the check itself runs from Timer_service in that loop. A hang stops
+ * the check too, so it can't be logged before the watchdog resets the
+ * board. That would need the check to run from an interrupt, which this
+ * tree has no handling for.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef SUPERVISOR_H_
+#define SUPERVISOR_H_
+
+#define SUPERVISOR_SUCCESS 0
+#define SUPERVISOR_ERRORNOINIT 1
+
+// Time between checks. This must be well inside the hardware watchdog
+// timeout, which is over 2 seconds.
+#define SUPERVISOR_CHECK_MS 250
+
+/**
+ * Supervisor_initialise
+ *
+ * Starts checking the main loop. Until this is called the watchdog must
+ * be reset by the caller. The timer must have been initialised.
+ *
+ * Outputs:
+ * 		SUPERVISOR_SUCCESS or SUPERVISOR_ERRORNOINIT if the timer could not be started
+ **/
+signed int Supervisor_initialise(void);
+
+/**
+ * Supervisor_kick
+ *
+ * Marks the main loop as running. This only counts the kick in memory,
+ * so it is cheap enough to call every pass.
+ **/
+void Supervisor_kick(void);
+
+#endif /* SUPERVISOR_H_ */
@@ -5,7 +5,7 @@
  *
  * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
  *
- * Date: 06/05/2023
+ * Date: 19/10/2026
  */
 
 #include "Timer.h"
@@ -14,9 +14,24 @@
 
 #include "HPS_Watchdog/HPS_Watchdog.h"
 
+#ifdef TIMER_HOST
+// On a host the timer registers are kept in memory. The global timer
+// never counts, so the time only moves on with Timer_setFrameTime and
+// Timer_advanceHardware.
+unsigned int timer_host_registers[4];
+unsigned int global_timer_host_registers[6];
+#endif
+
 // Driver Base Addresses
 volatile unsigned int *timer_base_ptr = 0x0;  // 0xFFFEC600
 
+// A9 global timer, a 64-bit up counter clocked at the same rate as the private timer
+#ifdef TIMER_HOST
+volatile unsigned int *global_timer_ptr = global_timer_host_registers;
+#else
+volatile unsigned int *global_timer_ptr = (unsigned int *)0xFFFEC200;
+#endif
+
 // Driver Initialised
 bool timer_initialised = false;
 
@@ -26,17 +41,219 @@ bool timer_initialised = false;
 #define TIMER_CONTROL (0x08 / sizeof(unsigned int))
 #define TIMER_INTERRUPT (0x0C / sizeof(unsigned int))
 
-// Clock frequency at 1/4 of the 900MHz Clock
-volatile float timer_frequency = 225000000.0;
+// Global Timer Register Offsets
+#define GLOBAL_TIMER_LOW (0x00 / sizeof(unsigned int))
+#define GLOBAL_TIMER_HIGH (0x04 / sizeof(unsigned int))
+#define GLOBAL_TIMER_CONTROL (0x08 / sizeof(unsigned int))
+#define GLOBAL_TIMER_INTERRUPT (0x0C / sizeof(unsigned int))
+#define GLOBAL_TIMER_COMPARE_LOW (0x10 / sizeof(unsigned int))
+#define GLOBAL_TIMER_COMPARE_HIGH (0x14 / sizeof(unsigned int))
+
+// Global Timer Control Bits
+#define GLOBAL_TIMER_ENABLE 0x1
+#define GLOBAL_TIMER_COMPARE_ENABLE 0x2
+
+// Reciprocal of a divisor, so a tick count can be divided with multiplies
+typedef struct {
+    unsigned int divisor;
+    unsigned int multiplier;  // floor(2^(32 + shift) / divisor)
+    unsigned int shift;       // Largest shift that keeps multiplier within 32 bits
+} TimerReciprocal;
+
+// Ticks per microsecond and per millisecond
+TimerReciprocal ticks_per_us;
+TimerReciprocal ticks_per_ms;
+
+// Software timer wheel. Level 0 has a slot for each of the next 64 wheel
+// ticks, and each level above covers 64 times the time of the one below.
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS 4
+
+TimerEvent *timer_wheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];  // Timers in each slot
+unsigned long long timer_wheel_used[TIMER_WHEEL_LEVELS];         // Bit set for each slot with timers in
+unsigned long long timer_wheel_tick = 0;                         // Last wheel tick processed
+unsigned long long timer_wheel_next = 0;                         // Nothing to do before this wheel tick
+bool timer_wheel_due = false;                                    // timer_wheel_next was already reached when it was set
+
+// Time held by Timer_setFrameTime, returned instead of the global timer
+bool timer_frame_held = false;
+unsigned long long timer_frame_ticks = 0;
+
+// Helper Methods
+
+// Working out the multiplier and shift for dividing by divisor
+void timer_setReciprocal(TimerReciprocal *reciprocal, unsigned int divisor) {
+    unsigned int shift = 0;
+    // 2^(32 + shift) / divisor fits in 32 bits while 2^shift < divisor
+    while ((2u << shift) < divisor) shift++;
+    reciprocal->divisor = divisor;
+    reciprocal->shift = shift;
+    reciprocal->multiplier = (unsigned int)((1ULL << (32 + shift)) / divisor);
+}
+
+// Estimating value / divisor. The multiplier is rounded down, so the
+// result can be low by up to value / 2^(32 + shift) + 1.
+unsigned long long timer_estimateQuotient(unsigned long long value, const TimerReciprocal *reciprocal) {
+    // (value * multiplier) >> 32 from two 32x32 bit multiplies
+    unsigned long long high = (value >> 32) * reciprocal->multiplier;
+    unsigned long long low = ((value & 0xFFFFFFFF) * reciprocal->multiplier) >> 32;
+    return (high + low) >> reciprocal->shift;
+}
+
+// Dividing a tick count exactly, without a 64-bit divide
+unsigned long long timer_divide(unsigned long long value, const TimerReciprocal *reciprocal) {
+    unsigned long long quotient = timer_estimateQuotient(value, reciprocal);
+    unsigned long long remainder = value - quotient * reciprocal->divisor;
+    // A second estimate from the small remainder leaves it at most one short
+    quotient += timer_estimateQuotient(remainder, reciprocal);
+    remainder = value - quotient * reciprocal->divisor;
+    while (remainder >= reciprocal->divisor) {
+        remainder -= reciprocal->divisor;
+        quotient++;
+    }
+    return quotient;
+}
+
+// Finding the lowest set bit of a non-zero value
+unsigned int timer_lowestBit(unsigned long long value) {
+    unsigned int bit = 0;
+    unsigned int width;
+    for (width = 32; width; width >>= 1) {
+        if (!(value & ((1ULL << width) - 1))) {
+            value >>= width;
+            bit += width;
+        }
+    }
+    return bit;
+}
+
+// Setting the global timer comparator to the start of a wheel tick, which
+// sets its interrupt flag once the time is reached
+void timer_setCompare(unsigned long long wheel_tick) {
+    unsigned long long compare = (wheel_tick << TIMER_WHEEL_TICK_SHIFT) * (TIMER_TICKS_PER_SECOND / 1000000);
+    // The comparator is disabled while it is written so a half written value can't match
+    global_timer_ptr[GLOBAL_TIMER_CONTROL] = GLOBAL_TIMER_ENABLE;
+    global_timer_ptr[GLOBAL_TIMER_COMPARE_LOW] = (unsigned int)compare;
+    global_timer_ptr[GLOBAL_TIMER_COMPARE_HIGH] = (unsigned int)(compare >> 32);
+#ifdef TIMER_HOST
+    // Writing 1 clears the flag on the board, which memory can't do
+    global_timer_ptr[GLOBAL_TIMER_INTERRUPT] = 0;
+#else
+    global_timer_ptr[GLOBAL_TIMER_INTERRUPT] = 0x1;
+#endif
+    global_timer_ptr[GLOBAL_TIMER_CONTROL] = GLOBAL_TIMER_ENABLE | GLOBAL_TIMER_COMPARE_ENABLE;
+    // The flag is only set when the count passes the comparator, so remember if it already has
+    timer_wheel_due = (Timer_nowTicks() >= compare);
+}
+
+// Adding an active timer to the wheel slot for its deadline. Timers already
+// due go in the slot for earliest, which is the tick being processed while
+// cascading, or the next tick otherwise.
+void timer_wheelInsert(TimerEvent *event, unsigned long long earliest) {
+    // First wheel tick that starts at or after the deadline
+    unsigned long long expiry = (event->deadline_us + (1 << TIMER_WHEEL_TICK_SHIFT) - 1) >> TIMER_WHEEL_TICK_SHIFT;
+    unsigned long long delta;
+    unsigned int level = 0;
+
+    if (expiry < earliest) expiry = earliest;
+    delta = expiry - timer_wheel_tick;
+    // Find the lowest level that reaches the expiry. Timers past the top
+    // level wait in its furthest slot, and are placed again when it is reached.
+    while ((level < TIMER_WHEEL_LEVELS - 1) && (delta >= (1ULL << (TIMER_WHEEL_BITS * (level + 1))))) level++;
+    if (delta >= (1ULL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))) {
+        expiry = timer_wheel_tick + (1ULL << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1;
+    }
+
+    event->level = level;
+    event->slot = (expiry >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+    event->prev = 0;
+    event->next = timer_wheel[level][event->slot];
+    if (event->next) event->next->prev = event;
+    timer_wheel[level][event->slot] = event;
+    timer_wheel_used[level] |= 1ULL << event->slot;
+
+    // Make sure the wheel moves in time for a level 0 timer
+    if ((level == 0) && (expiry < timer_wheel_next)) {
+        timer_wheel_next = expiry;
+        timer_setCompare(timer_wheel_next);
+    }
+}
+
+// Taking a timer out of its wheel slot
+void timer_wheelRemove(TimerEvent *event) {
+    if (event->prev) {
+        event->prev->next = event->next;
+    } else {
+        timer_wheel[event->level][event->slot] = event->next;
+        if (!event->next) timer_wheel_used[event->level] &= ~(1ULL << event->slot);
+    }
+    if (event->next) event->next->prev = event->prev;
+}
+
+// Moving every timer in a slot of a higher level down to the level below
+void timer_wheelCascade(unsigned int level) {
+    unsigned int slot = (timer_wheel_tick >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+    TimerEvent *event;
+    while ((event = timer_wheel[level][slot])) {
+        timer_wheelRemove(event);
+        timer_wheelInsert(event, timer_wheel_tick);
+    }
+}
+
+// Finding the next wheel tick with work to do: a level 0 slot with timers
+// in, or the end of the 64 ticks covered by level 0 when higher levels cascade
+unsigned long long timer_wheelNext(void) {
+    unsigned int index = timer_wheel_tick & TIMER_WHEEL_MASK;
+    unsigned long long later;
+    if (index == TIMER_WHEEL_MASK) return timer_wheel_tick + 1;
+    later = timer_wheel_used[0] & (~0ULL << (index + 1));
+    if (later) return (timer_wheel_tick & ~(unsigned long long)TIMER_WHEEL_MASK) + timer_lowestBit(later);
+    return (timer_wheel_tick | TIMER_WHEEL_MASK) + 1;
+}
+
+// Starting a software timer
+unsigned int timer_start(TimerEvent *event, unsigned int delay_us, unsigned int period_us, TimerCallback callback, void *context) {
+    // check if timer has initialised
+    if (!Timer_isInitialised()) return TIMER_ERRORNOINIT;
+    if (!callback) return TIMER_ERRORINVALID;
+    Timer_cancel(event);
+    event->deadline_us = Timer_nowUs() + delay_us;
+    event->period_us = period_us;
+    event->callback = callback;
+    event->context = context;
+    event->active = true;
+    timer_wheelInsert(event, timer_wheel_tick + 1);
+    return TIMER_SUCCESS;
+}
+
+// Driver Functions
 
 // Function to initialise the Timer
 signed int Timer_initialise(unsigned int base_address) {
     // Initialise base address pointers
+#ifdef TIMER_HOST
+    timer_base_ptr = timer_host_registers;
+    (void)base_address;
+#else
     timer_base_ptr = (unsigned int *)base_address;
+#endif
     // Ensure timer initialises to disabled
     timer_base_ptr[TIMER_CONTROL] = 0;
+    // Start the global timer with no prescaler, unless it is already counting
+    if (!(global_timer_ptr[GLOBAL_TIMER_CONTROL] & GLOBAL_TIMER_ENABLE)) {
+        global_timer_ptr[GLOBAL_TIMER_CONTROL] = GLOBAL_TIMER_ENABLE;
+    }
+    // Work out the conversions once, so reading the time needs no divide
+    timer_setReciprocal(&ticks_per_us, TIMER_TICKS_PER_SECOND / 1000000);
+    timer_setReciprocal(&ticks_per_ms, TIMER_TICKS_PER_SECOND / 1000);
     // Timer now initialised
     timer_initialised = true;
+    // Start the timer wheel now, with no timers
+    timer_wheel_tick = Timer_nowUs() >> TIMER_WHEEL_TICK_SHIFT;
+    timer_wheel_next = timer_wheel_tick + 1;
+    timer_setCompare(timer_wheel_next);
 
     return TIMER_SUCCESS;
 }
@@ -169,47 +386,172 @@ unsigned int Timer_resetInterrupt(void) {
 
 // Set a Time period in ms
 unsigned int Timer_setPeriod(unsigned int time) {
-	float prescalar_value;
-	float load_value;
+    // Longer periods would overflow the microsecond count
+    if (time > 0xFFFFFFFF / 1000) return TIMER_ERRORINVALID;
+    return Timer_setPeriodUs(time * 1000, 0);
+};
+
+// Set a Time period in us
+unsigned int Timer_setPeriodUs(unsigned int period_us, TimerPeriod *achieved) {
+    unsigned long long target = (unsigned long long)period_us * (TIMER_TICKS_PER_SECOND / 1000000);
+    unsigned long long count;
+    unsigned long long error;
+    unsigned long long best_error = ~0ULL;
+    unsigned long long best_count = 0;
+    unsigned int best_prescalar = 0;
+    unsigned int prescalar;
     // check if timer has initialised
     if (!Timer_isInitialised()) return TIMER_ERRORNOINIT;
-    prescalar_value = ((time / 1000) / 18);
-    // write the prescalar value to the register
-    // Timer_setPrescalar(preScalarValue);
-    Timer_setControl(prescalar_value, 0, 1, 1);
-    // this equation will get the load value to put into the load register
-    // Using the prescalar value, the timer frequency and the timer period a load value
-    // can be calculated
-    load_value = (time / (1000 * (prescalar_value + 1))) * (timer_frequency);
-    // unsigned int loadvalue = midvalue/(preScalarValue + 1);
-    //  Set the load value into the timer
-    Timer_setLoad(load_value);
+    // The timer counts (prescalar + 1) * (load + 1) ticks each period. Find the
+    // closest, using the smallest prescalar for the finest resolution.
+    for (prescalar = 0; (prescalar <= 0xFF) && best_error; prescalar++) {
+        // Nearest number of counts at this prescalar
+        count = (target + (prescalar + 1) / 2) / (prescalar + 1);
+        if (count > 0x100000000ULL) continue;  // Too long for the load register
+        if (count == 0) break;                   // Too short, and larger prescalars are worse
+        error = (count * (prescalar + 1) > target) ? count * (prescalar + 1) - target : target - count * (prescalar + 1);
+        if (error < best_error) {
+            best_error = error;
+            best_count = count;
+            best_prescalar = prescalar;
+        }
+    }
+    if (!best_count) return TIMER_ERRORINVALID;
+    // Load the timer, and set the prescalar, automatic reload and enable with the ISR disabled
+    Timer_setLoad((unsigned int)(best_count - 1));
+    Timer_setControl(best_prescalar, 0, 1, 1);
+    // Report what was achieved, rounded to the nearest ns and ps
+    if (achieved) {
+        achieved->prescalar = best_prescalar;
+        achieved->load = (unsigned int)(best_count - 1);
+        achieved->period_ticks = best_count * (best_prescalar + 1);
+        achieved->period_ns = (achieved->period_ticks * 1000 + TIMER_TICKS_PER_SECOND / 2000000) / (TIMER_TICKS_PER_SECOND / 1000000);
+        achieved->resolution_ps = ((best_prescalar + 1) * 1000000 + TIMER_TICKS_PER_SECOND / 2000000) / (TIMER_TICKS_PER_SECOND / 1000000);
+    }
 
     return TIMER_SUCCESS;
-};
+}
 
-// Getting the current timer value in ms
-unsigned int Timer_getValueMS(void) {
-	unsigned int timer_control_value;
-	unsigned int mask;
-	float prescalar_value;
-	float timer_value;
-	float time_ms;
+// Reading the global timer
+unsigned long long timer_hardwareTicks(void) {
+    unsigned int high;
+    unsigned int low;
     // check if timer has initialised
-    if (!Timer_isInitialised()) return TIMER_ERRORNOINIT;
-    // get the prescalar value
-    timer_control_value = timer_base_ptr[TIMER_CONTROL];
-    // 0000,0000,0000,0000,1111,1111,0000,0000
-    mask = 0x0000FF00;
-    // Clears all the values except for the prescalar bits
-    timer_control_value &= mask;
-    // Shift to obtain the prescalar value
-    // int prescalar_value = (timer_control_value >> 8);
-    prescalar_value = (timer_control_value >> 8);
-    // get the value from the register
-    timer_value = timer_base_ptr[TIMER_VALUE];
-    // convert the value to ms
-    time_ms = (timer_value / timer_frequency) * 1000 * (prescalar_value + 1);
-
-    return time_ms;
+    if (!Timer_isInitialised()) return 0;
+    // Read the high word again after the low word, in case the low word carried into it
+    do {
+        high = global_timer_ptr[GLOBAL_TIMER_HIGH];
+        low = global_timer_ptr[GLOBAL_TIMER_LOW];
+    } while (global_timer_ptr[GLOBAL_TIMER_HIGH] != high);
+    return ((unsigned long long)high << 32) | low;
+}
+
+// Getting the current time, held at the frame time if one is set
+unsigned long long Timer_nowTicks(void) {
+    if (timer_frame_held && Timer_isInitialised()) return timer_frame_ticks;
+    return timer_hardwareTicks();
+}
+
+// Getting the current global timer value in us
+unsigned long long Timer_nowUs(void) {
+    return timer_divide(Timer_nowTicks(), &ticks_per_us);
+}
+
+// Getting the current global timer value in ms
+unsigned long long Timer_nowMs(void) {
+    return timer_divide(Timer_nowTicks(), &ticks_per_ms);
+}
+
+// Getting the global timer value in us, ignoring any frame time
+unsigned long long Timer_hardwareUs(void) {
+    return timer_divide(timer_hardwareTicks(), &ticks_per_us);
+}
+
+// Holding the time returned by Timer_nowTicks
+void Timer_setFrameTime(unsigned long long time_us) {
+    timer_frame_ticks = time_us * (TIMER_TICKS_PER_SECOND / 1000000);
+    timer_frame_held = true;
+}
+
+#ifdef TIMER_HOST
+// Moving the global timer kept in memory on
+void Timer_advanceHardware(unsigned int us) {
+    unsigned long long ticks = ((unsigned long long)global_timer_ptr[GLOBAL_TIMER_HIGH] << 32) |
+                               global_timer_ptr[GLOBAL_TIMER_LOW];
+    Timer_setHardwareTicks(ticks + (unsigned long long)us * (TIMER_TICKS_PER_SECOND / 1000000));
+}
+
+// Setting the global timer kept in memory
+void Timer_setHardwareTicks(unsigned long long ticks) {
+    unsigned long long last = ((unsigned long long)global_timer_ptr[GLOBAL_TIMER_HIGH] << 32) |
+                              global_timer_ptr[GLOBAL_TIMER_LOW];
+    unsigned long long compare = ((unsigned long long)global_timer_ptr[GLOBAL_TIMER_COMPARE_HIGH] << 32) |
+                                 global_timer_ptr[GLOBAL_TIMER_COMPARE_LOW];
+    // The comparator sets the interrupt flag as the count passes it
+    if ((global_timer_ptr[GLOBAL_TIMER_CONTROL] & GLOBAL_TIMER_COMPARE_ENABLE) && (last < compare) && (ticks >= compare)) {
+        global_timer_ptr[GLOBAL_TIMER_INTERRUPT] = 0x1;
+    }
+    global_timer_ptr[GLOBAL_TIMER_LOW] = (unsigned int)ticks;
+    global_timer_ptr[GLOBAL_TIMER_HIGH] = (unsigned int)(ticks >> 32);
+}
+#endif
+
+// Starting a one shot software timer
+unsigned int Timer_addOneShot(TimerEvent *event, unsigned int delay_us, TimerCallback callback, void *context) {
+    return timer_start(event, delay_us, 0, callback, context);
+}
+
+// Starting a periodic software timer
+unsigned int Timer_addPeriodic(TimerEvent *event, unsigned int period_us, TimerCallback callback, void *context) {
+    if (period_us == 0) return TIMER_ERRORINVALID;
+    return timer_start(event, period_us, period_us, callback, context);
+}
+
+// Stopping a software timer
+void Timer_cancel(TimerEvent *event) {
+    if (!event->active) return;
+    timer_wheelRemove(event);
+    event->active = false;
+}
+
+// Running the software timers that have expired
+void Timer_service(void) {
+    unsigned long long now_us;
+    unsigned long long now_tick;
+    unsigned long long missed;
+    unsigned int level;
+    TimerEvent *event;
+    // check if timer has initialised
+    if (!Timer_isInitialised()) return;
+    // Nothing to do until the comparator has been reached. The comparator
+    // follows the global timer, so while the time is held check the wheel.
+    if (!timer_wheel_due && !timer_frame_held && !(global_timer_ptr[GLOBAL_TIMER_INTERRUPT] & 0x1)) return;
+    now_us = Timer_nowUs();
+    now_tick = now_us >> TIMER_WHEEL_TICK_SHIFT;
+
+    // Move the wheel on to each tick with work to do up to now
+    while (timer_wheel_next <= now_tick) {
+        timer_wheel_tick = timer_wheel_next;
+        // At the end of a turn of a level, bring the next slot of the level above down
+        for (level = 1; (level < TIMER_WHEEL_LEVELS) && !(timer_wheel_tick & ((1ULL << (TIMER_WHEEL_BITS * level)) - 1)); level++);
+        while (--level) timer_wheelCascade(level);
+        // Run the timers due on this tick
+        while ((event = timer_wheel[0][timer_wheel_tick & TIMER_WHEEL_MASK])) {
+            timer_wheelRemove(event);
+            if (event->period_us) {
+                // Next deadline, skipping any periods already missed
+                event->deadline_us += event->period_us;
+                if (event->deadline_us <= now_us) {
+                    missed = (now_us - event->deadline_us) / event->period_us + 1;
+                    event->deadline_us += missed * event->period_us;
+                }
+                timer_wheelInsert(event, timer_wheel_tick + 1);
+            } else {
+                event->active = false;
+            }
+            event->callback(event->context);
+        }
+        timer_wheel_next = timer_wheelNext();
+    }
+    timer_setCompare(timer_wheel_next);
 }
@@ -3,16 +3,67 @@
  *
  * Timer functions are available to call from this file
  *
+ * Define TIMER_HOST to build for a host computer. The registers are then
+ * kept in memory and the time only moves on with Timer_setFrameTime and
+ * Timer_advanceHardware, so software timers run on virtual time. The
+ * global timer comparator sets its interrupt flag as on the board.
+ *
  * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
  *
- * Date: 06/05/2023
+ * Date: 19/10/2026
  */
 
+#ifndef TIMER_H_
+#define TIMER_H_
+
 #include <stdbool.h>
 
 #define TIMER_SUCCESS 0
 #define TIMER_ERRORNOINIT 1
 
+#define TIMER_ERRORINVALID 2
+
+// Ticks per second of the private and global timers, 1/4 of the 900MHz Clock
+#define TIMER_TICKS_PER_SECOND 225000000
+
+// Software timers are checked at this resolution, 1024us
+#define TIMER_WHEEL_TICK_SHIFT 10
+
+/**
+ * TimerPeriod
+ *
+ * The configuration chosen by Timer_setPeriodUs and the period it gives.
+ **/
+typedef struct {
+    unsigned int prescalar;            // Prescalar register value
+    unsigned int load;                 // Load register value
+    unsigned long long period_ticks;   // Period in ticks of TIMER_TICKS_PER_SECOND
+    unsigned long long period_ns;      // Period in nanoseconds, rounded
+    unsigned int resolution_ps;        // Time of one count in picoseconds, rounded
+} TimerPeriod;
+
+// Function called when a software timer expires
+typedef void (*TimerCallback)(void *context);
+
+/**
+ * TimerEvent
+ *
+ * A software timer. The struct belongs to the caller and must stay in
+ * memory while the timer is active. The fields are used by the driver.
+ **/
+typedef struct TimerEvent TimerEvent;
+struct TimerEvent {
+    unsigned long long deadline_us;  // Time the timer next expires
+    unsigned int period_us;          // Time between expiries, 0 for a one shot timer
+    TimerCallback callback;          // Function to call when it expires
+    void *context;                   // Passed to the callback
+    bool active;                     // True while the timer is waiting to expire
+    unsigned char level;             // Timing wheel position
+    unsigned char slot;
+    TimerEvent *next;                // Other timers in the same wheel slot
+    TimerEvent *prev;
+};
+
 /**
  * Timer_initialise
  *
@@ -146,24 +197,181 @@ unsigned int Timer_resetInterrupt(void);
  * Timer_setPeriod
  *
  * Setting the Timer period. The input for this will be in milliseconds.
- * This will set the prescalar, isr, automatic reload and the enable automatically from the input
+ * This is Timer_setPeriodUs for a whole number of milliseconds.
  *
  * Input:
- * 		time:	input value for the time in ms
+ * 		time:	input value for the time in ms, up to 4294967
  *
  * Outputs:
  * 		TIMER_SUCCESS:	flag check to make sure the function worked
+ * 		TIMER_ERRORINVALID: if the period is 0 or too long
  **/
 unsigned int Timer_setPeriod(unsigned int time);
 
 /**
- * Timer_getValueMS
+ * Timer_setPeriodUs
+ *
+ * Setting the Timer period in microseconds, using integer maths only.
+ * Every prescalar is tried and the one giving the period closest to
+ * the one asked for is used, taking the smallest (finest resolution)
+ * if several are as close. As a microsecond is a whole number of ticks
+ * every period is exact, with the finest resolution up to about 19
+ * seconds. The timer is started with automatic reload and the ISR disabled.
+ *
+ * Input:
+ * 		period_us:	period in microseconds
+ * 		achieved:	filled in with the period and resolution achieved, or 0
+ *
+ * Outputs:
+ * 		TIMER_SUCCESS, TIMER_ERRORNOINIT, or TIMER_ERRORINVALID if the
+ * 		period is 0
+ **/
+unsigned int Timer_setPeriodUs(unsigned int period_us, TimerPeriod *achieved);
+
+/**
+ * Timer_nowTicks
+ *
+ * Getting the time since the global timer started, in ticks of
+ * TIMER_TICKS_PER_SECOND. The global timer is a 64-bit counter that
+ * counts up and never wraps, so the time between two readings is
+ * always (later - earlier). Timer_initialise starts it.
+ *
+ * Outputs:
+ * 		ticks:	current time in ticks, 0 if not initialised
+ **/
+unsigned long long Timer_nowTicks(void);
+
+/**
+ * Timer_nowUs
+ *
+ * Getting the time since the global timer started, in microseconds.
+ *
+ * Outputs:
+ * 		time_us:	current time in microseconds, 0 if not initialised
+ **/
+unsigned long long Timer_nowUs(void);
+
+/**
+ * Timer_nowMs
+ *
+ * Getting the time since the global timer started, in milliseconds.
+ *
+ * Outputs:
+ * 		time_ms:	current time in milliseconds, 0 if not initialised
+ **/
+unsigned long long Timer_nowMs(void);
+
+/**
+ * Timer_hardwareUs
+ *
+ * Getting the time since the global timer started, in microseconds,
+ * even while a frame time is held. Use this to measure how long code
+ * takes.
+ *
+ * Outputs:
+ * 		time_us:	current time in microseconds, 0 if not initialised
+ **/
+unsigned long long Timer_hardwareUs(void);
+
+/**
+ * Timer_setFrameTime
+ *
+ * Holding the time returned by Timer_nowTicks, Timer_nowUs and
+ * Timer_nowMs, and used by the software timers, at time_us until it
+ * is next set. Once set it is held for good. Setting it once at the start of each frame
+ * makes the whole frame see the same time, so a recorded session
+ * replays the same whatever each frame costs. The time must not go
+ * backwards.
+ *
+ * Inputs:
+ * 		time_us:	time to hold in microseconds
+ **/
+void Timer_setFrameTime(unsigned long long time_us);
+
+#ifdef TIMER_HOST
+/**
+ * Timer_advanceHardware
+ *
+ * Moves on the global timer kept in memory by a host build, as time
+ * passing on the board would. Timer_hardwareUs moves on with it, as
+ * do Timer_nowUs and Timer_nowMs until a frame time is held.
+ *
+ * Inputs:
+ * 		us:	time to move on in microseconds
+ **/
+void Timer_advanceHardware(unsigned int us);
+
+/**
+ * Timer_setHardwareTicks
+ *
+ * Sets the global timer kept in memory by a host build, so the time
+ * can be checked anywhere in the 64-bit range of the counter. Moving
+ * it past the comparator sets the interrupt flag.
+ *
+ * Inputs:
+ * 		ticks:	count of the global timer in ticks of TIMER_TICKS_PER_SECOND
+ **/
+void Timer_setHardwareTicks(unsigned long long ticks);
+#endif
+
+/**
+ * Timer_addOneShot
+ *
+ * Starting a software timer that calls callback once, delay_us from now.
+ * If the timer is already active it is restarted.
+ *
+ * Inputs:
+ * 		event:		timer to start
+ * 		delay_us:	time until it expires in microseconds
+ * 		callback:	function to call from Timer_service when it expires
+ * 		context:	value passed to the callback
  *
- * Getting the current timer value but in milliseconds.
- * This can be used for multiple clock and be used in ms. However when
- * using mutiple clock make sure to set the update period as a multiple of the Period
+ * Outputs:
+ * 		TIMER_SUCCESS, TIMER_ERRORNOINIT or TIMER_ERRORINVALID if there is no callback
+ **/
+unsigned int Timer_addOneShot(TimerEvent *event, unsigned int delay_us, TimerCallback callback, void *context);
+
+/**
+ * Timer_addPeriodic
+ *
+ * Starting a software timer that calls callback every period_us. Each
+ * expiry is scheduled from the last deadline rather than from when the
+ * callback ran, so the rate is exact. Periods missed because
+ * Timer_service was not called are skipped rather than run late.
+ *
+ * Inputs:
+ * 		event:		timer to start
+ * 		period_us:	time between calls in microseconds
+ * 		callback:	function to call from Timer_service when it expires
+ * 		context:	value passed to the callback
  *
  * Outputs:
- * 		time_ms:	current time from the pointer in milliseconds
+ * 		TIMER_SUCCESS, TIMER_ERRORNOINIT or TIMER_ERRORINVALID if there is no
+ * 		callback or the period is 0
  **/
-unsigned int Timer_getValueMS(void);
+unsigned int Timer_addPeriodic(TimerEvent *event, unsigned int period_us, TimerCallback callback, void *context);
+
+/**
+ * Timer_cancel
+ *
+ * Stopping a software timer. Does nothing if it is not active. A timer
+ * can cancel itself or others from its callback.
+ *
+ * Inputs:
+ * 		event:		timer to stop
+ **/
+void Timer_cancel(TimerEvent *event);
+
+/**
+ * Timer_service
+ *
+ * Calling the callbacks of software timers that have expired. Call this
+ * regularly from the main loop. The timers are kept in a hierarchical
+ * timing wheel and the global timer comparator is set to the next time
+ * the wheel needs to move, so a call with nothing due only reads one
+ * register, and otherwise the cost is set by the timers that expire
+ * rather than the number of timers.
+ **/
+void Timer_service(void);
+
+#endif /* TIMER_H_ */
@@ -0,0 +1,89 @@
+/**
+ * Tracer.c
+ *
+ * Ring buffer event tracer with cycle counter timestamps
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "Tracer.h"
+
+#ifdef TRACER_ENABLED
+
+#include <stdbool.h>
+
+#include "FatFS/ff.h"
+
+// Format version of the dump, checked by trace_to_json.py
+#define TRACER_VERSION 1
+
+TraceEvent tracer_events[TRACER_NUM_EVENTS];
+volatile unsigned int tracer_head = 0;
+
+// Own file object, so a dump can be taken while the SD card driver
+// has a file open
+FIL tracer_file;
+
+// Helper Functions
+
+// Writes a word to a buffer in little endian order
+void tracer_putWord(unsigned char *buffer, unsigned int word) {
+    buffer[0] = (unsigned char)word;
+    buffer[1] = (unsigned char)(word >> 8);
+    buffer[2] = (unsigned char)(word >> 16);
+    buffer[3] = (unsigned char)(word >> 24);
+}
+
+// Writes events to the dump file, returning false if not all were written
+bool tracer_writeEvents(unsigned int first, unsigned int count) {
+    UINT written;
+    if (!count) return true;
+    if (f_write(&tracer_file, &tracer_events[first], count * sizeof(TraceEvent), &written) != FR_OK) return false;
+    return written == count * sizeof(TraceEvent);
+}
+
+// Driver Functions
+
+void Tracer_initialise(void) {
+    Profiler_startCounter();
+    tracer_head = 0;
+}
+
+signed int Tracer_dump(char filename[]) {
+    unsigned char header[16];
+    unsigned int head, count, first, chunk;
+    UINT written;
+    signed int status = TRACER_SUCCESS;
+
+    // Take the events up to the head as it is now
+    head = tracer_head;
+    count = (head < TRACER_NUM_EVENTS) ? head : TRACER_NUM_EVENTS;
+    first = (head - count) & (TRACER_NUM_EVENTS - 1);
+
+    if (f_open(&tracer_file, filename, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return TRACER_ERRORNOFILE;
+
+    header[0] = 'M';
+    header[1] = 'C';
+    header[2] = 'T';
+    header[3] = 'R';
+    tracer_putWord(&header[4], TRACER_VERSION);
+    tracer_putWord(&header[8], TRACER_CYCLES_PER_US);
+    tracer_putWord(&header[12], count);
+    if ((f_write(&tracer_file, header, sizeof(header), &written) != FR_OK) || (written != sizeof(header))) {
+        status = TRACER_ERRORWRITE;
+    }
+
+    // The oldest events run to the end of the buffer, then wrap to the start
+    chunk = TRACER_NUM_EVENTS - first;
+    if (chunk > count) chunk = count;
+    if ((status == TRACER_SUCCESS) && (!tracer_writeEvents(first, chunk) || !tracer_writeEvents(0, count - chunk))) {
+        status = TRACER_ERRORWRITE;
+    }
+
+    if (f_close(&tracer_file) != FR_OK) status = TRACER_ERRORWRITE;
+    return status;
+}
+
+#endif /* TRACER_ENABLED */
@@ -0,0 +1,128 @@
+/**
+ * Tracer.h
+ *
+ * Event tracer. Begin, end and instant events are written with a cycle
+ * counter timestamp into a ring buffer in memory, which keeps the
+ * latest TRACER_NUM_EVENTS events. The buffer can be saved to the SD
+ * card with Tracer_dump, and trace_to_json.py converts the file to the
+ * Chrome trace format, to be opened in Perfetto or chrome://tracing.
+ *
+ * Writing an event takes a few stores and no locks. There is a single
+ * writer (the main loop), and each event is filled in before the head
+ * is moved on, so a dump always sees whole events.
+ *
+ * Timestamps come from the PMU cycle counter (see Profiler.h), which
+ * wraps every 4.7 seconds at 900MHz. The converter unwraps them, so a
+ * gap of more than that between two events shortens the trace there.
+ *
+ * Globally define TRACER_ENABLED to use the tracer. Otherwise the
+ * macros and functions compile to nothing, and Tracer_dump has no
+ * result.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef TRACER_H_
+#define TRACER_H_
+
+#define TRACER_SUCCESS 0
+#define TRACER_ERRORNOFILE 1
+#define TRACER_ERRORWRITE 2
+
+// Number of events kept, a power of two
+#define TRACER_NUM_EVENTS 1024
+
+// Event types
+#define TRACE_TYPE_BEGIN 0
+#define TRACE_TYPE_END 1
+#define TRACE_TYPE_INSTANT 2
+
+// Event ids, named in trace_to_json.py
+#define TRACE_GAME_STATE 0      // Game state, arg is the GAMEENGINE_ state
+#define TRACE_LCD_FLUSH 1       // LCD_update
+#define TRACE_AUDIO_REFILL 2    // AUDIOOUTPUT_fill, arg of the end is the samples written
+#define TRACE_SD_READ 3         // SDCARD_readLine and SDCARD_readFile
+#define TRACE_SD_WRITE 4        // SDCARD_writeToFile and SDCARD_appendToFile
+#define TRACE_INPUT 5           // Instant, arg is the keys pressed
+#define TRACE_EFFECT 6          // Instant, arg is the GAMEENGINE_EFFECT_ played
+#define TRACE_NUM_IDS 7
+
+// Cycle counter ticks per microsecond, written in the dump header
+#if defined(__ARMCC_VERSION) || defined(__arm__)
+#define TRACER_CYCLES_PER_US 900
+#else
+#define TRACER_CYCLES_PER_US 1000
+#endif
+
+#ifdef TRACER_ENABLED
+
+#include "Profiler/Profiler.h"
+
+/**
+ * TraceEvent
+ *
+ * One event in the ring buffer, 8 bytes as saved in a dump.
+ **/
+typedef struct {
+    unsigned int cycles;    // Cycle counter when the event happened
+    unsigned short arg;     // Value depending on the event id
+    unsigned char id;       // One of the TRACE_ event ids
+    unsigned char type;     // One of the TRACE_TYPE_ event types
+} TraceEvent;
+
+extern TraceEvent tracer_events[TRACER_NUM_EVENTS];
+extern volatile unsigned int tracer_head;
+
+// Function to add an event to the ring buffer
+__forceinline static void Tracer_record(unsigned int id, unsigned int type, unsigned int arg) {
+    unsigned int head = tracer_head;
+    TraceEvent *event = &tracer_events[head & (TRACER_NUM_EVENTS - 1)];
+    event->cycles = Profiler_cycles();
+    event->arg = (unsigned short)arg;
+    event->id = (unsigned char)id;
+    event->type = (unsigned char)type;
+    // Publish the event only once it is complete
+    tracer_head = head + 1;
+}
+
+#define TRACE_BEGIN(id, arg) Tracer_record((id), TRACE_TYPE_BEGIN, (arg))
+#define TRACE_END(id, arg) Tracer_record((id), TRACE_TYPE_END, (arg))
+#define TRACE_INSTANT(id, arg) Tracer_record((id), TRACE_TYPE_INSTANT, (arg))
+
+/**
+ * Tracer_initialise
+ *
+ * Starts the cycle counter and empties the ring buffer.
+ **/
+void Tracer_initialise(void);
+
+/**
+ * Tracer_dump
+ *
+ * Saves the ring buffer to a file on the SD card, oldest event first.
+ * The file is a 16 byte header ("MCTR", format version, cycles per
+ * microsecond and event count, each a little endian 32-bit word)
+ * followed by the events. Events recorded during the dump are not
+ * saved. The SD card must be mounted.
+ *
+ * Inputs:
+ * 		filename:	name of the trace file, overwritten if it exists
+ *
+ * Outputs:
+ * 		TRACER_SUCCESS, TRACER_ERRORNOFILE or TRACER_ERRORWRITE
+ **/
+signed int Tracer_dump(char filename[]);
+
+#else
+
+#define TRACE_BEGIN(id, arg) ((void)0)
+#define TRACE_END(id, arg) ((void)0)
+#define TRACE_INSTANT(id, arg) ((void)0)
+#define Tracer_initialise() ((void)0)
+#define Tracer_dump(filename) ((void)0)
+
+#endif /* TRACER_ENABLED */
+
+#endif /* TRACER_H_ */
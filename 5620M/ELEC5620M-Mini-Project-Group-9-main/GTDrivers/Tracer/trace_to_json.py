@@ -0,0 +1,113 @@
+# Trace converter Python script
+# Converts a trace dumped by Tracer_dump into the Chrome trace event
+# format, which can be opened in Perfetto (ui.perfetto.dev) or
+# chrome://tracing.
+#
+# Run with: python trace_to_json.py trace.bin trace.json
+#
+# Each kind of event is shown on its own track. The cycle counter wraps
+# every few seconds, so times are unwrapped assuming no two events are
+# further apart than one wrap. Ends whose begin was overwritten in the
+# ring buffer are dropped, and begins still open at the end of the
+# trace are closed at the last event.
+
+# Imports
+import json
+import struct
+import sys
+
+# Constants, must match Tracer.h and Tracer.c
+MAGIC = b'MCTR'
+VERSION = 1
+HEADER = struct.Struct('<4sIII')
+EVENT = struct.Struct('<IHBB')
+
+TYPE_BEGIN = 0
+TYPE_END = 1
+TYPE_INSTANT = 2
+
+# Names of the event ids, in TRACE_ id order
+NAMES = ['game_state', 'lcd_flush', 'audio_refill', 'sd_read', 'sd_write', 'input', 'effect']
+
+# Names of the game states and effects, to label their events
+STATES = ['MAINMENU', 'PLAYING', 'PAUSED', 'LEVELUP', 'GAMEOVER', 'WIN']
+EFFECTS = ['LEVELUP', 'GAMEOVER', 'VICTORY', 'CLICK']
+
+
+def label(event_id, arg):
+    # Returns the name shown for an event
+    name = NAMES[event_id] if event_id < len(NAMES) else 'event_{}'.format(event_id)
+    if name == 'game_state':
+        return STATES[arg] if arg < len(STATES) else 'state_{}'.format(arg)
+    if name == 'effect':
+        return 'effect ' + (EFFECTS[arg] if arg < len(EFFECTS) else str(arg))
+    return name
+
+
+def read_trace(filename):
+    # Returns (cycles per microsecond, [(cycles, arg, id, type)])
+    with open(filename, 'rb') as file:
+        data = file.read()
+    if len(data) < HEADER.size:
+        sys.exit('{}: too short for a trace'.format(filename))
+    magic, version, cycles_per_us, count = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION:
+        sys.exit('{}: not a version {} trace'.format(filename, VERSION))
+    if len(data) < HEADER.size + count * EVENT.size:
+        sys.exit('{}: trace has fewer than {} events'.format(filename, count))
+    events = [EVENT.unpack_from(data, HEADER.size + i * EVENT.size) for i in range(count)]
+    return cycles_per_us, events
+
+
+def convert(cycles_per_us, events):
+    # Returns the list of Chrome trace events
+    output = []
+    open_ids = {}
+    last = None
+    now = 0
+    for cycles, arg, event_id, event_type in events:
+        # Unwrap the 32-bit cycle counter
+        if last is not None:
+            now += (cycles - last) & 0xFFFFFFFF
+        last = cycles
+        record = {'name': label(event_id, arg), 'cat': NAMES[event_id] if event_id < len(NAMES) else 'other',
+                  'pid': 1, 'tid': event_id + 1, 'ts': now / cycles_per_us}
+        if event_type == TYPE_BEGIN:
+            open_ids[event_id] = open_ids.get(event_id, 0) + 1
+            record['ph'] = 'B'
+            record['args'] = {'arg': arg}
+        elif event_type == TYPE_END:
+            if not open_ids.get(event_id):
+                continue
+            open_ids[event_id] -= 1
+            record['ph'] = 'E'
+            record['args'] = {'arg': arg}
+        else:
+            record['ph'] = 'i'
+            record['s'] = 't'
+            record['args'] = {'arg': arg}
+        output.append(record)
+
+    # Close whatever was still running when the trace was dumped
+    for event_id, depth in open_ids.items():
+        for _ in range(depth):
+            output.append({'name': NAMES[event_id] if event_id < len(NAMES) else 'other', 'pid': 1,
+                           'tid': event_id + 1, 'ts': now / cycles_per_us, 'ph': 'E'})
+
+    # Name the tracks
+    for event_id, name in enumerate(NAMES):
+        output.append({'name': 'thread_name', 'ph': 'M', 'pid': 1, 'tid': event_id + 1, 'args': {'name': name}})
+    return output
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit('usage: python trace_to_json.py trace.bin trace.json')
+    cycles_per_us, events = read_trace(sys.argv[1])
+    with open(sys.argv[2], 'w') as file:
+        json.dump({'traceEvents': convert(cycles_per_us, events), 'displayTimeUnit': 'ms'}, file)
+    print('{} events written to {}'.format(len(events), sys.argv[2]))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,136 @@
+/**
+ * FrameStats.c
+ *
+ * Implementation of the per-state frame time statistics
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "FrameStats.h"
+
+#include <stdio.h>
+
+#include "SDCard/SDCard.h"
+
+// Statistics of one game state
+typedef struct {
+    unsigned int buckets[FRAMESTATS_NUM_BUCKETS];  // Number of frames in each histogram bucket
+    unsigned int frames;                           // Number of frames recorded
+    unsigned int max_us;                           // Longest frame
+    unsigned int budget_us;                        // Frame budget, 0 for none
+    unsigned int overruns;                         // Number of frames over budget
+} StateStats;
+
+// A frame that went over budget
+typedef struct {
+    unsigned int state;            // State the frame was in
+    unsigned int frame_us;         // Time the frame took
+    unsigned long long time_ms;    // Time the frame ended
+} Overrun;
+
+// Names of the states, in GAMEENGINE_ order
+const char *state_names[FRAMESTATS_NUM_STATES] = {"MAINMENU", "PLAYING", "PAUSED", "LEVELUP", "GAMEOVER", "WIN"};
+
+StateStats state_stats[FRAMESTATS_NUM_STATES];
+
+// Latest overruns, written round in a circle
+Overrun overrun_log[FRAMESTATS_OVERRUN_LOG_LENGTH];
+unsigned int total_overruns = 0;
+
+// Text of the last summary. Each state's line is under 80 characters.
+char summary_text[160 + (FRAMESTATS_NUM_STATES + FRAMESTATS_OVERRUN_LOG_LENGTH) * 80];
+
+void FrameStats_reset(void) {
+    unsigned int state, bucket;
+    for (state = 0; state < FRAMESTATS_NUM_STATES; state++) {
+        for (bucket = 0; bucket < FRAMESTATS_NUM_BUCKETS; bucket++) {
+            state_stats[state].buckets[bucket] = 0;
+        }
+        state_stats[state].frames = 0;
+        state_stats[state].max_us = 0;
+        state_stats[state].overruns = 0;
+    }
+    total_overruns = 0;
+}
+
+void FrameStats_setBudget(unsigned int state, unsigned int budget_us) {
+    if (state >= FRAMESTATS_NUM_STATES) return;
+    state_stats[state].budget_us = budget_us;
+}
+
+void FrameStats_record(unsigned int state, unsigned int frame_us, unsigned long long now_ms) {
+    StateStats *stats;
+    Overrun *overrun;
+    unsigned int bucket = frame_us / FRAMESTATS_BUCKET_US;
+
+    if (state >= FRAMESTATS_NUM_STATES) return;
+    stats = &state_stats[state];
+
+    if (bucket >= FRAMESTATS_NUM_BUCKETS) bucket = FRAMESTATS_NUM_BUCKETS - 1;
+    stats->buckets[bucket]++;
+    stats->frames++;
+    if (frame_us > stats->max_us) stats->max_us = frame_us;
+
+    // Count and log frames over budget
+    if (stats->budget_us && (frame_us > stats->budget_us)) {
+        stats->overruns++;
+        overrun = &overrun_log[total_overruns % FRAMESTATS_OVERRUN_LOG_LENGTH];
+        overrun->state = state;
+        overrun->frame_us = frame_us;
+        overrun->time_ms = now_ms;
+        total_overruns++;
+    }
+}
+
+unsigned int FrameStats_getPercentile(unsigned int state, unsigned int percent) {
+    StateStats *stats;
+    unsigned int target, count, bucket;
+
+    if ((state >= FRAMESTATS_NUM_STATES) || !state_stats[state].frames) return 0;
+    stats = &state_stats[state];
+
+    // Number of frames at or below the percentile, rounded up
+    target = (unsigned int)(((unsigned long long)stats->frames * percent + 99) / 100);
+    count = 0;
+    for (bucket = 0; bucket < FRAMESTATS_NUM_BUCKETS - 1; bucket++) {
+        count += stats->buckets[bucket];
+        if (count >= target) break;
+    }
+    // The last bucket has no top, and no bucket is over the longest frame
+    if ((bucket == FRAMESTATS_NUM_BUCKETS - 1) || ((bucket + 1) * FRAMESTATS_BUCKET_US > stats->max_us)) {
+        return stats->max_us;
+    }
+    return (bucket + 1) * FRAMESTATS_BUCKET_US;
+}
+
+char *FrameStats_getSummary(unsigned long long now_ms) {
+    unsigned int length, state, i, count;
+    Overrun *overrun;
+
+    length = sprintf(summary_text, "Frame stats at %llu ms (times in us)\r\n", now_ms);
+    length += sprintf(&summary_text[length], "%-9s %8s %8s %8s %8s %8s %8s\r\n", "state", "frames", "p50", "p99", "max", "budget", "overruns");
+    for (state = 0; state < FRAMESTATS_NUM_STATES; state++) {
+        length += sprintf(&summary_text[length], "%-9s %8u %8u %8u %8u %8u %8u\r\n", state_names[state],
+                          state_stats[state].frames, FrameStats_getPercentile(state, 50), FrameStats_getPercentile(state, 99),
+                          state_stats[state].max_us, state_stats[state].budget_us, state_stats[state].overruns);
+    }
+
+    // Latest overruns, oldest first
+    count = (total_overruns < FRAMESTATS_OVERRUN_LOG_LENGTH) ? total_overruns : FRAMESTATS_OVERRUN_LOG_LENGTH;
+    for (i = 0; i < count; i++) {
+        overrun = &overrun_log[(total_overruns - count + i) % FRAMESTATS_OVERRUN_LOG_LENGTH];
+        length += sprintf(&summary_text[length], "Overrun at %llu ms: %s frame took %u us\r\n", overrun->time_ms,
+                          state_names[overrun->state], overrun->frame_us);
+    }
+    return summary_text;
+}
+
+void FrameStats_print(unsigned long long now_ms) {
+    printf("%s", FrameStats_getSummary(now_ms));
+}
+
+void FrameStats_appendToFile(char filename[], unsigned long long now_ms) {
+    SDCARD_appendToFile(filename, FrameStats_getSummary(now_ms));
+}
@@ -0,0 +1,107 @@
+/**
+ * FrameStats.h
+ *
+ * Frame time statistics for the main loop, kept separately for each
+ * game state. Frame times are counted in a histogram of 1ms buckets,
+ * from which the median (p50) and 99th percentile (p99) are found, and
+ * the longest frame is kept exactly. Each state has a frame budget, and
+ * frames over budget are counted with the time of the latest ones.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef FRAMESTATS_H_
+#define FRAMESTATS_H_
+
+// Number of game states, GAMEENGINE_MAINMENU to GAMEENGINE_WIN
+#define FRAMESTATS_NUM_STATES 6
+
+// Histogram buckets, each FRAMESTATS_BUCKET_US wide. The last bucket
+// holds every frame longer than the others cover.
+#define FRAMESTATS_NUM_BUCKETS 128
+#define FRAMESTATS_BUCKET_US 1000
+
+// Number of budget overruns whose time is kept
+#define FRAMESTATS_OVERRUN_LOG_LENGTH 8
+
+/**
+ * FrameStats_reset
+ *
+ * Clears every statistic. Budgets are kept.
+ **/
+void FrameStats_reset(void);
+
+/**
+ * FrameStats_setBudget
+ *
+ * Sets the longest a frame should take in a state.
+ *
+ * Inputs:
+ * 		state:		game state
+ * 		budget_us:	frame budget in microseconds, 0 for none
+ **/
+void FrameStats_setBudget(unsigned int state, unsigned int budget_us);
+
+/**
+ * FrameStats_record
+ *
+ * Adds a frame to the statistics of a state.
+ *
+ * Inputs:
+ * 		state:		game state the frame started in
+ * 		frame_us:	time the frame took in microseconds
+ * 		now_ms:		time the frame ended, kept for overruns
+ **/
+void FrameStats_record(unsigned int state, unsigned int frame_us, unsigned long long now_ms);
+
+/**
+ * FrameStats_getPercentile
+ *
+ * Inputs:
+ * 		state:		game state
+ * 		percent:	percentile to find, 1 to 100
+ *
+ * Outputs:
+ * 		Time in microseconds that the given percent of frames took no
+ * 		longer than, to the top of its histogram bucket, or 0 if no frames
+ **/
+unsigned int FrameStats_getPercentile(unsigned int state, unsigned int percent);
+
+/**
+ * FrameStats_getSummary
+ *
+ * Writes a text table of the statistics of every state, followed by the
+ * latest overruns.
+ *
+ * Inputs:
+ * 		now_ms:	current time, to put in the summary
+ *
+ * Outputs:
+ * 		The summary, valid until the next call
+ **/
+char *FrameStats_getSummary(unsigned long long now_ms);
+
+/**
+ * FrameStats_print
+ *
+ * Prints the summary to stdout (the debugger console on the board).
+ *
+ * Inputs:
+ * 		now_ms:	current time, to put in the summary
+ **/
+void FrameStats_print(unsigned long long now_ms);
+
+/**
+ * FrameStats_appendToFile
+ *
+ * Adds the summary to the end of a file on the SD card.
+ *
+ * Inputs:
+ * 		filename:	name of the stats file
+ * 		now_ms:		current time, to put in the summary
+ **/
+void FrameStats_appendToFile(char filename[], unsigned long long now_ms);
+
+#endif /* FRAMESTATS_H_ */
@@ -11,42 +11,39 @@
 #include "GameEngine.h"
 
 #include <stdbool.h>
-#include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
-#include "../GraphicsEngine/GraphicsEngine.h"
 #include "../QuestionGenerator/QuestionGenerator.h"
-#include "Audio/AudioOutput.h"
-#include "LED/LED.h"
-#include "SDCard/SDCard.h"
-#include "Servo/DE1SoC_Servo.h"
-#include "SevenSeg/SevenSeg.h"
+#include "../Replay/Replay.h"
 #include "Timer/Timer.h"
-
-// indexes for actions in last_update_time, timer_update_period,
-// and last_update_values arrays
-int gameover_led_show = 0;
-int levelup_led_show = 1;
-int celebrate_led_show = 2;
-int celebrate_text_display = 3;
-int levelup_text_display = 4;
-int gameover_text_display = 5;
-int levelup_audio = 6;
-int celebrate_audio = 7;
-int gameover_audio = 8;
-int levelup = 9;
-int celebrate = 10;
-int gameover = 11;
-
-// last update time for each action
-unsigned int last_update_time[12] = {0};
-
-// Setting the update period for each action
-unsigned int timer_update_period[12] = {1000, 100, 100, 400, 100, 100, 400, 400, 400, 3000, 5000, 5000};
-
-// this is to set the led display initially then they will be updated to this array
-unsigned int last_update_values[12] = {0x000, 0x011, 0x015, 0, 0, 0, A4, C4, A3, 0, 0, 0};
+#include "Tracer/Tracer.h"
+
+// Software timers for the screens shown after a round
+TimerEvent screen_timer;    // Leaves the screen once it has been shown for long enough
+TimerEvent marquee_timer;   // Scrolls text across the seven segment displays
+TimerEvent led_show_timer;  // Steps the LED animation
+
+// Time each screen is shown for in milliseconds
+#define LEVELUP_SCREEN_MS 3000
+#define GAMEOVER_SCREEN_MS 5000
+#define CELEBRATE_SCREEN_MS 5000
+
+// Time between each step of the scrolling text and LED animations in milliseconds
+#define LEVELUP_TEXT_MS 100
+#define GAMEOVER_TEXT_MS 100
+#define CELEBRATE_TEXT_MS 400
+#define LEVELUP_LED_MS 100
+#define GAMEOVER_LED_MS 1000
+#define CELEBRATE_LED_MS 100
+
+// Scrolling text being shown, and the index of its first character on the display
+char* marquee_text;
+unsigned int marquee_position;
+
+// Current pattern of each LED animation
+unsigned int gameover_led_pattern = 0x000;
+unsigned int levelup_led_pattern = 0x011;
+unsigned int celebrate_led_pattern = 0x015;
 
 // victory to be displayed when the game is completed
 char* celebrate_text = "      victory     ";
@@ -57,11 +54,6 @@ char* level_up_text = "      correct ans     ";
 // text to be displayed when player loses
 char* game_over_text = "      try again     ";
 
-// flags used to check when to play audio for actions
-bool play_levelup_audio = true;
-bool play_gameover_audio = true;
-bool play_celebrate_audio = true;
-
 // Game State Variables
 unsigned int state = GAMEENGINE_MAINMENU;                                // Initial screen is Main Menu
 unsigned int level = 0;                                                  // Start at level 0
@@ -73,90 +65,338 @@ float volume = 5.0;                                                      // Defa
 QuestionResult current_question;                                         // Declare question
 unsigned int easy_question_levels[10] = {1, 1, 1, 1, 1, 2, 2, 2, 2, 2};  // Level for every round on easy mode
 unsigned int hard_question_levels[10] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3};  // Level for every round on hard mode
-unsigned int timer_color[3] = {0, 255, 0};                               // Timer color initially is Green
-char store_filename[];                                                   // = "mathclub.txt";
+char store_filename[32];                                                 // = "mathclub.txt";
+
+// Where the game is shown, played and stored, set by GameEngine_initialise
+const GameEngineOutput* output;
+
+// Time left in the round, and the time it was last counted down in ms
+float round_time_remaining;
+unsigned long long last_round_time_update;
 
 // TODO: make score a function of time taken to answer and difficulty.
 
 // Helper methods
-void displaySentence(char* text, int update_value_index) {
-    // Get current time
-    unsigned int current_time = Timer_getValueMS();
-    // If enough time has passed
-    if ((last_update_time[update_value_index] - current_time) >= timer_update_period[update_value_index]) {
-        // shift the word being displayed by 1 character
-        char display_word[6];
-        strncpy(display_word, text + last_update_values[update_value_index], 6);
-        // display word on seven segment display
-        SevenSeg_displayWord(display_word);
-        // increment current display value
-        last_update_values[update_value_index]++;
-
-        // If reached the end of the sentence, reset to start
-        if (last_update_values[update_value_index] + 6 > strlen(text)) {
-            last_update_values[update_value_index] = 0;
-        }
-        // Update last timer update value
-        last_update_time[update_value_index] = current_time;
+// Shows the next 6 characters of the scrolling text. Timer callback.
+void scrollMarquee(void* context) {
+    // shift the word being displayed by 1 character
+    char display_word[7];
+    (void)context;
+    strncpy(display_word, marquee_text + marquee_position, 6);
+    display_word[6] = '\0';
+    // display word on seven segment display
+    output->showText(display_word);
+    // increment current display value
+    marquee_position++;
+
+    // If reached the end of the sentence, reset to start
+    if (marquee_position + 6 > strlen(marquee_text)) {
+        marquee_position = 0;
     }
 }
 
-// Plays a single note for specified action
-// The audio effect plays two
-// notes the first note plays for 1/3rd of the duration
-// and the second plays for 2/3rds of the duration.
-void playSoundEffectFor(unsigned int action_id, double note1, double note2) {
-    unsigned int current_time, time_elapsed, note1_play_period;
-    double tone;
-    // Set the last update time to current time
-    last_update_time[action_id] = Timer_getValueMS();
-    // This is a blocking operation but audio sounds are played
-    // for very short durations and do not affect the rest of the game
-    // Non-blocking could not be done as the values were not being
-    // written fast enough to the FIFO registers resulting in no output
-    while (1) {
-        // Get current timer value
-        current_time = Timer_getValueMS();
-        // If enough time has passed
-        time_elapsed = last_update_time[action_id] - current_time;
-
-        if (time_elapsed >= timer_update_period[action_id]) {
-            // stop playing audio
-            break;
-        }
-        // Play audio
-        note1_play_period = timer_update_period[action_id] / 3;
-        tone = time_elapsed > note1_play_period ? note2 : note1;
-        AUDIOOUTPUT_playTone(tone, volume * 10, AUDIO_BOTHCHANNELS);
+// Starts scrolling text across the seven segment displays
+void startMarquee(char* text, unsigned int period_ms) {
+    marquee_text = text;
+    marquee_position = 0;
+    scrollMarquee(0);
+    Timer_addPeriodic(&marquee_timer, period_ms * 1000, &scrollMarquee, 0);
+}
+
+// Leaves the screen shown after a round. Timer callback.
+void endRoundScreen(void* context) {
+    (void)context;
+    if (state == GAMEENGINE_LEVELUP) {
+        // Carry on to the next question
+        GameEngine_setState(GAMEENGINE_PLAYING);
+    } else {
+        // The game was reset when the screen was entered
+        GameEngine_setState(GAMEENGINE_MAINMENU);
+    }
+}
+
+// Steps the LED animation of the current screen. Timer callback.
+void stepLEDShow(void* context) {
+    (void)context;
+    if (state == GAMEENGINE_LEVELUP) {
+        GameEngine_levelUpLEDShow();
+    } else if (state == GAMEENGINE_GAMEOVER) {
+        GameEngine_gameOverLEDShow();
+    } else if (state == GAMEENGINE_WIN) {
+        GameEngine_celebrateLEDShow();
     }
 }
 
-unsigned int getHighScore() {
-    char score[100];
-    unsigned int score_int;
-    SDCARD_readLine(store_filename, 100, score);
-    score_int = strtoul(score, NULL, 10);
-    return score_int;
+// Starts the LED animation of the current screen
+void startLEDShow(unsigned int period_ms) {
+    stepLEDShow(0);
+    Timer_addPeriodic(&led_show_timer, period_ms * 1000, &stepLEDShow, 0);
 }
 
 void setHighScore(unsigned int new_high_score) {
-    char* text;
     if (new_high_score > 10)
         new_high_score = 10;
 
     high_score = new_high_score;
-    sprintf(text, "%u\r\n", new_high_score);
-    SDCARD_writeToFile(store_filename, text);
+    output->saveHighScore(store_filename, new_high_score);
+}
+
+// Sets the output volume from the game volume, clamped to 0-10
+void setOutputVolume() {
+    output->setVolume((volume < 0) ? 0 : (volume > 10) ? 10 : (unsigned int)volume);
+}
+
+// Resets the round time to the time limit
+void resetRoundTime() {
+    round_time_remaining = time_limit;
+}
+
+// Resets the level, score and round time for the game
+void resetGameProgress() {
+    GameEngine_setLevel(0);  // reset the level
+    GameEngine_setScore(0);  // reset the score
+    resetRoundTime();        // reset the round time
+}
+
+// Plays a sound effect. Playback happens in the background so this
+// returns immediately.
+unsigned int GameEngine_playEffect(unsigned int effect_id) {
+    // Guard to check if effect is invalid
+    if (effect_id > GAMEENGINE_EFFECT_CLICK)
+        return GAMEENGINE_SUCCESS;
+
+    TRACE_INSTANT(TRACE_EFFECT, effect_id);
+    output->playEffect(effect_id);
+
+    return GAMEENGINE_SUCCESS;
+}
+
+// State Handlers
+// Each state has actions run when it is entered, on every frame while it
+// is the current state, and when it is left. Screens are drawn on entry
+// and only redrawn by the frame action when something on them changes.
+
+// Action run when a state is entered or left
+typedef void (*StateAction)(void);
+
+// Action run every frame, with the keys pressed and the slide switches
+typedef void (*StateTick)(unsigned int keys_pressed, unsigned int switches);
+
+typedef struct {
+    StateAction on_enter;  // 0 for nothing
+    StateTick on_tick;     // 0 for nothing
+    StateAction on_exit;   // 0 for nothing
+} GameEngineState;
+
+// Shows the main menu and starts the music
+void enterMainMenu() {
+    output->playMusic(true);
+    GameEngine_displayMainMenu();
+}
+
+// Sets the game mode and volume, and starts a game
+void tickMainMenu(unsigned int keys_pressed, unsigned int switches) {
+    bool redraw = false;
+    // Set the game mode before the buttons, so a game started this
+    // frame gets the time limit of its mode. SW0 on is HARD.
+    unsigned int new_game_mode = (switches & 0x1) ? GAMEENGINE_HARD : GAMEENGINE_EASY;
+    if (new_game_mode != game_mode) {
+        GameEngine_setGameMode(new_game_mode);
+        redraw = true;
+    }
+
+    // Click on any button press
+    if (keys_pressed & 0xF) {
+        GameEngine_playEffect(GAMEENGINE_EFFECT_CLICK);
+    }
+
+    // Handle button presses
+    if (keys_pressed & 0x2) {
+        // if player clicks Btn 1 i.e. selects increase volume option
+        GameEngine_increaseVolume();  // increase the volume
+        redraw = true;
+    }
+    if (keys_pressed & 0x4) {
+        // if player clicks Btn 2 i.e. selects decrease volume option
+        GameEngine_decreaseVolume();  // decrease the volume
+        redraw = true;
+    }
+    if (keys_pressed & 0x1) {
+        // if player clicks Btn 0 i.e. selects Play option
+        resetGameProgress();                      // reset the level, score and round time
+        GameEngine_setState(GAMEENGINE_PLAYING);  // set game state to PLAYING
+        return;
+    }
+
+    // Show the new mode or volume
+    if (redraw) {
+        output->showMainMenu(game_mode, (unsigned int)volume, high_score);
+    }
+}
+
+// Stops the music
+void exitMainMenu() {
+    output->playMusic(false);
+}
+
+// Shows the question and starts counting down the round time
+void enterPlaying() {
+    // Count the round time from now rather than from the last time the
+    // game was playing, so a second is not lost on leaving the pause menu
+    last_round_time_update = Timer_nowMs();
+    GameEngine_displayLevel(round_time_remaining);
+}
+
+// Takes the answer, pauses and counts down the round time
+void tickPlaying(unsigned int keys_pressed, unsigned int switches) {
+    // Get the current timer value in milliseconds
+    unsigned long long current_time = Timer_nowMs();
+
+    // If player runs out of time, end game.
+    if (round_time_remaining <= 0) {
+        GameEngine_setState(GAMEENGINE_GAMEOVER);  // set game state to GAMEOVER
+        return;
+    }
+
+    // If any option is selected i.e. any button is clicked.
+    if (keys_pressed & 0xF) {
+        resetRoundTime();  // reset the round time
+
+        // Handle button presses. Each ends the round.
+        if (keys_pressed & 0x1) {
+            // if player clicks Btn 0 i.e. selects option 1
+            GameEngine_enterOption(GAMEENGINE_OPTION1);  // enter option 1
+        }
+        if (keys_pressed & 0x2) {
+            // if player clicks Btn 1 i.e. selects option 2
+            GameEngine_enterOption(GAMEENGINE_OPTION2);  // enter option 2
+        }
+        if (keys_pressed & 0x4) {
+            // if player clicks Btn 2 i.e. selects option 3
+            GameEngine_enterOption(GAMEENGINE_OPTION3);  // enter option 3
+        }
+        if (keys_pressed & 0x8) {
+            // if player clicks Btn 3 i.e. selects option 4
+            GameEngine_enterOption(GAMEENGINE_OPTION4);  // enter option 4
+        }
+        return;
+    }
+
+    // If SW9 is on set game mode to paused
+    if (switches & 0x200) {
+        GameEngine_setState(GAMEENGINE_PAUSED);
+        return;
+    }
+
+    // Count down once a second has passed since the remaining time was
+    // last updated, and show the new time
+    if ((current_time - last_round_time_update) >= 1000) {
+        round_time_remaining--;  // reduce the time by 1 unit
+
+        // round time cannot be below 0
+        if (round_time_remaining < 0) {
+            round_time_remaining = 0.0;
+        }
+
+        // update the last_round_time_update to current time
+        last_round_time_update = current_time;
+        GameEngine_displayLevel(round_time_remaining);
+    }
+}
+
+// Shows the pause menu
+void enterPaused() {
+    GameEngine_displayPauseMenu();
+}
+
+// Sets the volume, and leaves the game or carries on
+void tickPaused(unsigned int keys_pressed, unsigned int switches) {
+    bool redraw = false;
+
+    // Click on any button press
+    if (keys_pressed & 0xF) {
+        GameEngine_playEffect(GAMEENGINE_EFFECT_CLICK);
+    }
+
+    // Handle button presses
+    if (keys_pressed & 0x2) {
+        // if player clicks Btn 1 i.e. selects increase volume option
+        GameEngine_increaseVolume();  // increase the volume
+        redraw = true;
+    }
+    if (keys_pressed & 0x4) {
+        // if player clicks Btn 2 i.e. selects decrease volume option
+        GameEngine_decreaseVolume();  // decrease the volume
+        redraw = true;
+    }
+    if (keys_pressed & 0x1) {
+        // if player clicks Btn 0 i.e. selects exit option
+        resetGameProgress();                       // reset the level, score and round time
+        GameEngine_setState(GAMEENGINE_MAINMENU);  // exit to main menu
+        return;
+    }
+
+    // If SW9 is off set game mode to PLAYING
+    if (!(switches & 0x200)) {
+        GameEngine_setState(GAMEENGINE_PLAYING);
+        return;
+    }
+
+    // Show the new volume
+    if (redraw) {
+        output->showPauseMenu((unsigned int)volume);
+    }
+}
+
+// Shows the level up screen, then carries on after LEVELUP_SCREEN_MS
+void enterLevelUp() {
+    GameEngine_levelUp();
+    startMarquee(level_up_text, LEVELUP_TEXT_MS);
+    Timer_addOneShot(&screen_timer, LEVELUP_SCREEN_MS * 1000, &endRoundScreen, 0);
+    startLEDShow(LEVELUP_LED_MS);
 }
 
-// Resets all audio flags
-void resetAudioFlags() {
-    play_levelup_audio = true;
-    play_gameover_audio = true;
-    play_celebrate_audio = true;
+// Saves the high score and resets the game, then shows the game over
+// screen until GAMEOVER_SCREEN_MS has passed
+void enterGameOver() {
+    GameEngine_reset();
+    GameEngine_gameOver();
+    startMarquee(game_over_text, GAMEOVER_TEXT_MS);
+    Timer_addOneShot(&screen_timer, GAMEOVER_SCREEN_MS * 1000, &endRoundScreen, 0);
+    startLEDShow(GAMEOVER_LED_MS);
 }
 
-// Sets the current state of game
+// Saves the high score and resets the game, then shows the victory
+// screen until CELEBRATE_SCREEN_MS has passed
+void enterWin() {
+    GameEngine_reset();
+    GameEngine_celebrate();
+    startMarquee(celebrate_text, CELEBRATE_TEXT_MS);
+    Timer_addOneShot(&screen_timer, CELEBRATE_SCREEN_MS * 1000, &endRoundScreen, 0);
+    startLEDShow(CELEBRATE_LED_MS);
+}
+
+// Stops the timers of a screen shown after a round and turns off the
+// LEDs left on by its animation
+void exitRoundScreen() {
+    Timer_cancel(&screen_timer);
+    Timer_cancel(&marquee_timer);
+    Timer_cancel(&led_show_timer);
+    output->showLEDs(0);
+}
+
+// Actions of each state, in GAMEENGINE_ order. The screens shown after a
+// round are run by their timers, so have nothing to do each frame.
+const GameEngineState game_states[GAMEENGINE_WIN + 1] = {
+    {&enterMainMenu, &tickMainMenu, &exitMainMenu},  // GAMEENGINE_MAINMENU
+    {&enterPlaying, &tickPlaying, 0},                // GAMEENGINE_PLAYING
+    {&enterPaused, &tickPaused, 0},                  // GAMEENGINE_PAUSED
+    {&enterLevelUp, 0, &exitRoundScreen},            // GAMEENGINE_LEVELUP
+    {&enterGameOver, 0, &exitRoundScreen},           // GAMEENGINE_GAMEOVER
+    {&enterWin, 0, &exitRoundScreen}};               // GAMEENGINE_WIN
+
+// Sets the current state of game, leaving the current state and entering
+// the new one. Setting the current state again enters it again.
 // State can be one of:
 // GAMEENGINE_MAINMENU, GAMEENGINE_PLAYING, GAMEENGINE_PAUSED
 // GAMEENGINE_LEVELUP, GAMEENGINE_GAMEOVER, GAMEENGINE_WIN
@@ -165,8 +405,14 @@ void GameEngine_setState(unsigned int new_state) {
     if (new_state > GAMEENGINE_WIN)  // > 5
         new_state = GAMEENGINE_MAINMENU;
 
+    if (game_states[state].on_exit) game_states[state].on_exit();
+
     // update game state
+    TRACE_END(TRACE_GAME_STATE, state);
+    TRACE_BEGIN(TRACE_GAME_STATE, new_state);
     state = new_state;
+
+    if (game_states[state].on_enter) game_states[state].on_enter();
 }
 
 // Returns the current state of game
@@ -174,6 +420,28 @@ unsigned int GameEngine_getState() {
     return state;
 }
 
+// Adds the game state to a hash
+unsigned int GameEngine_hashState(unsigned int hash) {
+    unsigned long long since_update;
+    hash = Replay_hash(hash, &state, sizeof(state));
+    hash = Replay_hash(hash, &level, sizeof(level));
+    hash = Replay_hash(hash, &game_mode, sizeof(game_mode));
+    hash = Replay_hash(hash, &score, sizeof(score));
+    hash = Replay_hash(hash, &time_limit, sizeof(time_limit));
+    hash = Replay_hash(hash, &volume, sizeof(volume));
+    // Only the text up to its end, as the rest of the array is not set
+    hash = Replay_hash(hash, current_question.text, strlen(current_question.text));
+    hash = Replay_hash(hash, &current_question.answer, sizeof(current_question.answer));
+    hash = Replay_hash(hash, current_question.options, sizeof(current_question.options));
+    hash = Replay_hash(hash, &marquee_position, sizeof(marquee_position));
+    // The round timer as the time since its last update, as a replay may
+    // run at a later time than it was recorded
+    since_update = Timer_nowMs() - last_round_time_update;
+    hash = Replay_hash(hash, &round_time_remaining, sizeof(round_time_remaining));
+    hash = Replay_hash(hash, &since_update, sizeof(since_update));
+    return hash;
+}
+
 // Sets the current level of game
 void GameEngine_setLevel(unsigned int new_level) {
     unsigned int difficulty;
@@ -192,9 +460,6 @@ void GameEngine_setLevel(unsigned int new_level) {
 
     // Generate new question with appropriate difficulty level
     current_question = QuestionGenerator_generateQuestion(difficulty);
-
-    // Reset audio flags everytime the level is changed
-    resetAudioFlags();
 }
 
 // Sets the current game mode of game
@@ -243,12 +508,14 @@ float GameEngine_getTimeLimit() {
 void GameEngine_increaseVolume() {
     if (!(volume > 10.0))
         volume += 1.0;
+    setOutputVolume();
 }
 
 // Decreases the volume by 1 unit down to 0
 void GameEngine_decreaseVolume() {
     if (!(volume < 0))
         volume -= 1.0;
+    setOutputVolume();
 }
 
 // Set the current volume of the game
@@ -263,41 +530,33 @@ void GameEngine_setVolume(float new_volume) {
 
     // update volume
     volume = new_volume;
+    setOutputVolume();
 }
 
-void GameEngine_setLevelUpLastUpdateTime(unsigned int time) {
-    last_update_time[levelup] = time;
-    last_update_time[levelup_text_display] = time;
-    //    last_update_time[levelup_led_show] = Timer_getValueMS();
-}
-
-void GameEngine_setCelebrateLastUpdateTime(unsigned int time) {
-    last_update_time[celebrate] = time;
-    last_update_time[celebrate_led_show] = time;
-    //    last_update_time[celebrate_text_display] = time;
-}
+// Intialises the state variables of the game to default values
+void GameEngine_initialise(const GameEngineOutput* game_output, char* storage_filename) {
+    // set the storage file name
+    strncpy(store_filename, storage_filename, sizeof(store_filename) - 1);
 
-void GameEngine_setGameOverLastUpdateTime(unsigned int time) {
-    last_update_time[gameover] = time;
-    last_update_time[gameover_text_display] = time;
-    //    last_update_time[gameover_led_show] = time;
-}
+    // Set up the outputs, such as rendering the sound effects
+    output = game_output;
+    output->initialise();
 
-// Intialises the state variables of the game to default values
-void GameEngine_initialise(char* storage_filename) {
-    strcpy(store_filename, storage_filename);  // set the storage file name
     GameEngine_setLevel(0);                    // Start at level 0
     GameEngine_setGameMode(GAMEENGINE_EASY);   // Default game mode is Easy
     GameEngine_setScore(0);                    // Initial score is 0
-    GameEngine_setState(GAMEENGINE_MAINMENU);  // Initial screen is Main Menu
     GameEngine_setVolume(5.0);                 // Default volume is 50%
 
+    // Start the round timer at the time limit
+    resetRoundTime();
+
     // check if storage file exists
-    if (SDCARD_checkFileExists(store_filename)) {
-        high_score = getHighScore();  // if exists get high score from SD Card
-    } else {
+    if (!output->loadHighScore(store_filename, &high_score)) {
         setHighScore(0);  // create file and add default highscore
     }
+
+    // Initial screen is Main Menu, shown with the high score loaded
+    GameEngine_setState(GAMEENGINE_MAINMENU);
 }
 
 void GameEngine_reset() {
@@ -324,87 +583,47 @@ void GameEngine_enterOption(unsigned int option) {
         GameEngine_setScore(score + 1);  // increment score by 1
 
         if (score >= 10) {
-            GameEngine_reset();
-            GameEngine_setCelebrateLastUpdateTime(Timer_getValueMS());
-            GameEngine_setState(GAMEENGINE_WIN);  // display game over screen
+            GameEngine_setState(GAMEENGINE_WIN);  // display victory screen, which resets the game
         } else {
             GameEngine_setLevel(level + 1);  // increment level by 1
-            GameEngine_setLevelUpLastUpdateTime(Timer_getValueMS());
             GameEngine_setState(GAMEENGINE_LEVELUP);  // display level up screen
         }
 
     } else {
-        GameEngine_reset();
-        GameEngine_setGameOverLastUpdateTime(Timer_getValueMS());
-        GameEngine_setState(GAMEENGINE_GAMEOVER);  // display game over screen
+        GameEngine_setState(GAMEENGINE_GAMEOVER);  // display game over screen, which resets the game
     }
 }
 
-// Sets the color of the timer progress bar based on % of time left
-void setTimerColor(float timer_value_percentage) {
-    if (timer_value_percentage < 33) {
-        // If 1/3 of time is left, set color to RED
-        timer_color[0] = RED[0];
-        timer_color[1] = RED[1];
-        timer_color[2] = RED[2];
-    } else if (timer_value_percentage < 66) {
-        // If 2/3 of time is left, set color to RED
-        timer_color[0] = ORANGE[0];
-        timer_color[1] = ORANGE[1];
-        timer_color[2] = ORANGE[2];
-    } else {
-        // else set color to GREEN
-        timer_color[0] = GREEN[0];
-        timer_color[1] = GREEN[1];
-        timer_color[2] = GREEN[2];
+#ifdef GAMEENGINE_HEADLESS
+// Returns the option that answers the current question
+unsigned int GameEngine_getAnswerOption() {
+    unsigned int option;
+    for (option = GAMEENGINE_OPTION1; option < GAMEENGINE_OPTION4; option++) {
+        if (current_question.options[option] == current_question.answer) break;
     }
+    return option;
 }
+#endif
 
 // Displays main menu screen
 void GameEngine_displayMainMenu() {
     // draw main menu with game's current mode and volume level
-    GraphicsEngine_drawMainMenu(game_mode, (unsigned int)volume, high_score);
-    SevenSeg_displayWord("start");
-    LED_write(0);
+    output->showMainMenu(game_mode, (unsigned int)volume, high_score);
+    output->showText("start");
+    output->showLEDs(0);
 }
 
 // Displays pause menu screen
 void GameEngine_displayPauseMenu() {
     // draw pause menu with game's current volume level
-    GraphicsEngine_drawPauseMenu((unsigned int)volume);
-    LED_write(0);
+    output->showPauseMenu((unsigned int)volume);
+    output->showLEDs(0);
 }
 
 // Displays question with four options and timer progress bar on the screen
 unsigned int GameEngine_displayLevel(float time_remaining) {
-    float timer_value_percentage;
-    int option_id;
-    // Set background to WHITE
-    GraphicsEngine_setBackground(255, 255, 255);
-
-    // Determine percentage of time_limit left and update timer color
-    timer_value_percentage = ((time_remaining / time_limit) * 100);
-    setTimerColor(timer_value_percentage);
-
-    // draw timer progress bar with value and color
-    GraphicsEngine_drawProgressBar(180, 40, 20, 240, timer_value_percentage, timer_color);
-    // show time on servo
-    Servo_setPositionInRange(0, 0, time_limit, time_remaining);
-
-    // draw the current question on the screen
-    GraphicsEngine_drawQuestion(current_question.text);
-
-    // draw all 4 options on the screen
-    for (option_id = 0; option_id < 4; option_id++) {
-        char option_text[10];
-        sprintf(option_text, "%u", current_question.options[option_id]);
-        GraphicsEngine_drawOption(option_text, option_id);
-    }
-
-    // display current score on the seven segment displays
-    SevenSeg_displayNumber(score);
-    // display level on LEDs
-    LED_setValueInRange(0, 10, level + 1);
+    // draw the question and options with the time left, score and level
+    output->showLevel(current_question.text, current_question.options, time_limit, time_remaining, score, level);
 
     return GAMEENGINE_SUCCESS;
 }
@@ -412,152 +631,77 @@ unsigned int GameEngine_displayLevel(float time_remaining) {
 // If the answer is correct display Nice on the display
 // Also run the leds from the left to the right
 unsigned int GameEngine_levelUp() {
-    unsigned int current_time;
     // Display "Level Up" on LCD
-    GraphicsEngine_drawMessage("Level Up!", BLUE, WHITE, WHITE);
-    // Display "correct ans" on seven segment
-    displaySentence(level_up_text, levelup_text_display);
-    // Show success led pattern
-    //    GameEngine_levelUpLEDShow();
-
-    // If audio hasn't been played, play it
-    if (play_levelup_audio) {
-        playSoundEffectFor(levelup_audio, C3, A3);
-        // Once audio is played, unset flag so it does not play again
-        // since it is a blocking operation
-        play_levelup_audio = false;
-    }
+    output->showMessage(GAMEENGINE_LEVELUP);
+    // "correct ans" scrolls on seven segment from the marquee timer
 
-    // Get current timer value
-    current_time = Timer_getValueMS();
-    // If enough time has passed
-    if ((last_update_time[levelup] - current_time) >= timer_update_period[levelup]) {
-        GameEngine_setState(GAMEENGINE_PLAYING);
-
-        // Update last update time value
-        last_update_time[levelup] = current_time;
-    }
+    // Called once as the screen is entered, so the effect plays once
+    GameEngine_playEffect(GAMEENGINE_EFFECT_LEVELUP);
 
     return GAMEENGINE_SUCCESS;
 }
 
 // This will cycle the LEDs through 2 leds to shift across the display
 unsigned int GameEngine_levelUpLEDShow() {
-    // Get current timer value
-    unsigned int current_time = Timer_getValueMS();
-    // If enough time has passed
-    if ((last_update_time[levelup_led_show] - current_time) >= timer_update_period[levelup_led_show]) {
-        // If reached end of pattern
-        if (last_update_values[levelup_led_show] > 0x220) {
-            last_update_values[levelup_led_show] = 0x011;  // reset led values
-        }
-        // Set leds to last display value
-        LED_write(last_update_values[levelup_led_show]);
-        // Update last display value to be inverse of current value << 1
-        last_update_values[levelup_led_show] = last_update_values[levelup_led_show] << 1;
-        // Update last update time value
-        last_update_time[levelup_led_show] = current_time;
+    // If reached end of pattern
+    if (levelup_led_pattern > 0x220) {
+        levelup_led_pattern = 0x011;  // reset led values
     }
+    // Set leds to last display value
+    output->showLEDs(levelup_led_pattern);
+    // Update last display value to be inverse of current value << 1
+    levelup_led_pattern = levelup_led_pattern << 1;
     return GAMEENGINE_SUCCESS;
 }
 
 // If the answer is wrong display Failed and all
 //  the leds will flash
 unsigned int GameEngine_gameOver() {
-    unsigned int current_time;
     // Display "Game Over" on LCD
-    GraphicsEngine_drawMessage("Game Over!", RED, BLACK, BLACK);
-    // Display "try again" on seven segment
-    displaySentence(game_over_text, gameover_text_display);
-    // Show failed led pattern
-    //    GameEngine_gameOverLEDShow();
-
-    // If audio hasn't been played, play it
-    if (play_gameover_audio) {
-        playSoundEffectFor(gameover_audio, G3, D3);
-        // Once audio is played, unset flag so it does not play again
-        // since it is a blocking operation
-        play_gameover_audio = false;
-    }
-
-    // Get current timer value
-    current_time = Timer_getValueMS();
-    // If enough time has passed
-    if ((last_update_time[gameover] - current_time) >= timer_update_period[gameover]) {
-        GameEngine_reset();
-        GameEngine_setState(GAMEENGINE_MAINMENU);
+    output->showMessage(GAMEENGINE_GAMEOVER);
+    // "try again" scrolls on seven segment from the marquee timer
 
-        // Update last update time value
-        last_update_time[gameover] = current_time;
-    }
+    // Called once as the screen is entered, so the effect plays once
+    GameEngine_playEffect(GAMEENGINE_EFFECT_GAMEOVER);
 
     return GAMEENGINE_SUCCESS;
 }
 
 // This will display the leds for when the answer is wrong
 unsigned int GameEngine_gameOverLEDShow() {
-    // Get current timer value
-    unsigned int current_time = Timer_getValueMS();
-    // If enough time has passed
-    if ((last_update_time[gameover_led_show] - current_time) >= timer_update_period[gameover_led_show]) {
-        // Set leds to last display value
-        LED_write(last_update_values[gameover_led_show]);
-        // Update last display value to be inverse of current value
-        last_update_values[gameover_led_show] = ~last_update_values[gameover_led_show];
-        // Update last update time value
-        last_update_time[gameover_led_show] = current_time;
-    }
+    // Set leds to last display value
+    output->showLEDs(gameover_led_pattern);
+    // Update last display value to be inverse of current value
+    gameover_led_pattern = ~gameover_led_pattern;
     return GAMEENGINE_SUCCESS;
 }
 
 unsigned int GameEngine_celebrate() {
-    unsigned int current_time;
     // Display "Victory!" on LCD
-    GraphicsEngine_drawMessage("Victory!", GREEN, BLACK, WHITE);
-    // Display "victory" on seven segment
-    displaySentence(celebrate_text, celebrate_text_display);
-    // Show celebrate led pattern
-    //    GameEngine_celebrateLEDShow();
-
-    // If audio hasn't been played, play it
-    if (play_celebrate_audio) {
-        playSoundEffectFor(celebrate_audio, G3, E4);
-        // Once audio is played, unset flag so it does not play again
-        // since it is a blocking operation
-        play_celebrate_audio = false;
-    }
+    output->showMessage(GAMEENGINE_WIN);
+    // "victory" scrolls on seven segment from the marquee timer
 
-    // Get current timer value
-    current_time = Timer_getValueMS();
-    // If enough time has passed
-    if ((last_update_time[celebrate] - current_time) >= timer_update_period[celebrate]) {
-        GameEngine_reset();
-        GameEngine_setState(GAMEENGINE_MAINMENU);
-
-        // Update last update time value
-        last_update_time[celebrate] = current_time;
-    }
+    // Called once as the screen is entered, so the effect plays once
+    GameEngine_playEffect(GAMEENGINE_EFFECT_VICTORY);
 
     return GAMEENGINE_SUCCESS;
 }
 
 // This will cycle the leds 3 leds used
 unsigned int GameEngine_celebrateLEDShow() {
-    // Get current timer value
-    unsigned int current_time = Timer_getValueMS();
-    // If enough time has passed
-    if ((last_update_time[celebrate_led_show] - current_time) >= timer_update_period[celebrate_led_show]) {
-        // If reached end of pattern
-        if (last_update_values[celebrate_led_show] > 0x2A0) {
-            last_update_values[celebrate_led_show] = 0x015;  // reset led values
-        }
-        // Set leds to last display value
-        LED_write(last_update_values[celebrate_led_show]);
-        // Update last display value to be inverse of current value << 1
-        last_update_values[celebrate_led_show] = last_update_values[celebrate_led_show] << 1;
-
-        // Update last update time value
-        last_update_time[celebrate_led_show] = current_time;
+    // If reached end of pattern
+    if (celebrate_led_pattern > 0x2A0) {
+        celebrate_led_pattern = 0x015;  // reset led values
     }
+    // Set leds to last display value
+    output->showLEDs(celebrate_led_pattern);
+    // Update last display value to be inverse of current value << 1
+    celebrate_led_pattern = celebrate_led_pattern << 1;
     return GAMEENGINE_SUCCESS;
 }
+
+// Runs one frame of the game from the keys pressed since the last frame
+// and the slide switches
+void GameEngine_update(unsigned int keys_pressed, unsigned int switches) {
+    if (game_states[state].on_tick) game_states[state].on_tick(keys_pressed, switches);
+}
@@ -5,9 +5,12 @@
  *
  * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
  *
- * Date: 06/05/2023
+ * Date: 19/10/2026
  */
 
+#ifndef GAMEENGINE_H_
+#define GAMEENGINE_H_
+
 #include <stdbool.h>
 
 #define GAMEENGINE_SUCCESS 1
@@ -25,12 +28,58 @@
 #define GAMEENGINE_OPTION2 1
 #define GAMEENGINE_OPTION3 2
 #define GAMEENGINE_OPTION4 3
+#define GAMEENGINE_EFFECT_LEVELUP 0
+#define GAMEENGINE_EFFECT_GAMEOVER 1
+#define GAMEENGINE_EFFECT_VICTORY 2
+#define GAMEENGINE_EFFECT_CLICK 3
+
+/**
+ * GameEngineOutput
+ *
+ * Everything the game engine shows, plays and stores goes through one of
+ * these tables, so the game logic does not depend on the board drivers.
+ * GameEngine_boardOutput drives the LCD, seven segment displays, LEDs,
+ * servo, audio and SD card. A headless build can use a table that
+ * ignores or records the outputs instead (see Headless/HeadlessOutput.h).
+ *
+ */
+typedef struct {
+    // Sets up the outputs, called once by GameEngine_initialise
+    void (*initialise)(void);
+    // Draws the main menu and pause menu screens
+    void (*showMainMenu)(unsigned int game_mode, unsigned int volume, unsigned int high_score);
+    void (*showPauseMenu)(unsigned int volume);
+    // Draws a question with its options, the time left, the score and the level
+    void (*showLevel)(char *question, int options[4], float time_limit, float time_remaining,
+                      unsigned int score, unsigned int level);
+    // Draws the message of a screen shown after a round, given by its state:
+    // GAMEENGINE_LEVELUP, GAMEENGINE_GAMEOVER or GAMEENGINE_WIN
+    void (*showMessage)(unsigned int state);
+    // Shows up to 6 characters of text on the seven segment displays
+    void (*showText)(char *text);
+    // Sets the LEDs
+    void (*showLEDs)(unsigned int pattern);
+    // Starts a GAMEENGINE_EFFECT_ sound effect
+    void (*playEffect)(unsigned int effect_id);
+    // Starts or stops the menu music
+    void (*playMusic)(bool play);
+    // Sets the output volume, 0-10
+    void (*setVolume)(unsigned int volume);
+    // Reads the high score from a file, returning false if there is none
+    bool (*loadHighScore)(char *filename, unsigned int *high_score);
+    // Writes the high score to a file
+    void (*saveHighScore)(char *filename, unsigned int high_score);
+} GameEngineOutput;
+
+// Outputs on the DE1-SoC, defined in GameEngineBoard.c
+extern const GameEngineOutput GameEngine_boardOutput;
 
 /**
  * GameEngine_levelUp
  *
  * High Level that will display "correct ans" when question is
- * answered correctly.
+ * answered correctly, and play the level up effect. Called once as
+ * the level up screen is entered.
  *
  */
 unsigned int GameEngine_levelUp(void);
@@ -39,7 +88,8 @@ unsigned int GameEngine_levelUp(void);
  * GameEngine_gameOver
  *
  * High Level that will display "try again" when question is
- * answered incorrectly.
+ * answered incorrectly, and play the game over effect. Called once as
+ * the game over screen is entered.
  *
  */
 unsigned int GameEngine_gameOver(void);
@@ -48,7 +98,7 @@ unsigned int GameEngine_gameOver(void);
  * GameEngine_failLedShow
  *
  * High Level that will play an animation on the LEDs when
- * the player loses.
+ * the player loses. Each call shows the next step.
  *
  */
 unsigned int GameEngine_gameOverLEDShow(void);
@@ -57,7 +107,7 @@ unsigned int GameEngine_gameOverLEDShow(void);
  * GameEngine_successLedShow
  *
  * High Level that will play an animation on the LEDs when
- * the player progresses to the next level.
+ * the player progresses to the next level. Each call shows the next step.
  *
  */
 unsigned int GameEngine_levelUpLEDShow(void);
@@ -65,7 +115,8 @@ unsigned int GameEngine_levelUpLEDShow(void);
 /**
  * GameEngine_celebrate
  *
- * High level that will display "victory" in a scrolling effect
+ * High level that will display "victory" in a scrolling effect, and
+ * play the victory effect. Called once as the victory screen is entered.
  *
  */
 unsigned int GameEngine_celebrate(void);
@@ -73,15 +124,44 @@ unsigned int GameEngine_celebrate(void);
 /**
  * GameEngine_celebrateLedShow
  *
- * High Level that will shift 3 leds when the game is complete
+ * High Level that will shift 3 leds when the game is complete.
+ * Each call shows the next step.
  *
  */
 unsigned int GameEngine_celebrateLEDShow(void);
 
+/**
+ * GameEngine_playEffect
+ *
+ * Starts a sound effect and returns immediately. The effects are
+ * rendered once by GameEngine_initialise, so playing one only mixes
+ * the cached samples in the background by AUDIOOUTPUT_service.
+ *
+ * Inputs:
+ *      effect_id:  The effect to play, values can be one of:
+ *                  GAMEENGINE_EFFECT_LEVELUP, GAMEENGINE_EFFECT_GAMEOVER
+ *                  GAMEENGINE_EFFECT_VICTORY, GAMEENGINE_EFFECT_CLICK
+ *
+ */
+unsigned int GameEngine_playEffect(unsigned int effect_id);
+
+/**
+ * GameEngine_getEffectCacheSize
+ *
+ * Returns the number of bytes of the sound effect cache used by
+ * the pre-rendered effects of GameEngine_boardOutput.
+ *
+ */
+unsigned int GameEngine_getEffectCacheSize(void);
+
 /**
  * GameEngine_setState
  *
- * Sets the current state of the game
+ * Sets the current state of the game. The exit action of the current
+ * state runs, then the entry action of the new state, which draws its
+ * screen and starts its effect and timers. Entering the game over or
+ * victory screen saves the high score and resets the game. Setting the
+ * current state again leaves it and enters it again.
  *
  * Inputs:
  *      new_state:  The state to set the game in, values can be one of:
@@ -101,6 +181,22 @@ void GameEngine_setState(unsigned int new_state);
  */
 unsigned int GameEngine_getState(void);
 
+/**
+ * GameEngine_hashState
+ * Adds the game's state, level, mode, score, time limit, volume,
+ * current question, scrolling text position and round time to a hash,
+ * so a replay can be checked against its recording. The high score is
+ * left out as it is kept on the SD card between games.
+ *
+ * Inputs:
+ *      hash:   hash so far, REPLAY_HASH_START to begin
+ *
+ * Output:
+ *      Returns the new hash.
+ *
+ */
+unsigned int GameEngine_hashState(unsigned int hash);
+
 /**
  * GameEngine_setLevel
  *
@@ -197,10 +293,30 @@ void GameEngine_setVolume(float new_volume);
  * Setting the volume to 5.0
  *
  * Input:
- *      storage_filname:    name of the file used for storage of highscore.
+ *      game_output:        outputs to show the game on, such as
+ *                          &GameEngine_boardOutput. They must stay valid.
+ *      storage_filname:    name of the file used for storage of highscore,
+ *                          up to 31 characters.
+ *
+ */
+void GameEngine_initialise(const GameEngineOutput *game_output, char *storage_filename);
+
+/**
+ * GameEngine_update
+ *
+ * Runs the frame action of the current state: acting on the keys
+ * pressed and switches, redrawing only what has changed and counting
+ * down the round time. The screens shown after a round have no frame
+ * action. Call once per frame from the main loop, with Timer_service
+ * also called each frame to run the screen timers.
+ *
+ * Inputs:
+ *      keys_pressed:   1 for each push button pressed and released since
+ *                      the last frame
+ *      switches:       slide switch values, SW0 for hard mode and SW9 to pause
  *
  */
-void GameEngine_initialise(char *storage_filename);
+void GameEngine_update(unsigned int keys_pressed, unsigned int switches);
 
 /**
  * GameEngine_enterOption
@@ -257,35 +373,19 @@ unsigned int GameEngine_displayLevel(float time_remaining);
  */
 void GameEngine_reset(void);
 
+#ifdef GAMEENGINE_HEADLESS
 /**
- * GameEngine_setLevelUpLastUpdateTime
- *
- * Sets the last update time for the level up animations
- *
- *  * Inputs:
- *      time:  the time to set the last update time value to
- *
- */
-void GameEngine_setLevelUpLastUpdateTime(unsigned int time);
-
-/**
- * GameEngine_setCelebrateLastUpdateTime
+ * GameEngine_getAnswerOption
  *
- * Sets the last update time for the celebrate animations
+ * Test hook for the headless build, which peeks at the answer so its
+ * inputs can win games.
  *
- *  * Inputs:
- *      time:  the time to set the last update time value to
+ * Output:
+ *      Returns the option of the current question that is correct, one
+ *      of GAMEENGINE_OPTION1 to GAMEENGINE_OPTION4.
  *
  */
-void GameEngine_setCelebrateLastUpdateTime(unsigned int time);
+unsigned int GameEngine_getAnswerOption(void);
+#endif
 
-/**
- * GameEngine_setGameOverLastUpdateTime
- *
- * Sets the last update time for the game over animations
- *
- *  * Inputs:
- *      time:  the time to set the last update time value to
- *
- */
-void GameEngine_setGameOverLastUpdateTime(unsigned int time);
+#endif /* GAMEENGINE_H_ */
@@ -0,0 +1,266 @@
+/**
+ * GameEngineBoard.c
+ *
+ * Game engine outputs on the DE1-SoC: the screens are drawn on the LCD
+ * by the graphics engine, text on the seven segment displays, the level
+ * on the LEDs and the time left on the servo. Sound effects and music
+ * play through the synthesiser and the high score is kept on the SD card.
+ *
+ * The seven segment displays, LEDs and servo are set through the output
+ * buffer, so only values that change are written when it is committed
+ * at the end of the frame.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "GameEngine.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../GraphicsEngine/GraphicsEngine.h"
+#include "Audio/AudioOutput.h"
+#include "Audio/AudioSequencer.h"
+#include "Audio/AudioSynth.h"
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "LED/LED.h"
+#include "OutputBuffer/OutputBuffer.h"
+#include "SDCard/SDCard.h"
+#include "Servo/DE1SoC_Servo.h"
+#include "SevenSeg/SevenSeg.h"
+
+// Synthesiser voice whose sound is used to render the sound effects
+#define EFFECT_VOICE 0
+
+// Sample slots used to play the effects. Clicks use their own slot
+// so they don't cut off the other effects.
+#define EFFECT_SLOT 0
+#define CLICK_SLOT 1
+
+// Number of sound effects, GAMEENGINE_EFFECT_* are indexes up to this
+#define NUM_EFFECTS 4
+
+// Size of the effect cache, enough for 1.5 seconds of effects at 48 kHz
+// or 2.25 seconds at 32 kHz
+#define EFFECT_CACHE_SAMPLES 72000
+
+// Note sequences for each sound effect, indexed by GAMEENGINE_EFFECT_*.
+// Each effect plays two notes, the first note plays for 1/3rd of the duration
+// and the second plays for 2/3rds of the duration.
+AudioNote levelup_effect[] = {{C3, 133}, {A3, 267}};
+AudioNote gameover_effect[] = {{G3, 133}, {D3, 267}};
+AudioNote celebrate_effect[] = {{G3, 133}, {E4, 267}};
+AudioNote click_effect[] = {{C6, 10}};
+AudioNote* effect_notes[NUM_EFFECTS] = {levelup_effect, gameover_effect, celebrate_effect, click_effect};
+unsigned int effect_lengths[NUM_EFFECTS] = {2, 2, 2, 1};
+
+// Pre-rendered effects. Each effect is stored at effect_samples[id] in the
+// cache and is effect_sample_lengths[id] samples long.
+signed short effect_cache[EFFECT_CACHE_SAMPLES];
+signed short* effect_samples[NUM_EFFECTS];
+unsigned int effect_sample_lengths[NUM_EFFECTS];
+unsigned int effect_cache_used = 0;  // Samples of the cache in use
+
+// Synthesiser voices used by the menu music, these must match menu_music.txt
+#define MUSIC_MELODY_VOICE 1
+#define MUSIC_BASS_VOICE 2
+
+// Main menu music, generated from menu_music.txt into MenuMusic.c
+extern const Sequence menu_music;
+
+// Codec output volume in dB for each volume level. This matches the loudness of
+// the old per-sample scaling by volume / 10 at the codec's default of -24dB.
+const signed int volume_db[11] = {-73, -44, -38, -34, -32, -30, -28, -27, -26, -25, -24};
+
+unsigned int timer_color[3] = {0, 255, 0};  // Timer color initially is Green
+
+// Sets every seven segment display through the output buffer
+void bufferSevenSeg(unsigned char values[OUTPUTBUFFER_NUM_SEVENSEG]) {
+    unsigned int display;
+    for (display = 0; display < OUTPUTBUFFER_NUM_SEVENSEG; display++) {
+        OutputBuffer_setSevenSeg(display, values[display]);
+    }
+}
+
+// Renders every sound effect into the effect cache so they never
+// need to be synthesised again
+void buildEffectCache() {
+    unsigned int effect;
+    signed int length;
+
+    effect_cache_used = 0;
+    for (effect = 0; effect < NUM_EFFECTS; effect++) {
+        effect_samples[effect] = &effect_cache[effect_cache_used];
+        length = SYNTH_renderNotes(EFFECT_VOICE, effect_notes[effect], effect_lengths[effect],
+                                   effect_samples[effect], EFFECT_CACHE_SAMPLES - effect_cache_used);
+        // An effect that can't be rendered is left silent
+        if (length < 0)
+            length = 0;
+        effect_sample_lengths[effect] = (unsigned int)length;
+        effect_cache_used += (unsigned int)length;
+    }
+}
+
+// Returns the bytes of the effect cache in use
+unsigned int GameEngine_getEffectCacheSize() {
+    return effect_cache_used * sizeof(effect_cache[0]);
+}
+
+// Sets the color of the timer progress bar based on % of time left
+void setTimerColor(float timer_value_percentage) {
+    if (timer_value_percentage < 33) {
+        // If 1/3 of time is left, set color to RED
+        timer_color[0] = RED[0];
+        timer_color[1] = RED[1];
+        timer_color[2] = RED[2];
+    } else if (timer_value_percentage < 66) {
+        // If 2/3 of time is left, set color to RED
+        timer_color[0] = ORANGE[0];
+        timer_color[1] = ORANGE[1];
+        timer_color[2] = ORANGE[2];
+    } else {
+        // else set color to GREEN
+        timer_color[0] = GREEN[0];
+        timer_color[1] = GREEN[1];
+        timer_color[2] = GREEN[2];
+    }
+}
+
+// Output Functions
+
+// Renders the sound effects and sets up the music voices
+void boardInitialise(void) {
+    // Render the sound effects once so playing them costs no synthesis
+    buildEffectCache();
+
+    // Set up the music voices before the main menu starts the music
+    SYNTH_setWaveform(MUSIC_MELODY_VOICE, SYNTH_WAVE_TRIANGLE);
+    SYNTH_setEnvelope(MUSIC_MELODY_VOICE, 5, 100, 60, 60);
+    SYNTH_setWaveform(MUSIC_BASS_VOICE, SYNTH_WAVE_SINE);
+    SYNTH_setEnvelope(MUSIC_BASS_VOICE, 5, 200, 80, 60);
+    // The music plays at half the level of the sound effects
+    SYNTH_setGain(MUSIC_MELODY_VOICE, 50);
+    SYNTH_setGain(MUSIC_BASS_VOICE, 50);
+}
+
+void boardShowMainMenu(unsigned int game_mode, unsigned int volume, unsigned int high_score) {
+    GraphicsEngine_drawMainMenu(game_mode, volume, high_score);
+}
+
+void boardShowPauseMenu(unsigned int volume) {
+    GraphicsEngine_drawPauseMenu(volume);
+}
+
+// Draws the question, options and timer progress bar, with the time on
+// the servo, the score on the seven segment displays and the level on the LEDs
+void boardShowLevel(char* question, int options[4], float time_limit, float time_remaining,
+                    unsigned int score, unsigned int level) {
+    float timer_value_percentage;
+    int option_id;
+    unsigned char score_segments[OUTPUTBUFFER_NUM_SEVENSEG];
+    // Set background to WHITE
+    GraphicsEngine_setBackground(255, 255, 255);
+
+    // Determine percentage of time_limit left and update timer color
+    timer_value_percentage = ((time_remaining / time_limit) * 100);
+    setTimerColor(timer_value_percentage);
+
+    // draw timer progress bar with value and color
+    GraphicsEngine_drawProgressBar(180, 40, 20, 240, timer_value_percentage, timer_color);
+    // show time on servo
+    OutputBuffer_setServo(0, Servo_rangeToPulseWidth(0, time_limit, time_remaining));
+
+    // draw the current question on the screen
+    GraphicsEngine_drawQuestion(question);
+
+    // draw all 4 options on the screen
+    for (option_id = 0; option_id < 4; option_id++) {
+        char option_text[10];
+        sprintf(option_text, "%u", options[option_id]);
+        GraphicsEngine_drawOption(option_text, option_id);
+    }
+
+    // display current score on the seven segment displays
+    SevenSeg_encodeNumber(score, score_segments);
+    bufferSevenSeg(score_segments);
+    // display level on LEDs
+    OutputBuffer_setLEDs(LED_rangeToValue(0, 10, level + 1));
+}
+
+void boardShowMessage(unsigned int state) {
+    if (state == GAMEENGINE_LEVELUP) {
+        GraphicsEngine_drawMessage("Level Up!", BLUE, WHITE, WHITE);
+    } else if (state == GAMEENGINE_GAMEOVER) {
+        GraphicsEngine_drawMessage("Game Over!", RED, BLACK, BLACK);
+    } else if (state == GAMEENGINE_WIN) {
+        GraphicsEngine_drawMessage("Victory!", GREEN, BLACK, WHITE);
+    }
+}
+
+void boardShowText(char* text) {
+    unsigned char segments[OUTPUTBUFFER_NUM_SEVENSEG];
+    SevenSeg_encodeWord(text, segments);
+    bufferSevenSeg(segments);
+}
+
+void boardShowLEDs(unsigned int pattern) {
+    OutputBuffer_setLEDs(pattern);
+}
+
+// Plays a cached sound effect. Each effect replaces the one before so
+// they do not pile up. Effects play at full scale, the volume is set on
+// the codec.
+void boardPlayEffect(unsigned int effect_id) {
+    if (effect_id >= NUM_EFFECTS)
+        return;
+    SYNTH_playSample((effect_id == GAMEENGINE_EFFECT_CLICK) ? CLICK_SLOT : EFFECT_SLOT,
+                     effect_samples[effect_id], effect_sample_lengths[effect_id], 100);
+}
+
+void boardPlayMusic(bool play) {
+    if (play) {
+        if (!SEQUENCER_isPlaying())
+            SEQUENCER_play(&menu_music, true);
+    } else {
+        SEQUENCER_stop();
+    }
+}
+
+// Sets the codec output volume. The audio is rendered at full scale and
+// only the codec volume changes, so this is a single I2C write. Volume 0
+// soft mutes the codec.
+void boardSetVolume(unsigned int volume) {
+    WM8731_softMute(volume == 0);
+    WM8731_setOutputVolume(volume_db[volume]);
+}
+
+bool boardLoadHighScore(char* filename, unsigned int* high_score) {
+    char score[100];
+    if (!SDCARD_checkFileExists(filename))
+        return false;
+    SDCARD_readLine(filename, 100, score);
+    *high_score = strtoul(score, NULL, 10);
+    return true;
+}
+
+void boardSaveHighScore(char* filename, unsigned int high_score) {
+    char text[16];
+    sprintf(text, "%u\r\n", high_score);
+    SDCARD_writeToFile(filename, text);
+}
+
+const GameEngineOutput GameEngine_boardOutput = {
+    &boardInitialise,
+    &boardShowMainMenu,
+    &boardShowPauseMenu,
+    &boardShowLevel,
+    &boardShowMessage,
+    &boardShowText,
+    &boardShowLEDs,
+    &boardPlayEffect,
+    &boardPlayMusic,
+    &boardSetVolume,
+    &boardLoadHighScore,
+    &boardSaveHighScore};
@@ -0,0 +1,37 @@
+/*
+ * Sequence menu_music
+ * -----------------------------------------
+ *
+ * THIS FILE IS GENERATED BY sequence_gen.py FROM menu_music.txt. DO NOT EDIT.
+ *
+ */
+
+#include "Audio/AudioSequencer.h"
+
+const SequenceEvent menu_music_events[] = {
+    {0, 1, AUDIO_NOTE(5, 0), 1},
+    {0, 2, AUDIO_NOTE(3, 0), 2},
+    {1, 1, AUDIO_NOTE(5, 4), 1},
+    {1, 1, AUDIO_NOTE(5, 7), 1},
+    {0, 2, AUDIO_NOTE(3, 7), 2},
+    {1, 1, AUDIO_NOTE(5, 4), 1},
+    {1, 1, AUDIO_NOTE(5, 5), 1},
+    {0, 2, AUDIO_NOTE(3, 5), 2},
+    {1, 1, AUDIO_NOTE(5, 9), 1},
+    {1, 1, AUDIO_NOTE(5, 7), 2},
+    {0, 2, AUDIO_NOTE(3, 0), 2},
+    {2, 1, AUDIO_NOTE(5, 4), 1},
+    {0, 2, AUDIO_NOTE(3, 0), 2},
+    {1, 1, AUDIO_NOTE(5, 7), 1},
+    {1, 1, AUDIO_NOTE(6, 0), 1},
+    {0, 2, AUDIO_NOTE(3, 4), 2},
+    {1, 1, AUDIO_NOTE(5, 7), 1},
+    {1, 1, AUDIO_NOTE(5, 5), 1},
+    {0, 2, AUDIO_NOTE(3, 7), 2},
+    {1, 1, AUDIO_NOTE(5, 2), 1},
+    {1, 1, AUDIO_NOTE(5, 0), 2},
+    {0, 2, AUDIO_NOTE(3, 0), 2},
+    {2, 0, SEQUENCER_NOTE_END, 0},
+};
+
+const Sequence menu_music = {menu_music_events, 250};
@@ -14,6 +14,7 @@
 #include "GraphicsEngine.h"
 
 #include "LCD/LCD.h"
+#include "Profiler/Profiler.h"
 
 unsigned int RED[3] = {255u, 0u, 0u};
 unsigned int GREEN[3] = {0u, 255u, 0u};
@@ -77,8 +78,10 @@ void GraphicsEngine_drawProgressBar(unsigned int x, unsigned int y, float height
 
 // Draws the question on the screen
 void GraphicsEngine_drawQuestion(char* text) {
+    PROF_BEGIN(PROF_DRAW_QUESTION);
     // draw the text at fixed location for question.
     LCD_drawText(text, 150, 40, LCD_BLACK, 2);
+    PROF_END(PROF_DRAW_QUESTION);
 }
 
 // Draws a multiple choice options on the screen
@@ -97,9 +100,11 @@ void GraphicsEngine_drawOption(char* text, unsigned int option_number) {
     int padding_x = text_size == 1 ? 20 : text_size == 2 ? 15 : 10;
     int padding_y = 10;
 
+    PROF_BEGIN(PROF_DRAW_OPTION);
     // Draw rectangle with text inside
     LCD_drawRectangle(x, y, 45, 110, option_colors[option_number], true);
     LCD_drawText(text, x + padding_x, y + padding_y, LCD_WHITE, text_size);
+    PROF_END(PROF_DRAW_OPTION);
 }
 
 // Draws a message on the screen
@@ -111,10 +116,12 @@ void GraphicsEngine_drawMessage(char* text, unsigned int text_color[3], unsigned
     unsigned short shp_color = LCD_makeColour(shape_color[0], shape_color[1], shape_color[2]);
     int text_size = 3;
 
+    PROF_BEGIN(PROF_DRAW_MESSAGE);
     // Set bg color, draw circle and add text
     LCD_setColor(background_color[0], background_color[1], background_color[2]);
     LCD_drawCircle((int)(LCD_WIDTH / 2), (int)(LCD_HEIGHT / 2), 110, shp_color, true);
     LCD_drawText(text, (int)((LCD_WIDTH / 2) - 15), (int)((LCD_HEIGHT / 2) - (calcTextWidth(text, text_size) / 2)), txt_color, text_size);
+    PROF_END(PROF_DRAW_MESSAGE);
 }
 
 void GraphicsEngine_drawVolumeBar(unsigned int volume, unsigned int x, unsigned int y, unsigned int height, unsigned int width) {
@@ -130,6 +137,7 @@ void GraphicsEngine_drawVolumeBar(unsigned int volume, unsigned int x, unsigned
 // Draws main menu page
 void GraphicsEngine_drawMainMenu(bool is_hard, unsigned int volume, unsigned int high_score) {
     char* highscore;
+    PROF_BEGIN(PROF_DRAW_MAINMENU);
     // Set background to BLACK
     GraphicsEngine_setBackground(0, 0, 0);
 
@@ -153,10 +161,12 @@ void GraphicsEngine_drawMainMenu(bool is_hard, unsigned int volume, unsigned int
 
     // Draw volume bar
     GraphicsEngine_drawVolumeBar(volume, 15, 15, 15, 240);
+    PROF_END(PROF_DRAW_MAINMENU);
 }
 
 // Draws Pause Menu
 void GraphicsEngine_drawPauseMenu(unsigned int volume) {
+    PROF_BEGIN(PROF_DRAW_PAUSEMENU);
     // Set background to BLACK
     GraphicsEngine_setBackground(0,0,0);
     
@@ -171,6 +181,7 @@ void GraphicsEngine_drawPauseMenu(unsigned int volume) {
 
     // Draw volume bar
     GraphicsEngine_drawVolumeBar(volume, 15, 15, 15, 240);
+    PROF_END(PROF_DRAW_PAUSEMENU);
 }
 
 // Draws MathClub Logo at specified x,y (bottom-left)
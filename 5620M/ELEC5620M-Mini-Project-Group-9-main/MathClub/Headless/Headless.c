@@ -0,0 +1,312 @@
+/**
+ * Headless.c
+ *
+ * Runs the game on a Linux host with no board, to fuzz the game state
+ * machine and load test the scoring and high score storage. Each game
+ * is fed random push button and slide switch inputs, picking the answer
+ * more often than not so games are won, with the time moved on by a
+ * fixed step every frame, and is checked after every frame against the
+ * limits of the game. Output goes to the recording outputs, or the null
+ * outputs to measure the game logic alone.
+ *
+ * The game engine keeps its state in globals, so each instance runs in
+ * its own process. Instances are independent, with their own seed.
+ *
+ * Build with TIMER_HOST and GAMEENGINE_HEADLESS defined, from
+ * GameEngine.c, QuestionGenerator.c, Replay.c, Timer.c and the
+ * Headless files, for example:
+ *
+ *   gcc -O2 -DTIMER_HOST -DGAMEENGINE_HEADLESS -D__forceinline=inline
+ *       -IGTDrivers -IMathClub MathClub/GameEngine/GameEngine.c
+ *       MathClub/QuestionGenerator/QuestionGenerator.c
+ *       MathClub/Replay/Replay.c GTDrivers/Timer/Timer.c
+ *       MathClub/Headless/Headless.c MathClub/Headless/HeadlessOutput.c
+ *       -o headless
+ *
+ * Run with: headless [frames] [seed] [instances] [null]
+ *
+ * With REPLAY_ENABLED defined as well, a recording can be made of random
+ * inputs or played back, checking every frame against the hash it was
+ * recorded with. A replay.bin saved on the board plays the same way, as
+ * the headless build hashes the same game state as main.c:
+ *
+ *   headless record <file> [frames] [seed]
+ *   headless replay <file>
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifdef GAMEENGINE_HEADLESS
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Headless/HeadlessOutput.h"  // Includes GameEngine.h
+#include "QuestionGenerator/QuestionGenerator.h"
+#include "Replay/Replay.h"
+#include "Timer/Timer.h"
+
+// Virtual time between frames, about 60 frames a second
+#define HEADLESS_FRAME_US 16000
+
+// Defaults for the command line
+#define HEADLESS_DEFAULT_FRAMES 1000000
+#define HEADLESS_DEFAULT_SEED 1
+#define HEADLESS_DEFAULT_INSTANCES 1
+
+// Slide switches the inputs change
+#define HEADLESS_SW_HARD 0x001   // SW0, hard mode on the main menu
+#define HEADLESS_SW_PAUSE 0x200  // SW9, pauses a game
+
+#define HEADLESS_HIGH_SCORE_FILE "mathclub.txt"
+
+// Result of an instance
+typedef struct {
+    unsigned long long frames;
+    unsigned int hash;         // Game state hash after the last frame
+    unsigned int violations;   // Frames that broke a limit of the game
+    signed long long first_violation;  // First frame that did, -1 for none
+} HeadlessResult;
+
+// Random inputs, from an xorshift generator of their own so they do not
+// change the questions
+unsigned int input_random;
+
+unsigned int nextInput(void) {
+    input_random ^= input_random << 13;
+    input_random ^= input_random >> 17;
+    input_random ^= input_random << 5;
+    return input_random;
+}
+
+// Returns the time now in seconds
+double wallSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Sets random inputs for a frame: a key held down now and then, which is
+// pressed when let go, and the mode and pause changed now and then. While
+// playing, 3 in 4 of the keys are the answer, so games are won as well
+// as lost.
+void randomInputs(unsigned int *key_state, unsigned int *switch_state) {
+    unsigned int random = nextInput();
+    unsigned int key = (random >> 3) & 0x3;
+    if ((GameEngine_getState() == GAMEENGINE_PLAYING) && ((random >> 28) & 0x3)) key = GameEngine_getAnswerOption();
+    *key_state = ((random & 0x7) == 0) ? (1 << key) : 0;
+    if (((random >> 8) & 0x3FF) == 0) *switch_state ^= HEADLESS_SW_HARD;
+    if (((random >> 18) & 0x3FF) == 0) *switch_state ^= HEADLESS_SW_PAUSE;
+}
+
+// Returns true if the game is within its limits after a frame
+bool checkFrame(bool recording) {
+    if (GameEngine_getState() > GAMEENGINE_WIN) return false;
+    if (!recording) return true;
+    if ((HeadlessOutput_record.max_score > 10) || (HeadlessOutput_record.max_level > 9)) return false;
+    if (HeadlessOutput_record.max_high_score > 10) return false;
+    if ((HeadlessOutput_record.time_remaining < 0) ||
+        (HeadlessOutput_record.time_remaining > HeadlessOutput_record.time_limit)) {
+        return false;
+    }
+    return true;
+}
+
+// Runs one instance of the game for a number of frames
+HeadlessResult runInstance(unsigned long long frames, unsigned int seed, bool recording) {
+    HeadlessResult result;
+    unsigned long long time_us = 0;
+    unsigned int key_state = 0, key_last_state = 0, switch_state = 0;
+    unsigned int keys_pressed;
+
+    result.violations = 0;
+    result.first_violation = -1;
+
+    // The generator must not start at 0
+    input_random = seed ? seed : 1;
+    QuestionGenerator_setSeed(seed);
+    HeadlessOutput_reset();
+    Timer_initialise(0);
+    Timer_setFrameTime(time_us);
+    GameEngine_initialise(recording ? &HeadlessOutput_recording : &HeadlessOutput_null, HEADLESS_HIGH_SCORE_FILE);
+
+    for (result.frames = 0; result.frames < frames; result.frames++) {
+        time_us += HEADLESS_FRAME_US;
+        Timer_setFrameTime(time_us);
+
+        randomInputs(&key_state, &switch_state);
+        keys_pressed = (~key_state) & key_last_state;
+        key_last_state = key_state;
+
+        GameEngine_update(keys_pressed, switch_state);
+        Timer_service();
+
+        if (!checkFrame(recording)) {
+            if (result.first_violation < 0) result.first_violation = (signed long long)result.frames;
+            result.violations++;
+        }
+    }
+    result.hash = GameEngine_hashState(REPLAY_HASH_START);
+    return result;
+}
+
+// Prints the result of an instance
+void printResult(unsigned int instance, unsigned int seed, HeadlessResult *result, double seconds, bool recording) {
+    printf("instance %u: seed %u, %llu frames in %.3f s (%.0f frames/s), hash %08x\n", instance, seed,
+           result->frames, seconds, result->frames / seconds, result->hash);
+    if (recording) {
+        printf("  games won %u, lost %u, levels up %u, high score %u (saved %u times), clicks %u\n",
+               HeadlessOutput_record.effects[GAMEENGINE_EFFECT_VICTORY],
+               HeadlessOutput_record.effects[GAMEENGINE_EFFECT_GAMEOVER],
+               HeadlessOutput_record.effects[GAMEENGINE_EFFECT_LEVELUP],
+               HeadlessOutput_record.num_files ? HeadlessOutput_record.high_scores[0] : 0,
+               HeadlessOutput_record.high_score_saves, HeadlessOutput_record.effects[GAMEENGINE_EFFECT_CLICK]);
+    }
+    if (result->violations) {
+        printf("  %u frames broke a limit, the first was frame %lld\n", result->violations, result->first_violation);
+    }
+}
+
+#ifdef REPLAY_ENABLED
+// A recording, as saved in a file
+unsigned char headless_replay[REPLAY_HEADER_BYTES + REPLAY_MAX_FRAMES * sizeof(ReplayFrame)];
+
+// Runs frames the way the main loop on the board does, from random inputs
+// while recording or the recorded inputs while playing. Returns the number
+// of frames that broke a limit of the game.
+unsigned int runReplay(unsigned long long frames, unsigned int seed) {
+    unsigned int key_state = 0, key_last_state = 0, switch_state = 0;
+    unsigned int keys_pressed, hash, violations = 0;
+    unsigned long long frame;
+
+    input_random = seed ? seed : 1;
+    QuestionGenerator_setSeed(Replay_getSeed());
+    GameEngine_initialise(&HeadlessOutput_recording, HEADLESS_HIGH_SCORE_FILE);
+
+    for (frame = 0; frame < frames; frame++) {
+        // The board's timer runs on by a frame, which the replay follows
+        Timer_advanceHardware(HEADLESS_FRAME_US);
+        randomInputs(&key_state, &switch_state);
+        Replay_beginFrame(&key_state, &switch_state);
+
+        keys_pressed = (~key_state) & key_last_state;
+        key_last_state = key_state;
+
+        GameEngine_update(keys_pressed, switch_state);
+        Timer_service();
+        if (!checkFrame(true)) violations++;
+
+        // Hashed as hashGameState does in main.c
+        hash = GameEngine_hashState(REPLAY_HASH_START);
+        hash = Replay_hash(hash, &key_last_state, sizeof(key_last_state));
+        if (Replay_endFrame(hash)) break;
+    }
+    return violations;
+}
+
+// Records frames of random inputs into a file
+int recordReplay(char filename[], unsigned long long frames, unsigned int seed) {
+    unsigned int length, violations;
+    FILE *file;
+
+    if (frames > REPLAY_MAX_FRAMES) frames = REPLAY_MAX_FRAMES;
+    HeadlessOutput_reset();
+    Timer_initialise(0);
+    Replay_startRecording(seed);
+    violations = runReplay(frames, seed);
+
+    if (Replay_saveToMemory(headless_replay, sizeof(headless_replay), &length) != REPLAY_SUCCESS) return 2;
+    file = fopen(filename, "wb");
+    if (!file || (fwrite(headless_replay, 1, length, file) != length) || fclose(file)) {
+        perror(filename);
+        return 2;
+    }
+    printf("Recorded %llu frames, seed %u, into %s\n", frames, seed, filename);
+    return violations ? 1 : 0;
+}
+
+// Plays a recording from a file, failing if a frame does not match
+int playReplay(char filename[]) {
+    unsigned int length;
+    FILE *file = fopen(filename, "rb");
+
+    if (!file) {
+        perror(filename);
+        return 2;
+    }
+    length = (unsigned int)fread(headless_replay, 1, sizeof(headless_replay), file);
+    fclose(file);
+
+    HeadlessOutput_reset();
+    Timer_initialise(0);
+    if (Replay_startPlaybackFromMemory(headless_replay, length) != REPLAY_SUCCESS) {
+        printf("%s is not a recording\n", filename);
+        return 2;
+    }
+    // Inputs come from the recording, so run until it has all played
+    runReplay(REPLAY_MAX_FRAMES, 1);
+    Replay_print();
+    return (Replay_getDivergence() < 0) ? 0 : 1;
+}
+#endif
+
+int main(int argc, char *argv[]) {
+    unsigned long long frames = (argc > 1) ? strtoull(argv[1], NULL, 10) : HEADLESS_DEFAULT_FRAMES;
+    unsigned int seed = (argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 10) : HEADLESS_DEFAULT_SEED;
+    unsigned int instances = (argc > 3) ? (unsigned int)strtoul(argv[3], NULL, 10) : HEADLESS_DEFAULT_INSTANCES;
+    bool recording = !((argc > 4) && !strcmp(argv[4], "null"));
+    HeadlessResult result;
+    unsigned int i, failed = 0;
+    int status;
+    double start, seconds;
+    pid_t pid;
+
+#ifdef REPLAY_ENABLED
+    if ((argc > 2) && !strcmp(argv[1], "record")) {
+        return recordReplay(argv[2], (argc > 3) ? strtoull(argv[3], NULL, 10) : HEADLESS_DEFAULT_FRAMES,
+                            (argc > 4) ? (unsigned int)strtoul(argv[4], NULL, 10) : HEADLESS_DEFAULT_SEED);
+    }
+    if ((argc > 2) && !strcmp(argv[1], "replay")) return playReplay(argv[2]);
+#endif
+
+    if (!instances) instances = 1;
+    start = wallSeconds();
+
+    // A single instance runs here, more each run in a process of their own
+    if (instances == 1) {
+        result = runInstance(frames, seed, recording);
+        printResult(0, seed, &result, wallSeconds() - start, recording);
+        return result.violations ? 1 : 0;
+    }
+
+    for (i = 0; i < instances; i++) {
+        pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            return 2;
+        }
+        if (pid == 0) {
+            double instance_start = wallSeconds();
+            result = runInstance(frames, seed + i, recording);
+            printResult(i, seed + i, &result, wallSeconds() - instance_start, recording);
+            fflush(stdout);
+            _exit(result.violations ? 1 : 0);
+        }
+    }
+    for (i = 0; i < instances; i++) {
+        if ((wait(&status) < 0) || !WIFEXITED(status) || WEXITSTATUS(status)) failed++;
+    }
+
+    seconds = wallSeconds() - start;
+    printf("%u instances, %llu frames in %.3f s (%.0f frames/s), %u failed\n", instances, frames * instances,
+           seconds, frames * instances / seconds, failed);
+    return failed ? 1 : 0;
+}
+
+#endif /* GAMEENGINE_HEADLESS */
@@ -0,0 +1,284 @@
+/**
+ * HeadlessAudio.c
+ *
+ * Runs the audio output driver on a Linux host, refilling the model of
+ * the audio controller in HeadlessCodec.c from the sequencer and the
+ * synthesiser while the model's DAC takes frames at exactly 48kHz, and
+ * checks:
+ *
+ *  - refills every millisecond, and at random intervals never longer
+ *    than the FIFOs last, never let the DAC run out, and every frame the
+ *    sequence renders is played in order;
+ *  - late refills: every run of frames the DAC missed is counted as an
+ *    underrun by AUDIOOUTPUT_fill, and no audio is lost, only late;
+ *  - a source running dry is the end of the audio, not an underrun;
+ *  - in every test the fill level histogram, the underruns and the
+ *    longest gap between refills recorded by AUDIOOUTPUT_fill match the
+ *    levels the model saw, the runs it missed and the refill times.
+ *
+ * The time is virtual: each step moves Timer_advanceHardware and the
+ * model on together, so the gaps AUDIOOUTPUT_fill measures are exact.
+ *
+ * Build with TIMER_HOST, HPS_I2C_HOST, WM8731_HOST and HEADLESS_AUDIO
+ * defined, for example:
+ *
+ *   gcc -O2 -DTIMER_HOST -DHPS_I2C_HOST -DWM8731_HOST -DHEADLESS_AUDIO
+ *       -D__forceinline=inline -IGTDrivers -IMathClub
+ *       GTDrivers/Timer/Timer.c GTDrivers/HPS_I2C/HPS_I2C.c
+ *       GTDrivers/DE1SoC_WM8731/DE1SoC_WM8731.c GTDrivers/Audio/AudioOutput.c
+ *       GTDrivers/Audio/AudioSynth.c GTDrivers/Audio/AudioSequencer.c
+ *       GTDrivers/Audio/WaveTable.c MathClub/GameEngine/MenuMusic.c
+ *       MathClub/Headless/HeadlessI2CBus.c MathClub/Headless/HeadlessCodec.c
+ *       MathClub/Headless/HeadlessAudio.c -o headless_audio
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifdef HEADLESS_AUDIO
+
+#include <stdio.h>
+
+#include "Audio/AudioOutput.h"
+#include "Audio/AudioSequencer.h"
+#include "Audio/AudioSynth.h"
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "HPS_I2C/HPS_I2C.h"
+#include "Timer/Timer.h"
+#include "Headless/HeadlessCodec.h"
+#include "Headless/HeadlessI2CBus.h"
+
+// Address of the audio controller on the board, and of the codec on the I2C bus
+#define AUDIO_BASE 0xFF203040
+#define CODEC_ADDRESS 0x1A
+
+#define RATE 48000
+
+// Virtual time each test plays for
+#define PLAY_US (60 * 1000000ULL)
+
+// Longest refill interval that can never let full FIFOs run dry. They
+// hold 128 frames, which last 2666us at 48kHz.
+#define SAFE_US 2600
+
+// Menu music, from MenuMusic.c
+extern const Sequence menu_music;
+
+HeadlessI2CCodec codec;
+
+unsigned int checks = 0;
+unsigned int failed = 0;
+
+// Virtual time, and the refills of the test so far with the gap between them
+unsigned long long now_us = 0;
+unsigned int refills = 0;
+unsigned long long previous_refill_ms = 0;
+unsigned int expected_gap_ms = 0;
+
+// Frames rendered by the reference renders
+signed int reference_left[AUDIOOUTPUT_BLOCK_FRAMES];
+signed int reference_right[AUDIOOUTPUT_BLOCK_FRAMES];
+
+// xorshift64, so the refill times are the same on every run
+unsigned long long random_state = 0x9E3779B97F4A7C15ULL;
+unsigned long long random64(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+void check(bool ok, const char *what) {
+    checks++;
+    if (ok) return;
+    failed++;
+    printf("  FAILED: %s\n", what);
+}
+
+// Moves the time on for the driver and the DAC together
+void advance(unsigned int us) {
+    Timer_advanceHardware(us);
+    HeadlessCodec_advance(us);
+    now_us += us;
+}
+
+// Refills the FIFOs as the main loop would, noting the gap since the last
+// refill. The sources in these tests play from the first refill to the
+// last, so every gap after the first refill counts.
+void refill(AudioSource *source) {
+    unsigned long long now_ms = now_us / 1000;
+    AUDIOOUTPUT_fill(source, AUDIOOUTPUT_FIFO_DEPTH);
+    if (refills && (now_ms - previous_refill_ms > expected_gap_ms)) expected_gap_ms = (unsigned int)(now_ms - previous_refill_ms);
+    previous_refill_ms = now_ms;
+    refills++;
+}
+
+// Starts a test with the codec initialised, the synthesiser silent and the statistics cleared
+void startTest(const char *name) {
+    printf("%s\n", name);
+    HeadlessI2CBus_reset();
+    HeadlessI2CBus_initCodec(&codec, CODEC_ADDRESS);
+    HeadlessI2CBus_attach(0, &codec.device);
+    HPS_I2C_initialise(0);
+    HeadlessCodec_reset(RATE);
+    check(WM8731_initialise(AUDIO_BASE) == WM8731_SUCCESS, "codec initialised");
+    SYNTH_initialise();
+    AUDIOOUTPUT_resetStats();
+    refills = 0;
+    expected_gap_ms = 0;
+}
+
+// Checks the statistics of AUDIOOUTPUT_fill against what the model saw
+void checkStats(void) {
+    AudioOutputStats stats;
+    const HeadlessCodecStats *model = HeadlessCodec_stats();
+    bool same = true;
+    unsigned int i;
+
+    AUDIOOUTPUT_getStats(&stats);
+    for (i = 0; i < AUDIOOUTPUT_HISTOGRAM_BINS; i++) {
+        if (stats.fill_histogram[i] != model->fill_histogram[i]) same = false;
+    }
+    check((stats.refills == refills) && (model->space_reads == refills), "every refill read the FIFO space once");
+    check(same, "the fill histogram matches the levels the model saw");
+    check(stats.underruns == model->underruns, "the underruns match the runs of frames the DAC missed");
+    check(stats.longest_gap_ms == expected_gap_ms, "the longest gap matches the refill times");
+    check(!model->overflows, "no FIFO overflow");
+    check(!model->misaligned, "the left and right FIFOs stay aligned");
+    check(model->frames_written == model->frames_played + HeadlessCodec_level(),
+          "every frame written was played or is waiting");
+    printf("  %u refills, %llu frames played, up to %u waiting, %u underruns, %llu frames missed, longest gap %u ms\n",
+           stats.refills, model->frames_played, model->max_level, model->underruns, model->frames_missed,
+           stats.longest_gap_ms);
+}
+
+// Renders the menu music from the start, as many frames as the DAC played,
+// and checks they are the frames the DAC played
+void checkSequencePlayed(void) {
+    unsigned long long frames = HeadlessCodec_stats()->frames_played;
+    unsigned int checksum = HEADLESSCODEC_CHECKSUM_START;
+    unsigned int block, i;
+
+    SYNTH_initialise();
+    SEQUENCER_play(&menu_music, true);
+    while (frames) {
+        block = (frames < AUDIOOUTPUT_BLOCK_FRAMES) ? (unsigned int)frames : AUDIOOUTPUT_BLOCK_FRAMES;
+        SEQUENCER_render(reference_left, reference_right, block, 0);
+        for (i = 0; i < block; i++) {
+            checksum = HeadlessCodec_checksum(checksum, (unsigned int)reference_left[i], (unsigned int)reference_right[i]);
+        }
+        frames -= block;
+    }
+    SEQUENCER_stop();
+    check(checksum == HeadlessCodec_stats()->checksum, "the DAC played every frame of the sequence in order");
+}
+
+void testSteadyRefills(void) {
+    const HeadlessCodecStats *model = HeadlessCodec_stats();
+    AudioOutputStats stats;
+    unsigned long long end_us;
+
+    startTest("Refills every millisecond from the sequencer");
+    SEQUENCER_play(&menu_music, true);
+    end_us = now_us + PLAY_US;
+    while (now_us < end_us) {
+        refill(SEQUENCER_getSource());
+        advance(1000);
+    }
+    SEQUENCER_stop();
+    // 48 frames are played each millisecond, so every refill after the
+    // first finds 80 of the 128 waiting
+    AUDIOOUTPUT_getStats(&stats);
+    check((model->underruns == 0) && (model->frames_missed == 0), "the DAC never ran out");
+    check(model->frames_played == (unsigned long long)refills * (RATE / 1000), "exactly 48 frames played each millisecond");
+    check((stats.fill_histogram[0] == 1) && (stats.fill_histogram[80 / (AUDIOOUTPUT_FIFO_DEPTH / AUDIOOUTPUT_HISTOGRAM_BINS)] == refills - 1),
+          "the first refill found the FIFOs empty and the rest found 80 frames");
+    checkStats();
+    checkSequencePlayed();
+}
+
+void testRandomRefills(void) {
+    const HeadlessCodecStats *model = HeadlessCodec_stats();
+    unsigned long long end_us;
+
+    startTest("Refills at random intervals up to 2.6 ms from the sequencer");
+    SEQUENCER_play(&menu_music, true);
+    end_us = now_us + PLAY_US;
+    while (now_us < end_us) {
+        refill(SEQUENCER_getSource());
+        advance(1 + (unsigned int)(random64() % SAFE_US));
+    }
+    SEQUENCER_stop();
+    check((model->underruns == 0) && (model->frames_missed == 0), "the DAC never ran out");
+    check(model->fill_histogram[AUDIOOUTPUT_HISTOGRAM_BINS - 1] > 0, "some refills found the FIFOs full");
+    checkStats();
+    checkSequencePlayed();
+}
+
+void testLateRefills(void) {
+    const HeadlessCodecStats *model = HeadlessCodec_stats();
+    AudioOutputStats stats;
+    unsigned long long end_us;
+    unsigned int late = 0;
+
+    // Mostly quick refills, many finding the FIFOs full, with 1 in 200
+    // late enough that the FIFOs must run dry
+    startTest("Late refills from the sequencer");
+    SEQUENCER_play(&menu_music, true);
+    end_us = now_us + PLAY_US;
+    while (now_us < end_us) {
+        refill(SEQUENCER_getSource());
+        if (random64() % 200 == 0) {
+            advance(5000 + (unsigned int)(random64() % 15000));
+            late++;
+        } else {
+            advance(1 + (unsigned int)(random64() % 1000));
+        }
+    }
+    // Refill once more so the last late refill is seen
+    refill(SEQUENCER_getSource());
+    SEQUENCER_stop();
+    AUDIOOUTPUT_getStats(&stats);
+    check(model->underruns == late, "the DAC ran out once for every late refill");
+    check(stats.underruns == late, "every late refill was counted as an underrun");
+    check(model->frames_missed >= (unsigned long long)late * (5 * (RATE / 1000) - AUDIOOUTPUT_FIFO_DEPTH),
+          "each late refill missed the frames due once the FIFOs ran dry");
+    checkStats();
+    checkSequencePlayed();
+}
+
+void testSourceRunsDry(void) {
+    const HeadlessCodecStats *model = HeadlessCodec_stats();
+    AudioOutputStats stats;
+    unsigned int ms;
+
+    // One note held for 200ms then released, refilled every millisecond
+    // until a second after the synthesiser has gone quiet
+    startTest("The synthesiser running dry");
+    SYNTH_noteOn(0, AUDIOOUTPUT_noteIncrement(AUDIO_NOTE(4, 9)));
+    for (ms = 0; ms < 1200; ms++) {
+        if (ms == 200) SYNTH_noteOff(0);
+        refill(SYNTH_getSource());
+        advance(1000);
+    }
+    AUDIOOUTPUT_getStats(&stats);
+    check(!SYNTH_isActive(0), "the note has finished");
+    check((model->frames_written > 200 * (RATE / 1000)) && (model->frames_played == model->frames_written),
+          "all of the note was played");
+    check((model->underruns == 0) && (stats.underruns == 0), "the end of the audio is not an underrun");
+    checkStats();
+}
+
+int main(void) {
+    Timer_setHardwareTicks(0);
+    Timer_initialise(0);
+    testSteadyRefills();
+    testRandomRefills();
+    testLateRefills();
+    testSourceRunsDry();
+    printf("%u checks, %u failed\n", checks, failed);
+    return failed ? 1 : 0;
+}
+
+#endif /* HEADLESS_AUDIO */
@@ -0,0 +1,164 @@
+/**
+ * HeadlessCodec.c
+ *
+ * Implementation of the model of the audio controller and its DAC
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "HeadlessCodec.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+
+// Control register bit that clears the output FIFOs while set
+#define MODEL_CONTROL_CLEARDAC (1 << 3)
+
+// Output FIFO of one channel
+typedef struct {
+    unsigned int samples[HEADLESSCODEC_FIFO_DEPTH];
+    unsigned int head;
+    unsigned int level;
+    unsigned long long written;  // Samples written since the reset
+} ModelFIFO;
+
+ModelFIFO model_left;
+ModelFIFO model_right;
+unsigned int model_control = 0;
+
+// Sample rate, and the time past the last frame due in microseconds times the rate
+unsigned int model_rate = 48000;
+unsigned long long model_remainder = 0;
+
+bool model_started = false;               // Audio has been written since the FIFOs were last emptied
+unsigned long long model_pending_missed;  // Frames missed since the last write
+
+HeadlessCodecStats model_stats;
+
+// FIFO Helper Functions
+
+void modelClearFIFOs(void) {
+    model_left.head = model_left.level = 0;
+    model_right.head = model_right.level = 0;
+    model_started = false;
+    model_pending_missed = 0;
+}
+
+unsigned int modelPop(ModelFIFO *fifo) {
+    unsigned int sample = fifo->samples[fifo->head];
+    fifo->head = (fifo->head + 1) % HEADLESSCODEC_FIFO_DEPTH;
+    fifo->level--;
+    return sample;
+}
+
+void modelPush(ModelFIFO *fifo, unsigned int sample) {
+    // A missed run followed by more audio was a gap that would be heard
+    if (model_pending_missed) {
+        model_stats.underruns++;
+        model_stats.frames_missed += model_pending_missed;
+        model_pending_missed = 0;
+    }
+    if (fifo->level == HEADLESSCODEC_FIFO_DEPTH) {
+        model_stats.overflows++;
+        return;
+    }
+    fifo->samples[(fifo->head + fifo->level) % HEADLESSCODEC_FIFO_DEPTH] = sample;
+    fifo->level++;
+    fifo->written++;
+    model_stats.frames_written = (model_left.written < model_right.written) ? model_left.written : model_right.written;
+    model_started = true;
+}
+
+// Plays the frames due. A frame needs a sample in both FIFOs, so if only
+// one has any the DAC stalls, which a driver keeping them aligned never sees.
+void modelPlay(unsigned long long due) {
+    unsigned int left, right;
+    while (due && model_left.level && model_right.level) {
+        left = modelPop(&model_left);
+        right = modelPop(&model_right);
+        model_stats.checksum = HeadlessCodec_checksum(model_stats.checksum, left, right);
+        model_stats.frames_played++;
+        due--;
+    }
+    if (model_started) model_pending_missed += due;
+}
+
+// Registers
+
+unsigned int WM8731_hostRead(unsigned int reg) {
+    unsigned int level, bin;
+    switch (reg) {
+        case WM8731_CONTROL:
+            return model_control;
+        case WM8731_FIFOSPACE:
+            level = HeadlessCodec_level();
+            bin = level / (HEADLESSCODEC_FIFO_DEPTH / HEADLESSCODEC_HISTOGRAM_BINS);
+            if (bin >= HEADLESSCODEC_HISTOGRAM_BINS) bin = HEADLESSCODEC_HISTOGRAM_BINS - 1;
+            model_stats.fill_histogram[bin]++;
+            model_stats.space_reads++;
+            if (level > model_stats.max_level) model_stats.max_level = level;
+            if (model_left.level != model_right.level) model_stats.misaligned++;
+            // Nothing is recorded, so the input FIFOs are always empty
+            return ((HEADLESSCODEC_FIFO_DEPTH - model_left.level) << (8 * WM8731_WSLC)) |
+                   ((HEADLESSCODEC_FIFO_DEPTH - model_right.level) << (8 * WM8731_WSRC));
+        default:
+            // Reading the FIFOs reads the input, which is silent
+            return 0;
+    }
+}
+
+void WM8731_hostWrite(unsigned int reg, unsigned int value) {
+    switch (reg) {
+        case WM8731_CONTROL:
+            model_control = value;
+            if (value & MODEL_CONTROL_CLEARDAC) modelClearFIFOs();
+            break;
+        case WM8731_LEFTFIFO:
+            modelPush(&model_left, value);
+            break;
+        case WM8731_RIGHTFIFO:
+            modelPush(&model_right, value);
+            break;
+        default:
+            break;
+    }
+}
+
+// Model Functions
+
+void HeadlessCodec_reset(unsigned int rate) {
+    modelClearFIFOs();
+    model_left.written = model_right.written = 0;
+    model_control = 0;
+    model_rate = rate;
+    model_remainder = 0;
+    memset(&model_stats, 0, sizeof(model_stats));
+    model_stats.checksum = HEADLESSCODEC_CHECKSUM_START;
+}
+
+void HeadlessCodec_advance(unsigned int us) {
+    unsigned long long due;
+    model_remainder += (unsigned long long)us * model_rate;
+    due = model_remainder / 1000000;
+    model_remainder %= 1000000;
+    modelPlay(due);
+}
+
+unsigned int HeadlessCodec_level(void) {
+    return (model_left.level < model_right.level) ? model_left.level : model_right.level;
+}
+
+const HeadlessCodecStats *HeadlessCodec_stats(void) {
+    return &model_stats;
+}
+
+// FNV-1a of the 24 bits of each sample the DAC uses
+unsigned int HeadlessCodec_checksum(unsigned int checksum, unsigned int left, unsigned int right) {
+    checksum = (checksum ^ (left & 0xFFFFFF)) * 16777619u;
+    checksum = (checksum ^ (right & 0xFFFFFF)) * 16777619u;
+    return checksum;
+}
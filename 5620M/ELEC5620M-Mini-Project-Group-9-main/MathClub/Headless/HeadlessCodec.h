@@ -0,0 +1,114 @@
+/**
+ * HeadlessCodec.h
+ *
+ * A model of the audio controller of the DE1-SoC and its WM8731 DAC, so
+ * the audio output driver runs unchanged on a Linux host. Build
+ * DE1SoC_WM8731.c and AudioOutput.c with WM8731_HOST defined and their
+ * register reads and writes come here, to the same register map as the
+ * board: the control register, the FIFO space counters and the left and
+ * right output FIFOs, each HEADLESSCODEC_FIFO_DEPTH samples deep.
+ *
+ * The DAC takes one frame from the FIFOs at exactly the sample rate.
+ * The time is kept as a whole number of frames and a remainder in
+ * microseconds times the rate, so no frame is ever gained or lost however
+ * the time is moved on. The time only moves on with HeadlessCodec_advance,
+ * which a test calls alongside Timer_advanceHardware.
+ *
+ * A frame the DAC is due to play while the FIFOs are empty is missed. A
+ * run of missed frames followed by more audio is an underrun, a gap that
+ * would be heard; silence after the last audio written is not.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef HEADLESSCODEC_H_
+#define HEADLESSCODEC_H_
+
+// Samples each output FIFO holds
+#define HEADLESSCODEC_FIFO_DEPTH 128
+
+// Bins of the fill level histogram, of HEADLESSCODEC_FIFO_DEPTH / HEADLESSCODEC_HISTOGRAM_BINS frames each
+#define HEADLESSCODEC_HISTOGRAM_BINS 8
+
+// Checksum of no frames
+#define HEADLESSCODEC_CHECKSUM_START 2166136261u
+
+/**
+ * HeadlessCodecStats
+ *
+ * What the audio controller has done since HeadlessCodec_reset.
+ **/
+typedef struct {
+    // DAC
+    unsigned long long frames_written;  // Frames written to both FIFOs
+    unsigned long long frames_played;   // Frames taken from the FIFOs by the DAC
+    unsigned long long frames_missed;   // Frames due in the underruns, with the FIFOs empty
+    unsigned int underruns;             // Runs of missed frames followed by more audio
+    unsigned int checksum;              // Of the samples played, in order, see HeadlessCodec_checksum
+
+    // FIFO space reads
+    unsigned int space_reads;
+    unsigned int fill_histogram[HEADLESSCODEC_HISTOGRAM_BINS];  // Frames waiting at each read
+    unsigned int max_level;             // Most frames seen waiting
+
+    // Mistakes of the driver
+    unsigned int overflows;             // Samples written to a full FIFO, and lost
+    unsigned int misaligned;            // Reads that found the left and right FIFOs at different levels
+} HeadlessCodecStats;
+
+/**
+ * HeadlessCodec_reset
+ *
+ * Empties the FIFOs, sets the time to 0 and clears the statistics.
+ *
+ * Inputs:
+ * 		rate:	sample rate of the DAC in Hz
+ **/
+void HeadlessCodec_reset(unsigned int rate);
+
+/**
+ * HeadlessCodec_advance
+ *
+ * Moves the time on, playing every frame due meanwhile.
+ *
+ * Inputs:
+ * 		us:	time to move on in microseconds
+ **/
+void HeadlessCodec_advance(unsigned int us);
+
+/**
+ * HeadlessCodec_level
+ *
+ * Outputs:
+ * 		Frames waiting in the FIFOs, the fewer of the left and right
+ **/
+unsigned int HeadlessCodec_level(void);
+
+/**
+ * HeadlessCodec_stats
+ *
+ * Outputs:
+ * 		What the audio controller has done since the last reset
+ **/
+const HeadlessCodecStats *HeadlessCodec_stats(void);
+
+/**
+ * HeadlessCodec_checksum
+ *
+ * Adds a frame to a checksum, the same way the DAC adds each frame it
+ * plays to the checksum in the statistics, so a test can check the
+ * frames played against frames it renders itself.
+ *
+ * Inputs:
+ * 		checksum:	checksum so far, HEADLESSCODEC_CHECKSUM_START to start
+ * 		left:		left sample
+ * 		right:		right sample
+ *
+ * Outputs:
+ * 		New checksum
+ **/
+unsigned int HeadlessCodec_checksum(unsigned int checksum, unsigned int left, unsigned int right);
+
+#endif /* HEADLESSCODEC_H_ */
@@ -0,0 +1,172 @@
+/**
+ * HeadlessDisk.c
+ *
+ * Implementation of the disk image in memory, and the FatFS disk
+ * functions that read and write it
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "HeadlessDisk.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "FatFS/diskio.h"
+
+// Entries in the root directory, which fill whole sectors
+#define DISK_ROOT_ENTRIES 512
+#define DISK_ENTRY_SIZE 32
+
+// Clusters a FAT16 volume has, as FatFS counts them
+#define DISK_MIN_FAT16_CLUSTERS 0xFF6
+#define DISK_MAX_FAT16_CLUSTERS 0xFFF5
+
+unsigned char *disk_image = 0;
+unsigned int disk_sectors = 0;
+HeadlessDiskBusy disk_busy = 0;
+HeadlessDiskStats disk_stats;
+
+// Image Helper Functions
+
+void diskStore16(unsigned char *bytes, unsigned int value) {
+    bytes[0] = (unsigned char)value;
+    bytes[1] = (unsigned char)(value >> 8);
+}
+
+void diskStore32(unsigned char *bytes, unsigned int value) {
+    diskStore16(bytes, value & 0xFFFF);
+    diskStore16(bytes + 2, value >> 16);
+}
+
+// Counts a command and the time it takes
+void diskCommand(unsigned int count, bool read) {
+    unsigned int us = HEADLESSDISK_COMMAND_US + count * HEADLESSDISK_SECTOR_US;
+    if (read) {
+        disk_stats.reads++;
+        disk_stats.sectors_read += count;
+    } else {
+        disk_stats.writes++;
+        disk_stats.sectors_written += count;
+    }
+    disk_stats.busy_us += us;
+    if (us > disk_stats.longest_us) disk_stats.longest_us = us;
+    if (disk_busy) disk_busy(us);
+}
+
+// Model Functions
+
+bool HeadlessDisk_format(unsigned int sectors, unsigned int cluster_sectors) {
+    unsigned int root_sectors = DISK_ROOT_ENTRIES * DISK_ENTRY_SIZE / HEADLESSDISK_SECTOR_SIZE;
+    unsigned int fat_sectors, clusters, fat;
+    unsigned char *boot, *fat_start;
+
+    // Each FAT has a 2 byte entry for every cluster and the two reserved entries.
+    // Size them for the most clusters there could be, as the FATs take some.
+    clusters = (sectors - 1 - root_sectors) / cluster_sectors;
+    fat_sectors = ((clusters + 2) * 2 + HEADLESSDISK_SECTOR_SIZE - 1) / HEADLESSDISK_SECTOR_SIZE;
+    clusters = (sectors - 1 - 2 * fat_sectors - root_sectors) / cluster_sectors;
+    if ((clusters < DISK_MIN_FAT16_CLUSTERS) || (clusters > DISK_MAX_FAT16_CLUSTERS)) return false;
+
+    free(disk_image);
+    disk_image = calloc(sectors, HEADLESSDISK_SECTOR_SIZE);
+    disk_sectors = disk_image ? sectors : 0;
+    if (!disk_image) return false;
+
+    // Boot sector, with one reserved sector, two FATs, and a media byte
+    // for a fixed disk
+    boot = disk_image;
+    memcpy(boot, "\xEB\x3C\x90" "MSDOS5.0", 11);
+    diskStore16(boot + 11, HEADLESSDISK_SECTOR_SIZE);
+    boot[13] = (unsigned char)cluster_sectors;
+    diskStore16(boot + 14, 1);
+    boot[16] = 2;
+    diskStore16(boot + 17, DISK_ROOT_ENTRIES);
+    if (sectors < 0x10000) {
+        diskStore16(boot + 19, sectors);
+    } else {
+        diskStore32(boot + 32, sectors);
+    }
+    boot[21] = 0xF8;
+    diskStore16(boot + 22, fat_sectors);
+    diskStore16(boot + 24, 63);
+    diskStore16(boot + 26, 255);
+    boot[36] = 0x80;
+    boot[38] = 0x29;
+    diskStore32(boot + 39, 0x20261019);
+    memcpy(boot + 43, "NO NAME    FAT16   ", 19);
+    boot[510] = 0x55;
+    boot[511] = 0xAA;
+
+    // The first two FAT entries hold the media byte and end of chain
+    for (fat = 0; fat < 2; fat++) {
+        fat_start = disk_image + (1 + fat * fat_sectors) * HEADLESSDISK_SECTOR_SIZE;
+        diskStore16(fat_start, 0xFFF8);
+        diskStore16(fat_start + 2, 0xFFFF);
+    }
+    HeadlessDisk_resetStats();
+    return true;
+}
+
+void HeadlessDisk_setBusy(HeadlessDiskBusy busy) {
+    disk_busy = busy;
+}
+
+const HeadlessDiskStats *HeadlessDisk_stats(void) {
+    return &disk_stats;
+}
+
+void HeadlessDisk_resetStats(void) {
+    memset(&disk_stats, 0, sizeof(disk_stats));
+}
+
+// FatFS Disk Functions
+
+DSTATUS disk_status(BYTE pdrv) {
+    if ((pdrv != 0) || !disk_image) return STA_NOINIT;
+    return 0;
+}
+
+DSTATUS disk_initialize(BYTE pdrv) {
+    return disk_status(pdrv);
+}
+
+DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count) {
+    if (pdrv != 0) return RES_PARERR;
+    if (!disk_image) return RES_NOTRDY;
+    if ((sector >= disk_sectors) || (count > disk_sectors - sector)) return RES_PARERR;
+    memcpy(buff, disk_image + (size_t)sector * HEADLESSDISK_SECTOR_SIZE, (size_t)count * HEADLESSDISK_SECTOR_SIZE);
+    diskCommand(count, true);
+    return RES_OK;
+}
+
+DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count) {
+    if (pdrv != 0) return RES_PARERR;
+    if (!disk_image) return RES_NOTRDY;
+    if ((sector >= disk_sectors) || (count > disk_sectors - sector)) return RES_PARERR;
+    memcpy(disk_image + (size_t)sector * HEADLESSDISK_SECTOR_SIZE, buff, (size_t)count * HEADLESSDISK_SECTOR_SIZE);
+    diskCommand(count, false);
+    return RES_OK;
+}
+
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff) {
+    if (pdrv != 0) return RES_PARERR;
+    if (!disk_image) return RES_NOTRDY;
+    switch (cmd) {
+        case CTRL_SYNC:
+            return RES_OK;
+        case GET_SECTOR_COUNT:
+            *(DWORD *)buff = disk_sectors;
+            return RES_OK;
+        case GET_SECTOR_SIZE:
+            *(WORD *)buff = HEADLESSDISK_SECTOR_SIZE;
+            return RES_OK;
+        case GET_BLOCK_SIZE:
+            *(DWORD *)buff = 1;
+            return RES_OK;
+        default:
+            return RES_PARERR;
+    }
+}
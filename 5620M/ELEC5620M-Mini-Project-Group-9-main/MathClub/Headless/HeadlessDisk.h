@@ -0,0 +1,84 @@
+/**
+ * HeadlessDisk.h
+ *
+ * A disk image in memory standing in for the SD card, so FatFS and the
+ * drivers that use it run unchanged on a Linux host. Build FatFS with
+ * HeadlessDisk.c instead of diskio_cyclonev.c and its sector reads and
+ * writes come here.
+ *
+ * HeadlessDisk_format makes an empty FAT16 volume, which FatFS mounts
+ * like a card. FatFS can't format a volume in this build, but it can
+ * write, so a test creates its files with f_open and f_write.
+ *
+ * Each command takes time, as the card would: HEADLESSDISK_COMMAND_US
+ * and HEADLESSDISK_SECTOR_US for each sector. The time is given to a
+ * busy function, so a test can move its virtual time on while the CPU
+ * waits for the card. The times are estimates, so change them to
+ * measured times to model a particular card.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef HEADLESSDISK_H_
+#define HEADLESSDISK_H_
+
+#include <stdbool.h>
+
+#define HEADLESSDISK_SECTOR_SIZE 512
+
+// Estimated time of a read or write command, and of each sector it moves
+#define HEADLESSDISK_COMMAND_US 200
+#define HEADLESSDISK_SECTOR_US 25
+
+// Called with the time each command takes
+typedef void (*HeadlessDiskBusy)(unsigned int us);
+
+/**
+ * HeadlessDiskStats
+ *
+ * What the disk has done since it was formatted or the statistics reset.
+ **/
+typedef struct {
+    unsigned int reads;               // Read commands
+    unsigned long long sectors_read;
+    unsigned int writes;              // Write commands
+    unsigned long long sectors_written;
+    unsigned long long busy_us;       // Time taken by all commands
+    unsigned int longest_us;          // Longest time taken by one command
+} HeadlessDiskStats;
+
+/**
+ * HeadlessDisk_format
+ *
+ * Makes a disk image of an empty FAT16 volume, replacing any image before.
+ *
+ * Inputs:
+ * 		sectors:			size of the disk
+ * 		cluster_sectors:	sectors in each cluster, a power of 2
+ *
+ * Outputs:
+ * 		true if the volume was made, false if there is no memory for it
+ * 		or the number of clusters would not make it FAT16
+ **/
+bool HeadlessDisk_format(unsigned int sectors, unsigned int cluster_sectors);
+
+/**
+ * HeadlessDisk_setBusy
+ *
+ * Inputs:
+ * 		busy:	function given the time of each command, or 0 for none
+ **/
+void HeadlessDisk_setBusy(HeadlessDiskBusy busy);
+
+/**
+ * HeadlessDisk_stats, HeadlessDisk_resetStats
+ *
+ * Outputs:
+ * 		What the disk has done since the statistics were last reset
+ **/
+const HeadlessDiskStats *HeadlessDisk_stats(void);
+void HeadlessDisk_resetStats(void);
+
+#endif /* HEADLESSDISK_H_ */
@@ -0,0 +1,363 @@
+/**
+ * HeadlessI2C.c
+ *
+ * Runs the HPS I2C driver and the WM8731 driver on a Linux host, against
+ * the model of the I2C controller in HeadlessI2CBus.c, and checks:
+ *
+ *  - submit, service and wait: blocking writes and reads, and a queued
+ *    transaction finished by polling the service, with its callback;
+ *  - RX FIFO throttling: a read far longer than the RX FIFO, serviced
+ *    rarely, must never ask for more bytes than the FIFO can hold;
+ *  - chaining: transactions to the same address must all go out back to
+ *    back without the CPU, while one to another address waits for the
+ *    bus to be idle before the target address changes;
+ *  - TX abort: every transaction loaded when a device fails to
+ *    acknowledge must fail with HPS_I2C_ABORTED, including one part
+ *    loaded. Commands loaded after the abort, before the driver sees it,
+ *    are thrown away by the controller, so only a run of transactions
+ *    from the front of the queue may fail, and one submitted after must
+ *    succeed;
+ *  - the WM8731 batch: initialisation must send nine writes back to
+ *    back in the power up order, leaving the codec registers at their
+ *    initial values, and later changes must send only what changed.
+ *
+ * Build with HPS_I2C_HOST, WM8731_HOST and HEADLESS_I2C defined, for example:
+ *
+ *   gcc -O2 -DHPS_I2C_HOST -DWM8731_HOST -DHEADLESS_I2C -D__forceinline=inline
+ *       -IGTDrivers -IMathClub GTDrivers/HPS_I2C/HPS_I2C.c
+ *       GTDrivers/DE1SoC_WM8731/DE1SoC_WM8731.c
+ *       MathClub/Headless/HeadlessI2CBus.c MathClub/Headless/HeadlessCodec.c
+ *       MathClub/Headless/HeadlessI2C.c -o headless_i2c
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifdef HEADLESS_I2C
+
+#include <stdio.h>
+#include <string.h>
+
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "HPS_I2C/HPS_I2C.h"
+#include "Headless/HeadlessI2CBus.h"
+
+// Addresses of the model devices, and one with nothing there
+#define MEMORY_ADDRESS 0x53
+#define OTHER_ADDRESS 0x1D
+#define MISSING_ADDRESS 0x22
+#define CODEC_ADDRESS 0x1A
+
+// Time on the bus of a transfer of a number of bytes
+#define TRANSFER_NS(bytes) \
+    ((HEADLESSI2CBUS_START_BITS + (bytes) * HEADLESSI2CBUS_BYTE_BITS + HEADLESSI2CBUS_STOP_BITS) * HEADLESSI2CBUS_BIT_NS)
+
+HeadlessI2CMemory memory;
+HeadlessI2CMemory other;
+HeadlessI2CCodec codec;
+
+unsigned int checks = 0;
+unsigned int failed = 0;
+
+// Bytes the driver had sent at the start of the test
+unsigned int bytes_sent = 0;
+
+// Completions seen by the callback, in order
+#define MAX_COMPLETIONS 16
+signed int completion_status[MAX_COMPLETIONS];
+unsigned int completion_id[MAX_COMPLETIONS];
+unsigned int completions = 0;
+
+void check(bool ok, const char *what) {
+    checks++;
+    if (ok) return;
+    failed++;
+    printf("  FAILED: %s\n", what);
+}
+
+void completed(signed int status, void *context) {
+    if (completions < MAX_COMPLETIONS) {
+        completion_status[completions] = status;
+        completion_id[completions] = *(unsigned int *)context;
+    }
+    completions++;
+}
+
+// Fills in a transaction that calls completed with its id
+void setTransaction(HPS_I2C_Transaction *transaction, unsigned int *id, unsigned char address,
+                    const unsigned char *write_data, unsigned int write_length, unsigned char *read_data,
+                    unsigned int read_length) {
+    transaction->address = address;
+    transaction->write_data = write_data;
+    transaction->write_length = write_length;
+    transaction->read_data = read_data;
+    transaction->read_length = read_length;
+    transaction->callback = &completed;
+    transaction->context = id;
+}
+
+// Starts a test with the controller and devices as at power on
+void startTest(const char *name) {
+    printf("%s\n", name);
+    HeadlessI2CBus_reset();
+    HeadlessI2CBus_initMemory(&memory, MEMORY_ADDRESS);
+    HeadlessI2CBus_initMemory(&other, OTHER_ADDRESS);
+    HeadlessI2CBus_initCodec(&codec, CODEC_ADDRESS);
+    HeadlessI2CBus_attach(0, &memory.device);
+    HeadlessI2CBus_attach(0, &other.device);
+    HeadlessI2CBus_attach(0, &codec.device);
+    HPS_I2C_initialise(0);
+    completions = 0;
+    bytes_sent = HPS_I2C_getBytesSent(0);
+}
+
+// Checks the driver made none of the mistakes the model counts
+void checkNoMistakes(void) {
+    const HeadlessI2CStats *stats = HeadlessI2CBus_stats(0);
+    check(!stats->tx_overflows, "no TX FIFO overflow");
+    check(!stats->rx_overflows, "no RX FIFO overflow");
+    check(!stats->rx_underflows, "no read of an empty RX FIFO");
+    check(!stats->target_changes_busy, "no target address change while the bus was in use");
+    check(HPS_I2C_isIdle(0) && HeadlessI2CBus_isIdle(0), "driver and bus idle at the end");
+}
+
+void testSubmitServiceWait(void) {
+    static const unsigned char write_data[] = {0x10, 0xA1, 0xB2, 0xC3};
+    static const unsigned char pointer[] = {0x11};
+    unsigned char read_data[3];
+    HPS_I2C_Transaction transaction;
+    unsigned int id = 7;
+    unsigned int polls = 0;
+    signed int status;
+
+    startTest("Submit, service and wait");
+    // Blocking write, then a write then read with a repeated start
+    status = HPS_I2C_write(0, MEMORY_ADDRESS, (unsigned char *)write_data, sizeof(write_data));
+    check(status == HPS_I2C_SUCCESS, "blocking write succeeds");
+    check(!memcmp(&memory.memory[0x10], &write_data[1], 3), "memory holds the bytes written");
+    status = HPS_I2C_read(0, MEMORY_ADDRESS, pointer, 1, read_data, 2);
+    check(status == HPS_I2C_SUCCESS, "blocking read succeeds");
+    check((read_data[0] == 0xB2) && (read_data[1] == 0xC3), "read returns the bytes written");
+    check(HeadlessI2CBus_stats(0)->restarts == 1, "read turns the bus around with a repeated start");
+
+    // A queued transaction stays pending until the bus has sent it
+    memory.memory[0x40] = 0x5A;
+    memory.memory[0x41] = 0x3C;
+    setTransaction(&transaction, &id, MEMORY_ADDRESS, (const unsigned char *)"\x40", 1, read_data, 2);
+    status = HPS_I2C_submit(0, &transaction);
+    check((status == HPS_I2C_SUCCESS) && (transaction.status == HPS_I2C_PENDING), "submit queues and returns");
+    while ((transaction.status == HPS_I2C_PENDING) && (polls < 1000)) {
+        HeadlessI2CBus_advance(10);
+        HPS_I2C_service(0);
+        polls++;
+    }
+    check(transaction.status == HPS_I2C_SUCCESS, "service finishes the transaction");
+    check((completions == 1) && (completion_status[0] == HPS_I2C_SUCCESS) && (completion_id[0] == 7),
+          "callback called once with success and its context");
+    check((read_data[0] == 0x5A) && (read_data[1] == 0x3C), "queued read returns the memory");
+    check(HPS_I2C_wait(0, &transaction) == HPS_I2C_SUCCESS, "wait on a finished transaction returns its status");
+    check(HPS_I2C_getBytesSent(0) - bytes_sent == sizeof(write_data) + 2, "bytes sent counts the bytes written");
+    printf("  finished after %u polls of 10us, %llu ns on the bus\n", polls, HeadlessI2CBus_stats(0)->busy_ns);
+    checkNoMistakes();
+}
+
+void testRXThrottling(void) {
+    static unsigned char read_data[1000];
+    HPS_I2C_Transaction transaction;
+    const HeadlessI2CStats *stats = HeadlessI2CBus_stats(0);
+    unsigned int id = 1;
+    unsigned int polls = 0;
+    unsigned int i;
+    bool match = true;
+
+    startTest("RX FIFO throttling");
+    for (i = 0; i < 256; i++) memory.memory[i] = (unsigned char)(i * 7 + 3);
+    // Read 1000 bytes, servicing only every 2ms, about 80 bytes of bus time
+    setTransaction(&transaction, &id, MEMORY_ADDRESS, (const unsigned char *)"\x00", 1, read_data, sizeof(read_data));
+    HPS_I2C_submit(0, &transaction);
+    while ((transaction.status == HPS_I2C_PENDING) && (polls < 1000)) {
+        HeadlessI2CBus_advance(2000);
+        HPS_I2C_service(0);
+        polls++;
+    }
+    for (i = 0; i < sizeof(read_data); i++) {
+        if (read_data[i] != (unsigned char)((i % 256) * 7 + 3)) match = false;
+    }
+    check(transaction.status == HPS_I2C_SUCCESS, "long read succeeds");
+    check(match, "every byte read is right and in order");
+    check(stats->bytes_read == sizeof(read_data), "exactly the bytes asked for are read");
+    check(stats->max_rx_level <= 64, "RX FIFO never holds more than 64 bytes");
+    check(stats->held_ns > 0, "bus held while the RX FIFO is full, rather than overflowing");
+    printf("  %u services, RX FIFO up to %u bytes, bus held for %llu us\n", polls, stats->max_rx_level,
+           stats->held_ns / 1000);
+    checkNoMistakes();
+}
+
+void testChaining(void) {
+    static const unsigned char data[8][3] = {{0, 1, 2}, {2, 3, 4}, {4, 5, 6}, {6, 7, 8},
+                                             {8, 9, 10}, {10, 11, 12}, {12, 13, 14}, {14, 15, 16}};
+    HPS_I2C_Transaction transactions[8];
+    unsigned int ids[8];
+    const HeadlessI2CStats *stats = HeadlessI2CBus_stats(0);
+    unsigned int i;
+    bool in_order = true;
+
+    startTest("Chaining transactions to the same address");
+    for (i = 0; i < 8; i++) {
+        ids[i] = i;
+        setTransaction(&transactions[i], &ids[i], MEMORY_ADDRESS, data[i], 3, 0, 0);
+        HPS_I2C_submit(0, &transactions[i]);
+    }
+    // Nothing more from the CPU until the bus is done
+    HeadlessI2CBus_advance(2000);
+    check(stats->stops == 8, "all eight go out without the CPU");
+    check(stats->last_stop_ns - stats->first_start_ns == stats->busy_ns, "back to back, with no gap on the bus");
+    check(stats->busy_ns == 8 * TRANSFER_NS(3), "each takes a start, three bytes and a stop");
+    check(transactions[7].status == HPS_I2C_PENDING, "still pending until serviced");
+    HPS_I2C_service(0);
+    for (i = 0; i < 8; i++) {
+        if ((transactions[i].status != HPS_I2C_SUCCESS) || (completion_id[i] != i)) in_order = false;
+    }
+    check(in_order && (completions == 8), "one service completes all eight, in order");
+    check(memory.memory[15] == 16, "the last write reached the memory");
+    printf("  8 transactions in %llu us on the bus\n", stats->busy_ns / 1000);
+    checkNoMistakes();
+
+    startTest("Transactions to different addresses");
+    for (i = 0; i < 3; i++) {
+        ids[i] = i;
+        setTransaction(&transactions[i], &ids[i], (i == 1) ? OTHER_ADDRESS : MEMORY_ADDRESS, data[i], 3, 0, 0);
+        HPS_I2C_submit(0, &transactions[i]);
+    }
+    HeadlessI2CBus_advance(2000);
+    check(stats->stops == 1, "the next address waits for the CPU to change the target");
+    HPS_I2C_service(0);
+    HeadlessI2CBus_advance(2000);
+    HPS_I2C_service(0);
+    HeadlessI2CBus_advance(2000);
+    HPS_I2C_service(0);
+    check(stats->stops == 3, "each address runs once the one before is done");
+    check((transactions[0].status == HPS_I2C_SUCCESS) && (transactions[1].status == HPS_I2C_SUCCESS) &&
+          (transactions[2].status == HPS_I2C_SUCCESS), "all succeed");
+    check((other.memory[2] == 3) && (memory.memory[5] == 6), "each device got its own write");
+    checkNoMistakes();
+}
+
+void testTXAbort(void) {
+    static unsigned char long_data[200];
+    static const unsigned char data[] = {0x20, 0x55};
+    static const unsigned char after[3][2] = {{0xF0, 0x66}, {0xF1, 0x77}, {0xF2, 0x88}};
+    HPS_I2C_Transaction transactions[4];
+    unsigned int ids[4] = {0, 1, 2, 3};
+    const HeadlessI2CStats *stats = HeadlessI2CBus_stats(0);
+    bool prefix = true;
+    bool landed = true;
+    unsigned int i;
+
+    startTest("TX abort of a missing device");
+    // Three chained to a missing device are all loaded, then one to the memory
+    for (i = 0; i < 3; i++) {
+        setTransaction(&transactions[i], &ids[i], MISSING_ADDRESS, data, 2, 0, 0);
+        HPS_I2C_submit(0, &transactions[i]);
+    }
+    setTransaction(&transactions[3], &ids[3], MEMORY_ADDRESS, data, 2, 0, 0);
+    HPS_I2C_submit(0, &transactions[3]);
+    HPS_I2C_wait(0, &transactions[3]);
+    check((transactions[0].status == HPS_I2C_ABORTED) && (transactions[1].status == HPS_I2C_ABORTED) &&
+          (transactions[2].status == HPS_I2C_ABORTED), "every loaded transaction is aborted");
+    check(transactions[3].status == HPS_I2C_SUCCESS, "the transaction after still succeeds");
+    check((completions == 4) && (completion_status[0] == HPS_I2C_ABORTED) && (completion_status[2] == HPS_I2C_ABORTED) &&
+          (completion_status[3] == HPS_I2C_SUCCESS), "each callback called once with its status");
+    check((stats->aborts == 1) && (stats->commands_flushed == 5), "one abort flushed the rest of the loaded commands");
+    check(memory.memory[0x20] == 0x55, "the memory got its write");
+    check(HPS_I2C_getBytesSent(0) - bytes_sent == 2, "aborted transactions are not counted as sent");
+    checkNoMistakes();
+
+    startTest("TX abort part way through a long write");
+    // The memory stops acknowledging at byte 100 of a 200 byte write, which
+    // is more than the TX FIFO holds, so it is only part loaded. Commands the
+    // driver loads after the abort, before it sees it, are thrown away, so
+    // those transactions must be aborted too. The rest must succeed.
+    memory.nack_at = 100;
+    for (i = 0; i < sizeof(long_data); i++) long_data[i] = (unsigned char)i;
+    setTransaction(&transactions[0], &ids[0], MEMORY_ADDRESS, long_data, sizeof(long_data), 0, 0);
+    setTransaction(&transactions[1], &ids[1], MEMORY_ADDRESS, after[0], 2, 0, 0);
+    setTransaction(&transactions[2], &ids[2], MEMORY_ADDRESS, after[1], 2, 0, 0);
+    for (i = 0; i < 3; i++) HPS_I2C_submit(0, &transactions[i]);
+    HPS_I2C_wait(0, &transactions[2]);
+    for (i = 0; i < 3; i++) {
+        if ((i > 0) && (transactions[i].status == HPS_I2C_ABORTED) && (transactions[i - 1].status != HPS_I2C_ABORTED)) {
+            prefix = false;
+        }
+        if ((i > 0) && (transactions[i].status == HPS_I2C_SUCCESS) && (memory.memory[after[i - 1][0]] != after[i - 1][1])) {
+            landed = false;
+        }
+    }
+    check(transactions[0].status == HPS_I2C_ABORTED, "the part loaded transaction is aborted");
+    check(prefix, "only the transactions loaded before the abort are aborted");
+    check(landed, "the writes of the transactions that succeed reach the memory");
+    check(completions == 3, "each callback called once");
+    printf("  %u of the transactions after were loaded before the abort was seen\n",
+           (transactions[1].status == HPS_I2C_ABORTED) + (transactions[2].status == HPS_I2C_ABORTED));
+    setTransaction(&transactions[3], &ids[3], MEMORY_ADDRESS, after[2], 2, 0, 0);
+    HPS_I2C_submit(0, &transactions[3]);
+    check(HPS_I2C_wait(0, &transactions[3]) == HPS_I2C_SUCCESS, "a transaction submitted after the abort succeeds");
+    check(memory.memory[after[2][0]] == after[2][1], "and its write reaches the memory");
+    check(stats->aborts == 1, "one abort");
+    checkNoMistakes();
+}
+
+void testCodecBatch(void) {
+    // Initialisation: power with the output off, the input pair, the output
+    // pair, analogue path, digital path, format, sampling, active, then power
+    static const unsigned int init_registers[9] = {6, 0, 2, 4, 5, 7, 8, 9, 6};
+    static const unsigned short init_values[9] = {0x12, 0x117, 0x170, 0x12, 0x06, 0x4E, 0x00, 0x01, 0x02};
+    static const unsigned short codec_values[10] = {0x17, 0x17, 0x70, 0x70, 0x12, 0x06, 0x02, 0x4E, 0x00, 0x01};
+    const HeadlessI2CStats *stats = HeadlessI2CBus_stats(0);
+    unsigned int i;
+    bool match = true;
+    signed int status;
+
+    startTest("WM8731 batch");
+    // With no audio controller only the I2C side is set up
+    status = WM8731_initialise(0);
+    check(status == WM8731_ERRORNOINIT, "initialise with no base address sets up the codec only");
+    for (i = 0; i < 9; i++) {
+        if ((codec.log_registers[i] != init_registers[i]) || (codec.log_values[i] != init_values[i])) match = false;
+    }
+    check(codec.writes == 9, "initialisation sends nine writes");
+    check(match, "in the power up order, with the left/right pairs as one write each");
+    check(!memcmp(codec.registers, codec_values, sizeof(codec_values)), "codec registers end at their initial values");
+    check(!codec.bad_transfers, "every transfer is one 16bit command");
+    check(stats->last_stop_ns - stats->first_start_ns == stats->busy_ns, "the batch goes out back to back");
+    check(stats->busy_ns == 9 * TRANSFER_NS(2), "each write takes a start, two bytes and a stop");
+    check(HPS_I2C_getBytesSent(0) - bytes_sent == 18, "eighteen bytes sent");
+    printf("  nine writes in %llu us on the bus\n", stats->busy_ns / 1000);
+
+    WM8731_setOutputVolume(-10);
+    check((codec.writes == 10) && (codec.log_registers[9] == 2) && (codec.log_values[9] == (0x100 | 0x80 | 0x6F)),
+          "a volume change is one write to both outputs");
+    check((codec.registers[2] == (0x80 | 0x6F)) && (codec.registers[3] == (0x80 | 0x6F)), "both outputs change");
+    WM8731_setSampleRate(32000);
+    check((codec.writes == 14) && (codec.log_registers[10] == 9) && (codec.log_values[10] == 0) &&
+          (codec.log_registers[11] == 5) && (codec.log_registers[12] == 8) && (codec.log_registers[13] == 9) &&
+          (codec.log_values[13] == 1), "a sample rate change stops the interface while it changes");
+    check((codec.registers[8] == (0x6 << 2)) && (codec.registers[5] == 0x02),
+          "sampling and de-emphasis set for 32kHz");
+    WM8731_commit();
+    check(codec.writes == 14, "a commit with nothing changed sends nothing");
+    checkNoMistakes();
+}
+
+int main(void) {
+    testSubmitServiceWait();
+    testRXThrottling();
+    testChaining();
+    testTXAbort();
+    testCodecBatch();
+    printf("%u checks, %u failed\n", checks, failed);
+    return failed ? 1 : 0;
+}
+
+#endif /* HEADLESS_I2C */
@@ -0,0 +1,406 @@
+/**
+ * HeadlessI2CBus.c
+ *
+ * Implementation of the model of the HPS I2C controllers and devices
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "HeadlessI2CBus.h"
+
+#include <string.h>
+
+#include "HPS_I2C/HPS_I2C.h"
+
+// Register offsets in words, from the HPS Technical Reference Manual
+#define MODEL_CON (0x00 / 4)
+#define MODEL_TAR (0x04 / 4)
+#define MODEL_DATCMD (0x10 / 4)
+#define MODEL_IRQFLG (0x2C / 4)
+#define MODEL_IRQMSK (0x30 / 4)
+#define MODEL_IRQRAW (0x34 / 4)
+#define MODEL_RXTL (0x38 / 4)
+#define MODEL_TXTL (0x3C / 4)
+#define MODEL_CLRTXA (0x54 / 4)
+#define MODEL_CLRSTP (0x60 / 4)
+#define MODEL_ENABLE (0x6C / 4)
+#define MODEL_STATUS (0x70 / 4)
+#define MODEL_TXFLR (0x74 / 4)
+#define MODEL_RXFLR (0x78 / 4)
+#define MODEL_REGISTERS (0x80 / 4)
+
+// Data command bits
+#define MODEL_CMD_READ (1 << 8)
+#define MODEL_CMD_STOP (1 << 9)
+#define MODEL_CMD_RESTART (1 << 10)
+
+// IRQ bits
+#define MODEL_IRQ_RXFULL (1 << 2)
+#define MODEL_IRQ_TXEMPTY (1 << 4)
+#define MODEL_IRQ_TXABORT (1 << 6)
+#define MODEL_IRQ_STOP (1 << 9)
+
+// Status bits
+#define MODEL_STATUS_ACTIVITY (1 << 0)
+#define MODEL_STATUS_TFNF (1 << 1)
+#define MODEL_STATUS_TFE (1 << 2)
+#define MODEL_STATUS_RFNE (1 << 3)
+#define MODEL_STATUS_RFF (1 << 4)
+#define MODEL_STATUS_MSTACT (1 << 5)
+
+#define MODEL_FIFO_DEPTH 64
+
+// A controller and its bus
+typedef struct {
+    unsigned int registers[MODEL_REGISTERS];  // Registers that just hold what was written
+    unsigned short tx[MODEL_FIFO_DEPTH];      // Command FIFO
+    unsigned int tx_head;
+    unsigned int tx_level;
+    unsigned char rx[MODEL_FIFO_DEPTH];       // Read data FIFO
+    unsigned int rx_head;
+    unsigned int rx_level;
+    bool tx_abort;                            // Raw IRQ flags
+    bool stop_detected;
+    bool active;                              // A transfer has started and not yet stopped
+    bool reading;                             // Direction of the transfer
+    HeadlessI2CDevice *target;                // Device of the transfer, or 0 if none acknowledged
+    bool busy;                                // Sending command from command_ns to busy_until_ns
+    unsigned short command;
+    unsigned long long command_ns;
+    unsigned long long busy_until_ns;
+    unsigned long long bus_ns;                // Time the bus has been run up to
+    HeadlessI2CDevice *devices;
+    HeadlessI2CStats stats;
+} ModelController;
+
+ModelController model_controllers[2];
+unsigned long long model_now_ns = 0;
+
+// Bus Helper Functions
+
+HeadlessI2CDevice *modelFindDevice(ModelController *controller, unsigned int address) {
+    HeadlessI2CDevice *device;
+    for (device = controller->devices; device; device = device->next) {
+        if (device->address == address) return device;
+    }
+    return 0;
+}
+
+// Ends a transfer with a stop condition
+void modelStop(ModelController *controller) {
+    if (controller->target && controller->target->stop) controller->target->stop(controller->target->context);
+    controller->target = 0;
+    controller->active = false;
+    controller->stop_detected = true;
+    controller->stats.last_stop_ns = controller->bus_ns;
+}
+
+// Aborts a transfer that was not acknowledged. The TX FIFO is flushed
+// and the bus released.
+void modelAbort(ModelController *controller) {
+    controller->stats.aborts++;
+    controller->stats.commands_flushed += controller->tx_level;
+    controller->tx_level = 0;
+    controller->tx_abort = true;
+    modelStop(controller);
+}
+
+// Finishes the command being sent
+void modelFinishCommand(ModelController *controller) {
+    unsigned short command = controller->command;
+    bool read = (command & MODEL_CMD_READ) != 0;
+    HeadlessI2CDevice *device;
+    unsigned char data;
+
+    controller->busy = false;
+    // A start, or a repeated start to turn the bus around
+    if (!controller->active || (command & MODEL_CMD_RESTART) || (read != controller->reading)) {
+        if (controller->active) {
+            controller->stats.restarts++;
+        } else {
+            if (!controller->stats.starts) controller->stats.first_start_ns = controller->command_ns;
+            controller->stats.starts++;
+        }
+        device = modelFindDevice(controller, controller->registers[MODEL_TAR] & 0x7F);
+        controller->active = true;
+        controller->reading = read;
+        if (!device || !device->start || !device->start(device->context, read)) {
+            controller->target = 0;
+            modelAbort(controller);
+            return;
+        }
+        controller->target = device;
+    }
+    device = controller->target;
+    if (read) {
+        data = device->read ? device->read(device->context) : 0xFF;
+        controller->stats.bytes_read++;
+        if (controller->rx_level == MODEL_FIFO_DEPTH) {
+            controller->stats.rx_overflows++;
+        } else {
+            controller->rx[(controller->rx_head + controller->rx_level++) % MODEL_FIFO_DEPTH] = data;
+            if (controller->rx_level > controller->stats.max_rx_level) controller->stats.max_rx_level = controller->rx_level;
+        }
+    } else {
+        if (!device->write || !device->write(device->context, (unsigned char)command)) {
+            modelAbort(controller);
+            return;
+        }
+        controller->stats.bytes_written++;
+    }
+    if (command & MODEL_CMD_STOP) {
+        controller->stats.stops++;
+        modelStop(controller);
+    }
+}
+
+// Runs the bus up to the model time
+void modelRun(ModelController *controller) {
+    unsigned long long bits;
+    unsigned short command;
+    bool read;
+    for (;;) {
+        if (controller->busy) {
+            if (controller->busy_until_ns > model_now_ns) break;
+            controller->bus_ns = controller->busy_until_ns;
+            modelFinishCommand(controller);
+            continue;
+        }
+        if (!controller->tx_level || !(controller->registers[MODEL_ENABLE] & 1)) break;
+        // Take the next command and work out how long it is on the bus
+        command = controller->tx[controller->tx_head];
+        controller->tx_head = (controller->tx_head + 1) % MODEL_FIFO_DEPTH;
+        controller->tx_level--;
+        read = (command & MODEL_CMD_READ) != 0;
+        bits = HEADLESSI2CBUS_BYTE_BITS;
+        if (!controller->active || (command & MODEL_CMD_RESTART) || (read != controller->reading)) {
+            bits += HEADLESSI2CBUS_START_BITS;
+        }
+        if (command & MODEL_CMD_STOP) bits += HEADLESSI2CBUS_STOP_BITS;
+        controller->command = command;
+        controller->busy = true;
+        controller->command_ns = controller->bus_ns;
+        controller->busy_until_ns = controller->bus_ns + bits * HEADLESSI2CBUS_BIT_NS;
+        controller->stats.busy_ns += bits * HEADLESSI2CBUS_BIT_NS;
+    }
+    // Nothing to send until more commands are written
+    if (!controller->busy) {
+        if (controller->active) controller->stats.held_ns += model_now_ns - controller->bus_ns;
+        controller->bus_ns = model_now_ns;
+    }
+}
+
+// Moves the time on for one register access
+ModelController *modelAccess(unsigned int controller_id) {
+    model_now_ns += HEADLESSI2CBUS_ACCESS_NS;
+    modelRun(&model_controllers[0]);
+    modelRun(&model_controllers[1]);
+    return &model_controllers[controller_id & 1];
+}
+
+// Registers
+
+unsigned int HPS_I2C_hostRead(unsigned int controller_id, unsigned int reg) {
+    ModelController *controller = modelAccess(controller_id);
+    unsigned int value;
+    switch (reg) {
+        case MODEL_DATCMD:
+            if (!controller->rx_level) {
+                controller->stats.rx_underflows++;
+                return 0;
+            }
+            value = controller->rx[controller->rx_head];
+            controller->rx_head = (controller->rx_head + 1) % MODEL_FIFO_DEPTH;
+            controller->rx_level--;
+            return value;
+        case MODEL_IRQRAW:
+        case MODEL_IRQFLG:
+            value = 0;
+            if (controller->rx_level > controller->registers[MODEL_RXTL]) value |= MODEL_IRQ_RXFULL;
+            if (controller->tx_level <= controller->registers[MODEL_TXTL]) value |= MODEL_IRQ_TXEMPTY;
+            if (controller->tx_abort) value |= MODEL_IRQ_TXABORT;
+            if (controller->stop_detected) value |= MODEL_IRQ_STOP;
+            if (reg == MODEL_IRQFLG) value &= controller->registers[MODEL_IRQMSK];
+            return value;
+        case MODEL_CLRTXA:
+            value = controller->tx_abort;
+            controller->tx_abort = false;
+            return value;
+        case MODEL_CLRSTP:
+            value = controller->stop_detected;
+            controller->stop_detected = false;
+            return value;
+        case MODEL_STATUS:
+            value = 0;
+            if (controller->active || controller->busy || controller->tx_level) value |= MODEL_STATUS_ACTIVITY;
+            if (controller->tx_level < MODEL_FIFO_DEPTH) value |= MODEL_STATUS_TFNF;
+            if (!controller->tx_level) value |= MODEL_STATUS_TFE;
+            if (controller->rx_level) value |= MODEL_STATUS_RFNE;
+            if (controller->rx_level == MODEL_FIFO_DEPTH) value |= MODEL_STATUS_RFF;
+            if (controller->active || controller->busy) value |= MODEL_STATUS_MSTACT;
+            return value;
+        case MODEL_TXFLR:
+            return controller->tx_level;
+        case MODEL_RXFLR:
+            return controller->rx_level;
+        default:
+            return (reg < MODEL_REGISTERS) ? controller->registers[reg] : 0;
+    }
+}
+
+void HPS_I2C_hostWrite(unsigned int controller_id, unsigned int reg, unsigned int value) {
+    ModelController *controller = modelAccess(controller_id);
+    switch (reg) {
+        case MODEL_DATCMD:
+            if (controller->tx_abort) {
+                // The TX FIFO stays flushed until the abort is cleared
+                controller->stats.writes_ignored++;
+            } else if (controller->tx_level == MODEL_FIFO_DEPTH) {
+                controller->stats.tx_overflows++;
+            } else {
+                controller->tx[(controller->tx_head + controller->tx_level++) % MODEL_FIFO_DEPTH] = (unsigned short)value;
+                if (controller->tx_level > controller->stats.max_tx_level) controller->stats.max_tx_level = controller->tx_level;
+                // A command written to an idle bus starts it straight away
+                modelRun(controller);
+            }
+            return;
+        case MODEL_TAR:
+            if (controller->active || controller->busy || controller->tx_level) controller->stats.target_changes_busy++;
+            controller->registers[reg] = value;
+            return;
+        case MODEL_ENABLE:
+            // Disabling flushes the FIFOs
+            if (!(value & 1)) {
+                controller->tx_level = 0;
+                controller->rx_level = 0;
+                controller->tx_abort = false;
+            }
+            controller->registers[reg] = value;
+            return;
+        default:
+            if (reg < MODEL_REGISTERS) controller->registers[reg] = value;
+            return;
+    }
+}
+
+// Model Functions
+
+void HeadlessI2CBus_reset(void) {
+    memset(model_controllers, 0, sizeof(model_controllers));
+    model_now_ns = 0;
+}
+
+void HeadlessI2CBus_attach(unsigned int controller_id, HeadlessI2CDevice *device) {
+    ModelController *controller = &model_controllers[controller_id & 1];
+    device->next = controller->devices;
+    controller->devices = device;
+}
+
+void HeadlessI2CBus_advance(unsigned int us) {
+    model_now_ns += (unsigned long long)us * 1000;
+    modelRun(&model_controllers[0]);
+    modelRun(&model_controllers[1]);
+}
+
+unsigned long long HeadlessI2CBus_nowNs(void) {
+    return model_now_ns;
+}
+
+bool HeadlessI2CBus_isIdle(unsigned int controller_id) {
+    ModelController *controller = &model_controllers[controller_id & 1];
+    return !controller->active && !controller->busy && !controller->tx_level;
+}
+
+const HeadlessI2CStats *HeadlessI2CBus_stats(unsigned int controller_id) {
+    return &model_controllers[controller_id & 1].stats;
+}
+
+// Memory Device
+
+bool memoryStart(void *context, bool read) {
+    HeadlessI2CMemory *memory = (HeadlessI2CMemory *)context;
+    if (!read) memory->pointer_set = false;
+    return true;
+}
+
+bool memoryWrite(void *context, unsigned char data) {
+    HeadlessI2CMemory *memory = (HeadlessI2CMemory *)context;
+    if (++memory->bytes_written == memory->nack_at) return false;
+    if (!memory->pointer_set) {
+        memory->pointer = data;
+        memory->pointer_set = true;
+    } else {
+        memory->memory[memory->pointer++] = data;
+    }
+    return true;
+}
+
+unsigned char memoryRead(void *context) {
+    HeadlessI2CMemory *memory = (HeadlessI2CMemory *)context;
+    return memory->memory[memory->pointer++];
+}
+
+void HeadlessI2CBus_initMemory(HeadlessI2CMemory *memory, unsigned char address) {
+    memset(memory, 0, sizeof(*memory));
+    memory->device.address = address;
+    memory->device.start = &memoryStart;
+    memory->device.write = &memoryWrite;
+    memory->device.read = &memoryRead;
+    memory->device.context = memory;
+}
+
+// Codec Device
+
+// Registers with a bit to write the same value to the right register as well
+#define CODEC_LEFTIN 0
+#define CODEC_LEFTOUT 2
+#define CODEC_BOTH (1 << 8)
+#define CODEC_RESET 15
+
+bool codecStart(void *context, bool read) {
+    HeadlessI2CCodec *codec = (HeadlessI2CCodec *)context;
+    codec->length = 0;
+    // The control port is write only
+    return !read;
+}
+
+bool codecWrite(void *context, unsigned char data) {
+    HeadlessI2CCodec *codec = (HeadlessI2CCodec *)context;
+    if (codec->length < 2) codec->command[codec->length] = data;
+    codec->length++;
+    return true;
+}
+
+void codecStop(void *context) {
+    HeadlessI2CCodec *codec = (HeadlessI2CCodec *)context;
+    unsigned int reg = codec->command[0] >> 1;
+    unsigned short value = (unsigned short)(((codec->command[0] & 1) << 8) | codec->command[1]);
+    if (codec->length != 2) {
+        if (codec->length) codec->bad_transfers++;
+        return;
+    }
+    codec->length = 0;
+    if (codec->writes < HEADLESSI2CBUS_LOG_SIZE) {
+        codec->log_registers[codec->writes] = reg;
+        codec->log_values[codec->writes] = value;
+    }
+    codec->writes++;
+    if (reg == CODEC_RESET) {
+        memset(codec->registers, 0, sizeof(codec->registers));
+    } else if (((reg == CODEC_LEFTIN) || (reg == CODEC_LEFTOUT)) && (value & CODEC_BOTH)) {
+        codec->registers[reg] = codec->registers[reg + 1] = value & ~CODEC_BOTH;
+    } else {
+        codec->registers[reg] = value;
+    }
+}
+
+void HeadlessI2CBus_initCodec(HeadlessI2CCodec *codec, unsigned char address) {
+    memset(codec, 0, sizeof(*codec));
+    codec->device.address = address;
+    codec->device.start = &codecStart;
+    codec->device.write = &codecWrite;
+    codec->device.stop = &codecStop;
+    codec->device.context = codec;
+}
@@ -0,0 +1,200 @@
+/**
+ * HeadlessI2CBus.h
+ *
+ * A model of the two DesignWare I2C controllers of the HPS and the
+ * devices on their buses, so HPS_I2C runs unchanged on a Linux host.
+ * Build HPS_I2C.c with HPS_I2C_HOST defined and its register reads and
+ * writes come here, to the same register map as the board: TX and RX
+ * FIFOs 64 deep, the target address, status, raw and masked IRQs, and
+ * the TX abort and stop detect flags cleared by reading.
+ *
+ * The model keeps its own time. Each register access takes
+ * HEADLESSI2CBUS_ACCESS_NS, as the CPU would on the board, and the bus
+ * moves on at 400kHz meanwhile, so polling HPS_I2C_service sees the
+ * transfers finish. HeadlessI2CBus_advance moves the time on without
+ * touching the registers, as the bus runs while the CPU does other work.
+ *
+ * As on the controller, a command written to an empty TX FIFO starts a
+ * transfer to the target address, a command with the stop bit ends it,
+ * and the bus is held while the TX FIFO is empty before the stop. A
+ * device that does not acknowledge its address or a byte written aborts
+ * the transfer: the TX FIFO is flushed and ignores writes until the
+ * abort is cleared. Read data that arrives with the RX FIFO full is lost.
+ *
+ * Everything the driver should never do is counted in the statistics,
+ * for a test to check: overflowing either FIFO, reading an empty RX
+ * FIFO, and changing the target address while the bus is in use.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef HEADLESSI2CBUS_H_
+#define HEADLESSI2CBUS_H_
+
+#include <stdbool.h>
+
+// Time of each register access, and of one bit on the bus at 400kHz
+#define HEADLESSI2CBUS_ACCESS_NS 100
+#define HEADLESSI2CBUS_BIT_NS 2500
+
+// Bits on the bus for a start and address, a byte and its acknowledge, and a stop
+#define HEADLESSI2CBUS_START_BITS 10
+#define HEADLESSI2CBUS_BYTE_BITS 9
+#define HEADLESSI2CBUS_STOP_BITS 1
+
+/**
+ * HeadlessI2CDevice
+ *
+ * A device on a bus. The callbacks stand in for the device's side of
+ * each transfer addressed to it, and are given context.
+ **/
+typedef struct HeadlessI2CDevice HeadlessI2CDevice;
+struct HeadlessI2CDevice {
+    unsigned char address;                               // 7bit address
+    bool (*start)(void *context, bool read);             // Start or repeated start, returns true to acknowledge
+    bool (*write)(void *context, unsigned char data);    // Byte written, returns true to acknowledge
+    unsigned char (*read)(void *context);                // Byte read
+    void (*stop)(void *context);                         // Stop, or the transfer was aborted
+    void *context;
+    HeadlessI2CDevice *next;                             // Other devices on the same bus
+};
+
+/**
+ * HeadlessI2CStats
+ *
+ * What a controller has done since HeadlessI2CBus_reset.
+ **/
+typedef struct {
+    // Transfers
+    unsigned int starts;
+    unsigned int restarts;
+    unsigned int stops;               // Transfers finished with a stop
+    unsigned int aborts;              // Transfers aborted by a missing acknowledge
+    unsigned int bytes_written;       // Data bytes acknowledged, not counting addresses
+    unsigned int bytes_read;
+    unsigned int commands_flushed;    // Commands thrown away by aborts
+    unsigned int writes_ignored;      // Commands written after an abort, before it was cleared
+
+    // Bus time
+    unsigned long long busy_ns;       // Time sending bits
+    unsigned long long held_ns;       // Time the bus was held waiting for commands
+    unsigned long long first_start_ns;
+    unsigned long long last_stop_ns;
+
+    // Most seen in each FIFO
+    unsigned int max_tx_level;
+    unsigned int max_rx_level;
+
+    // Mistakes of the driver
+    unsigned int tx_overflows;        // Commands written to a full TX FIFO
+    unsigned int rx_overflows;        // Bytes read with the RX FIFO full, and lost
+    unsigned int rx_underflows;       // Reads of an empty RX FIFO
+    unsigned int target_changes_busy; // Target address written while the bus was in use
+} HeadlessI2CStats;
+
+/**
+ * HeadlessI2CBus_reset
+ *
+ * Puts both controllers back to how they are at power on, with no
+ * devices, the time at 0 and the statistics cleared.
+ **/
+void HeadlessI2CBus_reset(void);
+
+/**
+ * HeadlessI2CBus_attach
+ *
+ * Adds a device to the bus of a controller. The device belongs to the
+ * caller and must stay in memory until the next reset.
+ *
+ * Inputs:
+ * 		controller_id:	controller whose bus the device is on
+ * 		device:			device to add
+ **/
+void HeadlessI2CBus_attach(unsigned int controller_id, HeadlessI2CDevice *device);
+
+/**
+ * HeadlessI2CBus_advance
+ *
+ * Moves the time on, running both buses.
+ *
+ * Inputs:
+ * 		us:	time to move on in microseconds
+ **/
+void HeadlessI2CBus_advance(unsigned int us);
+
+/**
+ * HeadlessI2CBus_nowNs
+ *
+ * Outputs:
+ * 		Time of the model in nanoseconds
+ **/
+unsigned long long HeadlessI2CBus_nowNs(void);
+
+/**
+ * HeadlessI2CBus_isIdle
+ *
+ * Outputs:
+ * 		true if the bus of the controller is free and there are no
+ * 		commands left in its TX FIFO
+ **/
+bool HeadlessI2CBus_isIdle(unsigned int controller_id);
+
+/**
+ * HeadlessI2CBus_stats
+ *
+ * Outputs:
+ * 		What the controller has done since the last reset
+ **/
+const HeadlessI2CStats *HeadlessI2CBus_stats(unsigned int controller_id);
+
+// Devices
+
+// Most transfers each device remembers
+#define HEADLESSI2CBUS_LOG_SIZE 64
+
+/**
+ * HeadlessI2CMemory
+ *
+ * A device with 256 bytes of memory, like an EEPROM or a sensor's
+ * registers. The first byte written to it sets the address, the bytes
+ * after are written from there, and reads carry on from there.
+ **/
+typedef struct {
+    HeadlessI2CDevice device;
+    unsigned char memory[256];
+    unsigned char pointer;       // Address of the next byte
+    bool pointer_set;            // The address of this transfer has been written
+    unsigned int nack_at;        // Don't acknowledge this data byte written, counting from 1, or 0
+    unsigned int bytes_written;  // Data bytes written, counting the address bytes
+} HeadlessI2CMemory;
+
+/**
+ * HeadlessI2CCodec
+ *
+ * The control port of a WM8731 codec. Each transfer must write one
+ * 16bit command: a 7bit register and a 9bit value. The registers can't
+ * be read back. A write to the left input or output register with the
+ * both bit set writes the right register too, as on the codec.
+ **/
+typedef struct {
+    HeadlessI2CDevice device;
+    unsigned short registers[16];
+    unsigned char command[2];                              // Bytes of the transfer so far
+    unsigned int length;
+    unsigned int writes;                                   // Commands received
+    unsigned int log_registers[HEADLESSI2CBUS_LOG_SIZE];   // The first commands received
+    unsigned short log_values[HEADLESSI2CBUS_LOG_SIZE];
+    unsigned int bad_transfers;                            // Transfers that were not one command
+} HeadlessI2CCodec;
+
+/**
+ * HeadlessI2CBus_initMemory, HeadlessI2CBus_initCodec
+ *
+ * Sets up a device at an address, ready to attach.
+ **/
+void HeadlessI2CBus_initMemory(HeadlessI2CMemory *memory, unsigned char address);
+void HeadlessI2CBus_initCodec(HeadlessI2CCodec *codec, unsigned char address);
+
+#endif /* HEADLESSI2CBUS_H_ */
@@ -0,0 +1,195 @@
+/**
+ * HeadlessOutput.c
+ *
+ * Implementation of the null and recording game engine outputs
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "HeadlessOutput.h"
+
+#include <string.h>
+
+HeadlessRecord HeadlessOutput_record;
+
+// Null Output Functions
+
+// The null outputs ignore their parameters
+void nullInitialise(void) {}
+
+void nullShowMainMenu(unsigned int game_mode, unsigned int volume, unsigned int high_score) {
+    (void)game_mode;
+    (void)volume;
+    (void)high_score;
+}
+
+void nullShowPauseMenu(unsigned int volume) {
+    (void)volume;
+}
+
+void nullShowLevel(char *question, int options[4], float time_limit, float time_remaining,
+                   unsigned int score, unsigned int level) {
+    (void)question;
+    (void)options;
+    (void)time_limit;
+    (void)time_remaining;
+    (void)score;
+    (void)level;
+}
+
+void nullShowMessage(unsigned int state) {
+    (void)state;
+}
+
+void nullShowText(char *text) {
+    (void)text;
+}
+
+void nullShowLEDs(unsigned int pattern) {
+    (void)pattern;
+}
+
+void nullPlayEffect(unsigned int effect_id) {
+    (void)effect_id;
+}
+
+void nullPlayMusic(bool play) {
+    (void)play;
+}
+
+void nullSetVolume(unsigned int volume) {
+    (void)volume;
+}
+
+void nullSaveHighScore(char *filename, unsigned int high_score) {
+    (void)filename;
+    (void)high_score;
+}
+
+bool nullLoadHighScore(char *filename, unsigned int *high_score) {
+    (void)filename;
+    (void)high_score;
+    return false;
+}
+
+const GameEngineOutput HeadlessOutput_null = {
+    &nullInitialise,
+    &nullShowMainMenu,
+    &nullShowPauseMenu,
+    &nullShowLevel,
+    &nullShowMessage,
+    &nullShowText,
+    &nullShowLEDs,
+    &nullPlayEffect,
+    &nullPlayMusic,
+    &nullSetVolume,
+    &nullLoadHighScore,
+    &nullSaveHighScore};
+
+// Recording Output Functions
+
+// Returns the index of a stored high score file, or num_files if it is not stored
+unsigned int recordFindFile(char *filename) {
+    unsigned int i;
+    for (i = 0; i < HeadlessOutput_record.num_files; i++) {
+        if (!strcmp(HeadlessOutput_record.filenames[i], filename)) break;
+    }
+    return i;
+}
+
+void recordInitialise(void) {}
+
+void recordShowMainMenu(unsigned int game_mode, unsigned int volume, unsigned int high_score) {
+    (void)high_score;
+    HeadlessOutput_record.main_menus++;
+    HeadlessOutput_record.game_mode = game_mode;
+    HeadlessOutput_record.volume = volume;
+}
+
+void recordShowPauseMenu(unsigned int volume) {
+    HeadlessOutput_record.pause_menus++;
+    HeadlessOutput_record.volume = volume;
+}
+
+void recordShowLevel(char *question, int options[4], float time_limit, float time_remaining,
+                     unsigned int score, unsigned int level) {
+    (void)question;
+    (void)options;
+    HeadlessOutput_record.levels++;
+    HeadlessOutput_record.score = score;
+    HeadlessOutput_record.level = level;
+    HeadlessOutput_record.time_limit = time_limit;
+    HeadlessOutput_record.time_remaining = time_remaining;
+    if (score > HeadlessOutput_record.max_score) HeadlessOutput_record.max_score = score;
+    if (level > HeadlessOutput_record.max_level) HeadlessOutput_record.max_level = level;
+}
+
+void recordShowMessage(unsigned int state) {
+    if (state <= GAMEENGINE_WIN) HeadlessOutput_record.messages[state]++;
+}
+
+void recordShowText(char *text) {
+    (void)text;
+    HeadlessOutput_record.texts++;
+}
+
+void recordShowLEDs(unsigned int pattern) {
+    (void)pattern;
+    HeadlessOutput_record.leds++;
+}
+
+void recordPlayEffect(unsigned int effect_id) {
+    if (effect_id <= GAMEENGINE_EFFECT_CLICK) HeadlessOutput_record.effects[effect_id]++;
+}
+
+void recordPlayMusic(bool play) {
+    if (play && !HeadlessOutput_record.music_playing) HeadlessOutput_record.music_starts++;
+    HeadlessOutput_record.music_playing = play;
+}
+
+void recordSetVolume(unsigned int volume) {
+    (void)volume;
+    HeadlessOutput_record.volume_changes++;
+}
+
+bool recordLoadHighScore(char *filename, unsigned int *high_score) {
+    unsigned int file = recordFindFile(filename);
+    if (file == HeadlessOutput_record.num_files) return false;
+    *high_score = HeadlessOutput_record.high_scores[file];
+    return true;
+}
+
+void recordSaveHighScore(char *filename, unsigned int high_score) {
+    unsigned int file = recordFindFile(filename);
+    HeadlessOutput_record.high_score_saves++;
+    if (high_score > HeadlessOutput_record.max_high_score) HeadlessOutput_record.max_high_score = high_score;
+    if (file == HeadlessOutput_record.num_files) {
+        // Files past the last that can be kept are not stored
+        if (file == HEADLESSOUTPUT_MAX_FILES) return;
+        strncpy(HeadlessOutput_record.filenames[file], filename, sizeof(HeadlessOutput_record.filenames[file]) - 1);
+        HeadlessOutput_record.num_files++;
+    }
+    HeadlessOutput_record.high_scores[file] = high_score;
+}
+
+const GameEngineOutput HeadlessOutput_recording = {
+    &recordInitialise,
+    &recordShowMainMenu,
+    &recordShowPauseMenu,
+    &recordShowLevel,
+    &recordShowMessage,
+    &recordShowText,
+    &recordShowLEDs,
+    &recordPlayEffect,
+    &recordPlayMusic,
+    &recordSetVolume,
+    &recordLoadHighScore,
+    &recordSaveHighScore};
+
+// Driver Functions
+
+void HeadlessOutput_reset(void) {
+    memset(&HeadlessOutput_record, 0, sizeof(HeadlessOutput_record));
+}
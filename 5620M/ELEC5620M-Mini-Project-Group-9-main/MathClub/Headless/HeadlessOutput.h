@@ -0,0 +1,77 @@
+/**
+ * HeadlessOutput.h
+ *
+ * Game engine outputs for running the game without the board. The null
+ * output ignores everything and keeps no high score. The recording
+ * output counts every call, keeps the latest values shown, and keeps
+ * the high score of each file in memory, so a test can check what the
+ * game did and what it stored.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef HEADLESSOUTPUT_H_
+#define HEADLESSOUTPUT_H_
+
+#include "../GameEngine/GameEngine.h"
+
+// Number of high score files the recording output can keep
+#define HEADLESSOUTPUT_MAX_FILES 4
+
+/**
+ * HeadlessRecord
+ *
+ * Everything the recording output has been given.
+ **/
+typedef struct {
+    // Number of calls of each output
+    unsigned int main_menus;
+    unsigned int pause_menus;
+    unsigned int levels;
+    unsigned int messages[GAMEENGINE_WIN + 1];  // By the state given
+    unsigned int texts;
+    unsigned int leds;
+    unsigned int effects[GAMEENGINE_EFFECT_CLICK + 1];  // By the effect played
+    unsigned int music_starts;
+    unsigned int volume_changes;
+    unsigned int high_score_saves;
+
+    // Latest values given
+    unsigned int game_mode;
+    unsigned int volume;
+    unsigned int score;
+    unsigned int level;
+    float time_limit;
+    float time_remaining;
+    bool music_playing;
+
+    // Most seen of each, to check they stay within the game's limits
+    unsigned int max_score;
+    unsigned int max_level;
+    unsigned int max_high_score;
+
+    // High score of each file saved to
+    char filenames[HEADLESSOUTPUT_MAX_FILES][32];
+    unsigned int high_scores[HEADLESSOUTPUT_MAX_FILES];
+    unsigned int num_files;
+} HeadlessRecord;
+
+// Outputs that do nothing
+extern const GameEngineOutput HeadlessOutput_null;
+
+// Outputs that fill in HeadlessOutput_record
+extern const GameEngineOutput HeadlessOutput_recording;
+
+// What the recording output has been given
+extern HeadlessRecord HeadlessOutput_record;
+
+/**
+ * HeadlessOutput_reset
+ *
+ * Clears the record, including the stored high scores.
+ **/
+void HeadlessOutput_reset(void);
+
+#endif /* HEADLESSOUTPUT_H_ */
@@ -0,0 +1,176 @@
+/**
+ * HeadlessRates.c
+ *
+ * Reports what the synthesiser costs at each sample rate the game can
+ * use, on a Linux host, setting the rate through AUDIOOUTPUT_setSampleRate
+ * as the game does, with the codec on the model of the I2C bus:
+ *
+ *  - cost: PLAY_SECONDS of the menu music is rendered with SYNTH_render,
+ *    driven by the sequencer, at 48kHz, 32kHz and 8kHz, and the share of
+ *    the CPU each takes is given next to 48kHz's. The cost must fall with
+ *    the rate: 32kHz under 48kHz and 8kHz under a third of it.
+ *  - the same audio: at every rate an A4 note must still have 440 cycles
+ *    a second, and a queued note with its release must last as many
+ *    milliseconds, so only the cost changes with the rate.
+ *
+ * The costs are the host's, so compare them with each other; the ratios
+ * are what carry over to the board, where PROF_AUDIO_FILL measures them.
+ *
+ * Build with TIMER_HOST, HPS_I2C_HOST, WM8731_HOST and HEADLESS_RATES
+ * defined, for example:
+ *
+ *   gcc -O2 -DTIMER_HOST -DHPS_I2C_HOST -DWM8731_HOST -DHEADLESS_RATES
+ *       -D__forceinline=inline -IGTDrivers -IMathClub
+ *       GTDrivers/Timer/Timer.c GTDrivers/HPS_I2C/HPS_I2C.c
+ *       GTDrivers/DE1SoC_WM8731/DE1SoC_WM8731.c GTDrivers/Audio/AudioOutput.c
+ *       GTDrivers/Audio/AudioSynth.c GTDrivers/Audio/AudioSequencer.c
+ *       GTDrivers/Audio/WaveTable.c MathClub/GameEngine/MenuMusic.c
+ *       MathClub/Headless/HeadlessI2CBus.c MathClub/Headless/HeadlessCodec.c
+ *       MathClub/Headless/HeadlessRates.c -o headless_rates
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifdef HEADLESS_RATES
+
+#include <stdio.h>
+#include <time.h>
+
+#include "Audio/AudioOutput.h"
+#include "Audio/AudioSequencer.h"
+#include "Audio/AudioSynth.h"
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "HPS_I2C/HPS_I2C.h"
+#include "Headless/HeadlessCodec.h"
+#include "Headless/HeadlessI2CBus.h"
+
+// Address of the audio controller on the board, and of the codec on the I2C bus
+#define AUDIO_BASE 0xFF203040
+#define CODEC_ADDRESS 0x1A
+
+// Music rendered at each rate, and runs of it, keeping the fastest
+#define PLAY_SECONDS 600
+#define BENCH_RUNS 3
+
+// Rates the game can use, the first the one the others are compared with
+#define RATES 3
+const unsigned int rates[RATES] = {48000, 32000, 8000};
+
+// Note queued to time, and the release after it
+#define NOTE_MS 250
+#define RELEASE_MS 20
+
+// Menu music, from MenuMusic.c
+extern const Sequence menu_music;
+
+HeadlessI2CCodec codec;
+
+signed int left[AUDIOOUTPUT_BLOCK_FRAMES];
+signed int right[AUDIOOUTPUT_BLOCK_FRAMES];
+
+unsigned int checks = 0;
+unsigned int failed = 0;
+
+void check(bool ok, const char *what) {
+    checks++;
+    if (ok) return;
+    failed++;
+    printf("  FAILED: %s\n", what);
+}
+
+double seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Share of the CPU rendering the menu music takes at the active rate
+double musicCost(unsigned int rate) {
+    unsigned int blocks = PLAY_SECONDS * rate / AUDIOOUTPUT_BLOCK_FRAMES;
+    unsigned int block, run;
+    double best = 1e9, start, time;
+    signed int sum = 0;
+
+    for (run = 0; run < BENCH_RUNS; run++) {
+        SYNTH_initialise();
+        SEQUENCER_play(&menu_music, true);
+        start = seconds();
+        for (block = 0; block < blocks; block++) {
+            SEQUENCER_render(left, right, AUDIOOUTPUT_BLOCK_FRAMES, 0);
+            sum += left[block % AUDIOOUTPUT_BLOCK_FRAMES];
+        }
+        time = seconds() - start;
+        SEQUENCER_stop();
+        if (time < best) best = time;
+    }
+    // Keeps the samples from being optimised away
+    if (sum == 1) printf(" ");
+    return best / PLAY_SECONDS;
+}
+
+// Cycles in one second of A4, counted as rises through zero
+unsigned int a4Cycles(unsigned int rate) {
+    unsigned int frames, i, cycles = 0;
+    signed int previous = 0;
+
+    SYNTH_initialise();
+    SYNTH_setEnvelope(0, 0, 0, 100, 0);
+    SYNTH_noteOn(0, AUDIOOUTPUT_noteIncrement(AUDIO_NOTE(4, 9)));
+    for (frames = 0; frames < rate; frames += AUDIOOUTPUT_BLOCK_FRAMES) {
+        SYNTH_render(left, right, AUDIOOUTPUT_BLOCK_FRAMES, 0);
+        for (i = 0; (i < AUDIOOUTPUT_BLOCK_FRAMES) && (frames + i < rate); i++) {
+            if ((previous < 0) && (left[i] >= 0)) cycles++;
+            previous = left[i];
+        }
+    }
+    return cycles;
+}
+
+// Milliseconds from the start of a queued note to the last sound of its release
+unsigned int noteMs(unsigned int rate) {
+    AudioNote note = {A4, NOTE_MS};
+    unsigned int frames = 0, rendered, i, last = 0;
+
+    SYNTH_initialise();
+    SYNTH_setEnvelope(0, 5, 0, 100, RELEASE_MS);
+    SYNTH_queueNotes(0, &note, 1);
+    while ((rendered = SYNTH_render(left, right, AUDIOOUTPUT_BLOCK_FRAMES, 0)) != 0) {
+        for (i = 0; i < rendered; i++) {
+            if (left[i]) last = frames + i + 1;
+        }
+        frames += rendered;
+    }
+    return (last * 1000 + rate / 2) / rate;
+}
+
+int main(void) {
+    double cost[RATES];
+    unsigned int r, cycles, ms;
+
+    HeadlessI2CBus_reset();
+    HeadlessI2CBus_initCodec(&codec, CODEC_ADDRESS);
+    HeadlessI2CBus_attach(0, &codec.device);
+    HPS_I2C_initialise(0);
+    HeadlessCodec_reset(rates[0]);
+    check(WM8731_initialise(AUDIO_BASE) == WM8731_SUCCESS, "codec initialised");
+
+    printf("Menu music for %u s at each rate\n", PLAY_SECONDS);
+    for (r = 0; r < RATES; r++) {
+        check(AUDIOOUTPUT_setSampleRate(rates[r]) == AUDIOOUTPUT_SUCCESS, "rate set on the codec");
+        cost[r] = musicCost(rates[r]);
+        cycles = a4Cycles(rates[r]);
+        ms = noteMs(rates[r]);
+        printf("  %5u Hz  %7.4f%% of the CPU, %.2f of 48kHz, A4 %u cycles a second, %u ms note lasts %u ms\n",
+               rates[r], 100 * cost[r], cost[r] / cost[0], cycles, NOTE_MS, ms);
+        check((cycles >= 439) && (cycles <= 441), "A4 has 440 cycles a second");
+        check((ms >= NOTE_MS + RELEASE_MS - 1) && (ms <= NOTE_MS + RELEASE_MS + 1), "the note and its release last as long");
+    }
+    check(cost[1] < cost[0], "32kHz costs less than 48kHz");
+    check(cost[2] < cost[0] / 3, "8kHz costs less than a third of 48kHz");
+    printf("%u checks, %u failed\n", checks, failed);
+    return failed ? 1 : 0;
+}
+
+#endif /* HEADLESS_RATES */
@@ -0,0 +1,119 @@
+/**
+ * HeadlessStartup.c
+ *
+ * Runs the start up sequence on a Linux host with no board, in the
+ * virtual time of the Delay driver. Model tasks stand in for the LCD,
+ * audio and SD card steps in main.c: each step moves the time on by
+ * Delay_advance for the time it is busy, then asks for the same wait as
+ * the driver step it models. The time each task takes is checked
+ * against the time it would take on its own, and the whole sequence
+ * against running the tasks one after the other.
+ *
+ * The waits are those of the drivers. The busy times are estimates, so
+ * change them to measured times (see the boot summary printed by main)
+ * to model a board.
+ *
+ * Build with DELAY_HOST and HEADLESS_STARTUP defined, for example:
+ *
+ *   gcc -O2 -DDELAY_HOST -DHEADLESS_STARTUP -D__forceinline=inline
+ *       -IGTDrivers -IMathClub GTDrivers/Delay/Delay.c
+ *       GTDrivers/Startup/Startup.c MathClub/Headless/HeadlessStartup.c
+ *       -o headless_startup
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifdef HEADLESS_STARTUP
+
+#include <stdio.h>
+
+#include "Delay/Delay.h"
+#include "Startup/Startup.h"
+
+// A step of a model task: the time it is busy, then the wait it asks for
+typedef struct {
+    unsigned int busy_us;
+    unsigned int wait_us;
+} ModelStep;
+
+typedef struct {
+    const ModelStep *steps;
+    unsigned int count;
+    unsigned int next;  // Next step to run
+} ModelTask;
+
+// LCD_initialiseStep: power on, off and on again, upload the set up
+// commands, then clear the display
+const ModelStep lcd_steps[] = {{20, 1000}, {20, 10000}, {20, 120000}, {2000, 120000}, {15000, 0}};
+
+// startAudio: submit the codec batch, which takes 9 writes of 3 bytes at
+// 400kHz on the I2C bus, then power down the inputs, set the sample rate
+// and set up the synthesiser
+const ModelStep audio_steps[] = {{50, 608}, {5000, 0}};
+
+// startSDCard: identify and mount the card
+const ModelStep sdcard_steps[] = {{30000, 0}};
+
+#define NUM_MODEL_TASKS 3
+ModelTask model_tasks[NUM_MODEL_TASKS] = {{lcd_steps, sizeof(lcd_steps) / sizeof(lcd_steps[0]), 0},
+                                          {audio_steps, sizeof(audio_steps) / sizeof(audio_steps[0]), 0},
+                                          {sdcard_steps, sizeof(sdcard_steps) / sizeof(sdcard_steps[0]), 0}};
+const char *model_names[NUM_MODEL_TASKS] = {"LCD", "Audio", "SD Card"};
+
+StartupTask startup_tasks[NUM_MODEL_TASKS];
+
+// Runs the next step of a model task
+signed int modelStep(unsigned int *wait_us, void *context) {
+    ModelTask *task = (ModelTask *)context;
+    const ModelStep *step = &task->steps[task->next++];
+    Delay_advance(step->busy_us);
+    if (task->next == task->count) return STARTUP_SUCCESS;
+    *wait_us = step->wait_us;
+    return STARTUP_PENDING;
+}
+
+// Returns the time a model task takes on its own
+unsigned int modelTime(const ModelTask *task) {
+    unsigned int i, time_us = 0;
+    for (i = 0; i < task->count; i++) {
+        time_us += task->steps[i].busy_us;
+        if (i + 1 < task->count) time_us += task->steps[i].wait_us;
+    }
+    return time_us;
+}
+
+int main(void) {
+    unsigned long long start;
+    unsigned int i, total_us, alone_us, serial_us = 0, failed = 0;
+    signed int status;
+
+    for (i = 0; i < NUM_MODEL_TASKS; i++) {
+        startup_tasks[i].name = model_names[i];
+        startup_tasks[i].step = &modelStep;
+        startup_tasks[i].context = &model_tasks[i];
+    }
+
+    start = Delay_nowUs();
+    status = STARTUP_run(startup_tasks, NUM_MODEL_TASKS);
+    total_us = (unsigned int)(Delay_nowUs() - start);
+
+    for (i = 0; i < NUM_MODEL_TASKS; i++) {
+        alone_us = modelTime(&model_tasks[i]);
+        serial_us += alone_us;
+        printf("%-8s ready after %7u us, %6u us busy, %7u us on its own\n", startup_tasks[i].name,
+               startup_tasks[i].elapsed_us, startup_tasks[i].busy_us, alone_us);
+        // A task can't finish before its own steps and waits are done
+        if ((startup_tasks[i].elapsed_us < alone_us) || (startup_tasks[i].status != STARTUP_SUCCESS)) failed++;
+    }
+    printf("Start up took %u us, %u us one after the other, %u us saved\n", total_us, serial_us,
+           serial_us - total_us);
+
+    // The waits must overlap, and no delay may be left pending
+    if ((status != STARTUP_SUCCESS) || (total_us >= serial_us) || Delay_nextUs()) failed++;
+    if (failed) printf("%u checks failed\n", failed);
+    return failed ? 1 : 0;
+}
+
+#endif /* HEADLESS_STARTUP */
@@ -0,0 +1,287 @@
+/**
+ * HeadlessTimer.c
+ *
+ * Checks the Timer driver on a Linux host with no board, with the global
+ * timer kept in memory by the host build.
+ *
+ * The time base: Timer_nowUs, Timer_nowMs and Timer_hardwareUs divide
+ * the 64-bit tick count with multiplies rather than a 64-bit divide.
+ * They are checked against the host's own 64-bit division across the
+ * whole range of the counter: the first ticks, either side of the low
+ * word wrapping into the high word, either side of multiples of the
+ * divisors, the top of the range, and random counts of every bit
+ * length. The time is also stepped across a wrap of the low word,
+ * checking it moves on by exactly the step.
+ *
+ * The timing wheel: thousands of one shot and periodic timers, with
+ * delays from none to over half an hour so every level of the wheel is
+ * used, are serviced at random intervals as the main loop would. Their
+ * callbacks cancel other timers and themselves, restart themselves and
+ * start others. Every expiry is checked: a timer must never run before
+ * its deadline, nor later than one wheel tick plus the time since the
+ * service before, nor once it is cancelled. At the end no timer may be
+ * overdue.
+ *
+ * Build with TIMER_HOST and HEADLESS_TIMER defined, for example:
+ *
+ *   gcc -O2 -DTIMER_HOST -DHEADLESS_TIMER -D__forceinline=inline
+ *       -IGTDrivers -IMathClub GTDrivers/Timer/Timer.c
+ *       MathClub/Headless/HeadlessTimer.c -o headless_timer
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifdef HEADLESS_TIMER
+
+#include <stdio.h>
+
+#include "Timer/Timer.h"
+
+// Ticks per microsecond and per millisecond
+#define TICKS_PER_US (TIMER_TICKS_PER_SECOND / 1000000ULL)
+#define TICKS_PER_MS (TIMER_TICKS_PER_SECOND / 1000ULL)
+
+// Random counts checked of each bit length
+#define RANDOM_PER_LENGTH 20000
+
+unsigned long long time_checks = 0;
+unsigned int time_failures = 0;
+
+// xorshift64, so the checks are the same on every run
+unsigned long long random_state = 0x9E3779B97F4A7C15ULL;
+unsigned long long random64(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+// Checks the time read at a tick count against 64-bit division
+void checkTicks(unsigned long long ticks) {
+    Timer_setHardwareTicks(ticks);
+    time_checks++;
+    if ((Timer_nowTicks() == ticks) && (Timer_nowUs() == ticks / TICKS_PER_US) &&
+        (Timer_nowMs() == ticks / TICKS_PER_MS) && (Timer_hardwareUs() == ticks / TICKS_PER_US)) return;
+    if (time_failures++ < 10) {
+        printf("At %llu ticks: %llu us, %llu ms, expected %llu us, %llu ms\n", ticks, Timer_nowUs(), Timer_nowMs(),
+               ticks / TICKS_PER_US, ticks / TICKS_PER_MS);
+    }
+}
+
+// Checks every count from start - span to start + span, stopping at the ends of the range
+void checkAround(unsigned long long start, unsigned int span) {
+    unsigned long long ticks = (start > span) ? start - span : 0;
+    unsigned long long end = (start < ~0ULL - span) ? start + span : ~0ULL;
+    for (;;) {
+        checkTicks(ticks);
+        if (ticks++ == end) break;
+    }
+}
+
+// Timers in the wheel test
+#define WHEEL_TIMERS 4000
+
+// Time the wheel test runs for, and the longest delay it starts
+#define WHEEL_RUN_US 2400000000ULL
+#define WHEEL_MAX_DELAY_BITS 31
+
+// Service intervals, with an occasional long gap
+#define WHEEL_SERVICE_MAX_US 2000
+#define WHEEL_GAP_US 100000
+
+// Wheel tick in microseconds
+#define WHEEL_TICK_US (1u << TIMER_WHEEL_TICK_SHIFT)
+
+// A timer of the wheel test, and what the test expects of it
+typedef struct {
+    TimerEvent event;
+    bool active;                     // Started and not yet expired or cancelled
+    unsigned long long start_us;     // Time it was last started
+    unsigned long long deadline_us;  // Expected next deadline
+    unsigned int period_us;          // 0 for a one shot timer
+} WheelTimer;
+
+WheelTimer wheel_timers[WHEEL_TIMERS];
+unsigned long long wheel_last_service_us = 0;
+unsigned long long wheel_expiries = 0;
+unsigned long long wheel_cancels = 0;
+unsigned long long wheel_worst_late_us = 0;
+unsigned long long wheel_longest_us = 0;
+unsigned int wheel_failures = 0;
+
+void wheelExpired(void *context);
+
+// A random delay of a random number of bits, so every level of the wheel is used
+unsigned int wheelDelay(void) {
+    return (unsigned int)(random64() >> (64 - 1 - random64() % WHEEL_MAX_DELAY_BITS));
+}
+
+// Starts a test timer, one shot or periodic
+void wheelStart(WheelTimer *timer) {
+    unsigned int delay_us;
+    if (random64() % 4) {
+        delay_us = wheelDelay();
+        timer->period_us = 0;
+        Timer_addOneShot(&timer->event, delay_us, &wheelExpired, timer);
+    } else {
+        // Periods from 1us to a few wheel ticks, or as long as the delays
+        delay_us = (unsigned int)(random64() % (4 * WHEEL_TICK_US)) + 1;
+        if (random64() % 2) delay_us = wheelDelay() | 1;
+        timer->period_us = delay_us;
+        Timer_addPeriodic(&timer->event, delay_us, &wheelExpired, timer);
+    }
+    timer->start_us = Timer_nowUs();
+    timer->deadline_us = timer->start_us + delay_us;
+    timer->active = true;
+}
+
+// Cancels a test timer
+void wheelCancel(WheelTimer *timer) {
+    Timer_cancel(&timer->event);
+    if (timer->active) wheel_cancels++;
+    timer->active = false;
+}
+
+void wheelFail(WheelTimer *timer, const char *problem, unsigned long long now_us) {
+    if (wheel_failures++ < 10) {
+        printf("Timer %u %s at %llu us, deadline %llu us, last service %llu us\n",
+               (unsigned int)(timer - wheel_timers), problem, now_us, timer->deadline_us, wheel_last_service_us);
+    }
+}
+
+// Callback of every test timer. Checks the expiry, then changes the timers at
+// random. Only the first half of the timers are cancelled by others, so the
+// timers with long delays in the second half live long enough to run.
+void wheelExpired(void *context) {
+    WheelTimer *timer = (WheelTimer *)context;
+    WheelTimer *other = &wheel_timers[random64() % (WHEEL_TIMERS / 2)];
+    unsigned long long now_us = Timer_hardwareUs();
+    unsigned int action = (unsigned int)(random64() % 100);
+
+    wheel_expiries++;
+    if (!timer->active) {
+        wheelFail(timer, "ran after it was cancelled", now_us);
+    } else if (now_us < timer->deadline_us) {
+        wheelFail(timer, "ran early", now_us);
+    } else if (now_us - timer->deadline_us > WHEEL_TICK_US + (now_us - wheel_last_service_us)) {
+        wheelFail(timer, "ran late", now_us);
+    }
+    if ((now_us >= timer->deadline_us) && (now_us - timer->deadline_us > wheel_worst_late_us)) {
+        wheel_worst_late_us = now_us - timer->deadline_us;
+    }
+    if (!timer->period_us && (now_us - timer->start_us > wheel_longest_us)) wheel_longest_us = now_us - timer->start_us;
+
+    // The next deadline, skipping periods that have already passed
+    if (timer->period_us) {
+        timer->deadline_us += timer->period_us;
+        if (timer->deadline_us <= now_us) {
+            timer->deadline_us += ((now_us - timer->deadline_us) / timer->period_us + 1) * timer->period_us;
+        }
+    } else {
+        timer->active = false;
+    }
+
+    if (action < 10) {
+        // Cancel another timer, which may be due in this same service
+        wheelCancel(other);
+    } else if (action < 15) {
+        // Cancel this timer, so a periodic timer stops
+        wheelCancel(timer);
+    } else if ((action < 85) && !timer->active) {
+        // Restart this timer once it is done
+        wheelStart(timer);
+    } else if (!other->active) {
+        // Start another timer
+        wheelStart(other);
+    }
+}
+
+void testTimingWheel(void) {
+    unsigned long long now_us;
+    unsigned long long end_us;
+    unsigned long long services = 0;
+    unsigned int active = 0;
+    unsigned int step_us;
+    unsigned int i;
+
+    for (i = 0; i < WHEEL_TIMERS; i++) wheelStart(&wheel_timers[i]);
+    now_us = wheel_last_service_us = Timer_hardwareUs();
+    end_us = now_us + WHEEL_RUN_US;
+    while (now_us < end_us) {
+        step_us = (random64() % 1000) ? (unsigned int)(random64() % WHEEL_SERVICE_MAX_US) + 1 : WHEEL_GAP_US;
+        Timer_advanceHardware(step_us);
+        now_us += step_us;
+        Timer_service();
+        wheel_last_service_us = now_us;
+        services++;
+    }
+
+    // No timer may be left waiting past when it should have run
+    for (i = 0; i < WHEEL_TIMERS; i++) {
+        if (!wheel_timers[i].active) continue;
+        active++;
+        if (!wheel_timers[i].event.active) wheelFail(&wheel_timers[i], "is no longer active", now_us);
+        if (wheel_timers[i].deadline_us + WHEEL_TICK_US <= now_us) wheelFail(&wheel_timers[i], "is overdue", now_us);
+    }
+    printf("Timing wheel: %u timers, %llu services, %llu expiries, %llu cancelled, %u still active,\n"
+           "  longest one shot delay run %llu us, at most %llu us after the deadline, %u wrong\n",
+           WHEEL_TIMERS, services, wheel_expiries, wheel_cancels, active, wheel_longest_us, wheel_worst_late_us,
+           wheel_failures);
+}
+
+void testTimeBase(void) {
+    unsigned long long ticks;
+    unsigned long long us;
+    unsigned int length;
+    unsigned int i;
+
+    // The first ticks, either side of the first 1023 wraps of the low word,
+    // then of every 1024th wrap up to the top of the range
+    checkAround(0, 1000);
+    for (i = 1; i < 1024; i++) checkAround((unsigned long long)i << 32, 500);
+    for (i = 1; i < (1u << 22); i++) checkAround((unsigned long long)i << 42, 2);
+    checkAround(~0ULL, 1000);
+    // Either side of multiples of the divisors near the top of the range
+    checkAround(~0ULL / TICKS_PER_US * TICKS_PER_US, 500);
+    checkAround(~0ULL / TICKS_PER_MS * TICKS_PER_MS, 500);
+    // Random counts of every bit length, and either side of a multiple of each divisor
+    for (length = 1; length <= 64; length++) {
+        for (i = 0; i < RANDOM_PER_LENGTH; i++) {
+            ticks = random64() >> (64 - length);
+            checkTicks(ticks);
+            checkAround(ticks - ticks % TICKS_PER_US, 1);
+            checkAround(ticks - ticks % TICKS_PER_MS, 1);
+        }
+    }
+    printf("Time base: %llu tick counts checked, %u wrong\n", time_checks, time_failures);
+
+    // Step one microsecond at a time across a wrap of the low word
+    ticks = (7ULL << 32) - 10000 * TICKS_PER_US;
+    Timer_setHardwareTicks(ticks);
+    us = Timer_nowUs();
+    for (i = 0; i < 20000; i++) {
+        Timer_advanceHardware(1);
+        if (Timer_nowUs() != ++us) {
+            printf("Stepping across a wrap: %llu us, expected %llu us\n", Timer_nowUs(), us);
+            time_failures++;
+            break;
+        }
+    }
+}
+
+int main(void) {
+    unsigned int failed;
+    Timer_initialise(0);
+    testTimeBase();
+    // Run the wheel from just before a wrap of the low word
+    Timer_setHardwareTicks((3ULL << 32) - 1000000 * TICKS_PER_US);
+    Timer_initialise(0);
+    testTimingWheel();
+    failed = time_failures + wheel_failures;
+    if (failed) printf("%u checks failed\n", failed);
+    return failed ? 1 : 0;
+}
+
+#endif /* HEADLESS_TIMER */
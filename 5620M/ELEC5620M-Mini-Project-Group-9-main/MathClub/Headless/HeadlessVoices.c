@@ -0,0 +1,181 @@
+/**
+ * HeadlessVoices.c
+ *
+ * Measures how many synthesiser voices fit in a share of the CPU at
+ * 48kHz on a Linux host, and checks the mix has the headroom for all of
+ * them:
+ *
+ *  - cost: SYNTH_render is timed rendering blocks of AUDIOOUTPUT_BLOCK_FRAMES
+ *    with 0 up to SYNTH_NUM_VOICES voices holding notes, a mix of the
+ *    three waveforms. A straight line through the times gives the cost of
+ *    a block and of each voice, and from them the voices that fit in the
+ *    budget. SYNTH_NUM_VOICES must fit.
+ *  - headroom: every voice and sample slot at full scale and in phase
+ *    must saturate at the largest 24-bit sample, not wrap round.
+ *
+ * Give the budget as a percentage of the CPU, 10 if not given, and how
+ * many times slower the target is than this host, 1 if not given, to
+ * estimate it for another processor. The host has no NEON, so the mixer
+ * runs its scalar path; PROF_AUDIO_FILL measures it on the board.
+ *
+ *   headless_voices [budget percent] [times slower]
+ *
+ * Build with TIMER_HOST, HPS_I2C_HOST, WM8731_HOST and HEADLESS_VOICES
+ * defined, for example:
+ *
+ *   gcc -O2 -DTIMER_HOST -DHPS_I2C_HOST -DWM8731_HOST -DHEADLESS_VOICES
+ *       -D__forceinline=inline -IGTDrivers -IMathClub
+ *       GTDrivers/Timer/Timer.c GTDrivers/HPS_I2C/HPS_I2C.c
+ *       GTDrivers/DE1SoC_WM8731/DE1SoC_WM8731.c GTDrivers/Audio/AudioOutput.c
+ *       GTDrivers/Audio/AudioSynth.c GTDrivers/Audio/WaveTable.c
+ *       MathClub/Headless/HeadlessI2CBus.c MathClub/Headless/HeadlessCodec.c
+ *       MathClub/Headless/HeadlessVoices.c -o headless_voices
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifdef HEADLESS_VOICES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "Audio/AudioOutput.h"
+#include "Audio/AudioSynth.h"
+
+#define RATE 48000
+
+// Audio rendered for each count of voices, and runs of each, keeping the fastest
+#define BENCH_SECONDS 20
+#define BENCH_RUNS 3
+
+// Largest 24-bit sample
+#define SAMPLE_MAX 8388607
+
+// A note and the waveform for each voice, so every voice does different work
+const unsigned int voice_notes[SYNTH_NUM_VOICES] = {
+    AUDIO_NOTE(3, 0), AUDIO_NOTE(3, 7), AUDIO_NOTE(4, 0), AUDIO_NOTE(4, 4),
+    AUDIO_NOTE(4, 7), AUDIO_NOTE(4, 11), AUDIO_NOTE(5, 2), AUDIO_NOTE(5, 9)};
+const unsigned int voice_waves[3] = {SYNTH_WAVE_SINE, SYNTH_WAVE_SQUARE, SYNTH_WAVE_TRIANGLE};
+
+// Full scale samples for the sample slots
+signed short full_scale[AUDIOOUTPUT_BLOCK_FRAMES];
+
+signed int left[AUDIOOUTPUT_BLOCK_FRAMES];
+signed int right[AUDIOOUTPUT_BLOCK_FRAMES];
+
+unsigned int checks = 0;
+unsigned int failed = 0;
+
+void check(bool ok, const char *what) {
+    checks++;
+    if (ok) return;
+    failed++;
+    printf("  FAILED: %s\n", what);
+}
+
+double seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Starts the given number of voices holding their notes at full level
+void startVoices(unsigned int count) {
+    unsigned int voice;
+    SYNTH_initialise();
+    for (voice = 0; voice < count; voice++) {
+        SYNTH_setWaveform(voice, voice_waves[voice % 3]);
+        SYNTH_setEnvelope(voice, 5, 0, 100, 50);
+        SYNTH_setGain(voice, 100);
+        SYNTH_noteOn(voice, AUDIOOUTPUT_noteIncrement(voice_notes[voice]));
+    }
+}
+
+// Time taken to render BENCH_SECONDS of audio with the given number of voices
+double renderTime(unsigned int count) {
+    unsigned int blocks = BENCH_SECONDS * RATE / AUDIOOUTPUT_BLOCK_FRAMES;
+    unsigned int block, run;
+    double best = 1e9, start, time;
+    signed int sum = 0;
+
+    for (run = 0; run < BENCH_RUNS; run++) {
+        startVoices(count);
+        start = seconds();
+        for (block = 0; block < blocks; block++) {
+            SYNTH_render(left, right, AUDIOOUTPUT_BLOCK_FRAMES, 0);
+            sum += left[block % AUDIOOUTPUT_BLOCK_FRAMES];
+        }
+        time = seconds() - start;
+        if (time < best) best = time;
+    }
+    // Keeps the samples from being optimised away
+    if (sum == 1) printf(" ");
+    return best;
+}
+
+void testCost(double budget, double slower) {
+    double time[SYNTH_NUM_VOICES + 1];
+    double mean_voices = 0, mean_time = 0, spread = 0, slope = 0;
+    double base_share, voice_share;
+    unsigned int count, fit;
+
+    printf("CPU used rendering at 48kHz, %.0f%% budget, target %.1f times slower than this host\n", budget, slower);
+    for (count = 0; count <= SYNTH_NUM_VOICES; count++) {
+        time[count] = renderTime(count) * slower / BENCH_SECONDS;
+        printf("  %u voices  %7.3f%% of the CPU\n", count, 100 * time[count]);
+        mean_voices += count;
+        mean_time += time[count];
+    }
+    // Least squares line through the shares of the CPU
+    mean_voices /= SYNTH_NUM_VOICES + 1;
+    mean_time /= SYNTH_NUM_VOICES + 1;
+    for (count = 0; count <= SYNTH_NUM_VOICES; count++) {
+        spread += (count - mean_voices) * (count - mean_voices);
+        slope += (count - mean_voices) * (time[count] - mean_time);
+    }
+    voice_share = 100 * slope / spread;
+    base_share = 100 * mean_time - voice_share * mean_voices;
+    fit = (budget > base_share) ? (unsigned int)((budget - base_share) / voice_share) : 0;
+    printf("  %.4f%% for each voice after %.4f%% for the mix, %u voices fit in %.0f%%\n", voice_share, base_share, fit, budget);
+    check(fit >= SYNTH_NUM_VOICES, "SYNTH_NUM_VOICES voices fit in the budget");
+}
+
+void testHeadroom(void) {
+    unsigned int voice, slot, i;
+    bool saturated = true;
+
+    // Square waves start at full scale, in phase on the same note
+    printf("Every voice and sample slot at full scale\n");
+    SYNTH_initialise();
+    for (voice = 0; voice < SYNTH_NUM_VOICES; voice++) {
+        SYNTH_setWaveform(voice, SYNTH_WAVE_SQUARE);
+        SYNTH_setEnvelope(voice, 0, 0, 100, 0);
+        SYNTH_setGain(voice, 100);
+        SYNTH_noteOn(voice, AUDIOOUTPUT_noteIncrement(AUDIO_NOTE(4, 9)));
+    }
+    for (i = 0; i < AUDIOOUTPUT_BLOCK_FRAMES; i++) full_scale[i] = 32767;
+    for (slot = 0; slot < SYNTH_NUM_SAMPLE_SLOTS; slot++) {
+        SYNTH_playSample(slot, full_scale, AUDIOOUTPUT_BLOCK_FRAMES, 100);
+    }
+    SYNTH_render(left, right, 32, 0);
+    // The first few frames are the attack, the rest must be at the limit
+    for (i = 4; i < 32; i++) {
+        if ((left[i] != SAMPLE_MAX) || (right[i] != SAMPLE_MAX)) saturated = false;
+    }
+    printf("  frame 16 is %d of %d\n", left[16], SAMPLE_MAX);
+    check(saturated, "the mix saturates at the largest sample rather than wrapping");
+}
+
+int main(int argc, char *argv[]) {
+    double budget = (argc > 1) ? atof(argv[1]) : 10;
+    double slower = (argc > 2) ? atof(argv[2]) : 1;
+    testHeadroom();
+    testCost(budget, slower);
+    printf("%u checks, %u failed\n", checks, failed);
+    return failed ? 1 : 0;
+}
+
+#endif /* HEADLESS_VOICES */
@@ -0,0 +1,280 @@
+/**
+ * HeadlessWav.c
+ *
+ * Runs the WAV player on a Linux host, streaming files from a FAT16
+ * image in HeadlessDisk.c through FatFS into the model of the audio
+ * controller in HeadlessCodec.c, whose DAC takes frames at exactly
+ * 48kHz. Every card command takes its time from the virtual time, so
+ * the DAC keeps playing while WAVPLAYER_service waits for the card, as
+ * it would on the board.
+ *
+ * The files are written to the image with FatFS first, a cluster at a
+ * time alternating with another file so their clusters are scattered,
+ * and with a chunk of odd length before the samples so the samples
+ * start part way into a sector. Every sample is different, so a sample
+ * lost, repeated or swapped changes what the DAC plays.
+ *
+ * The main loop is modelled refilling the FIFOs and then servicing the
+ * player once a millisecond, or as soon as the service returns if it
+ * took longer. That must play stereo and mono files to the end with no
+ * underrun, in the player or in the DAC, and every frame of each file
+ * must reach the DAC in order. Servicing the player too rarely must
+ * show up as underruns in both, and still lose no audio.
+ *
+ * Build with TIMER_HOST, HPS_I2C_HOST, WM8731_HOST and HEADLESS_WAV
+ * defined, FatFS with HeadlessDisk.c in place of diskio_cyclonev.c, for
+ * example:
+ *
+ *   gcc -O2 -DTIMER_HOST -DHPS_I2C_HOST -DWM8731_HOST -DHEADLESS_WAV
+ *       -D__forceinline=inline -IGTDrivers -IMathClub
+ *       GTDrivers/Timer/Timer.c GTDrivers/HPS_I2C/HPS_I2C.c
+ *       GTDrivers/DE1SoC_WM8731/DE1SoC_WM8731.c GTDrivers/Audio/AudioOutput.c
+ *       GTDrivers/Audio/WaveTable.c GTDrivers/Audio/WavPlayer.c
+ *       GTDrivers/FatFS/ff.c MathClub/Headless/HeadlessI2CBus.c
+ *       MathClub/Headless/HeadlessCodec.c MathClub/Headless/HeadlessDisk.c
+ *       MathClub/Headless/HeadlessWav.c -o headless_wav
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifdef HEADLESS_WAV
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Audio/AudioOutput.h"
+#include "Audio/WavPlayer.h"
+#include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "FatFS/ff.h"
+#include "HPS_I2C/HPS_I2C.h"
+#include "Timer/Timer.h"
+#include "Headless/HeadlessCodec.h"
+#include "Headless/HeadlessDisk.h"
+#include "Headless/HeadlessI2CBus.h"
+
+// Address of the audio controller on the board, and of the codec on the I2C bus
+#define AUDIO_BASE 0xFF203040
+#define CODEC_ADDRESS 0x1A
+
+#define RATE 48000
+
+// Length of each file
+#define FILE_FRAMES (10 * RATE)
+
+// Disk of 24MB with 4KB clusters
+#define DISK_SECTORS 49152
+#define CLUSTER_SECTORS 8
+#define CLUSTER_BYTES (CLUSTER_SECTORS * HEADLESSDISK_SECTOR_SIZE)
+
+// Time 128 frames in the FIFOs last at 48kHz
+#define FIFO_US ((AUDIOOUTPUT_FIFO_DEPTH * 1000000) / RATE)
+
+// Main loop period, and the service interval that is too long for the stream buffers
+#define LOOP_US 1000
+#define LATE_SERVICE_US 200000
+
+HeadlessI2CCodec codec;
+FATFS fatfs;
+
+unsigned int checks = 0;
+unsigned int failed = 0;
+
+// Virtual time, and the time of the last refill with the longest time between two
+unsigned long long now_us = 0;
+unsigned long long last_refill_us = 0;
+unsigned long long longest_refill_us = 0;
+
+void check(bool ok, const char *what) {
+    checks++;
+    if (ok) return;
+    failed++;
+    printf("  FAILED: %s\n", what);
+}
+
+// Moves the time on for the driver and the DAC together. The disk calls
+// this for the time each command takes.
+void advance(unsigned int us) {
+    Timer_advanceHardware(us);
+    HeadlessCodec_advance(us);
+    now_us += us;
+}
+
+// Sample of a channel of a frame of the test files. Each is different
+// from those around it, so any sample out of place changes the checksum.
+signed short fileSample(unsigned int frame, unsigned int channel) {
+    return (signed short)(((frame * 2654435761u) ^ (channel * 40503u)) >> 16);
+}
+
+// Checksum of what the DAC should play for a file, with mono samples on both channels
+unsigned int fileChecksum(unsigned int channels) {
+    unsigned int checksum = HEADLESSCODEC_CHECKSUM_START;
+    unsigned int frame;
+    signed int left, right;
+    for (frame = 0; frame < FILE_FRAMES; frame++) {
+        left = fileSample(frame, 0) << 8;
+        right = (channels == 2) ? fileSample(frame, 1) << 8 : left;
+        checksum = HeadlessCodec_checksum(checksum, (unsigned int)left, (unsigned int)right);
+    }
+    return checksum;
+}
+
+void store16(unsigned char *bytes, unsigned int value) {
+    bytes[0] = (unsigned char)value;
+    bytes[1] = (unsigned char)(value >> 8);
+}
+
+void store32(unsigned char *bytes, unsigned int value) {
+    store16(bytes, value & 0xFFFF);
+    store16(bytes + 2, value >> 16);
+}
+
+// Writes a test file a cluster at a time, with a cluster of a filler file
+// after each so the clusters of the file are not next to each other
+bool writeWavFile(char name[], char filler_name[], unsigned int channels) {
+    static unsigned char chunk[CLUSTER_BYTES];
+    // RIFF header, format chunk, a 7 byte chunk and its padding, then the data chunk
+    unsigned char header[12 + 8 + 16 + 8 + 8 + 8];
+    unsigned int data_bytes = FILE_FRAMES * channels * 2;
+    unsigned int frame = 0, channel = 0, length;
+    FIL file, filler;
+    UINT written;
+    bool ok;
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, "RIFF", 4);
+    store32(header + 4, sizeof(header) - 8 + data_bytes);
+    memcpy(header + 8, "WAVEfmt ", 8);
+    store32(header + 16, 16);
+    store16(header + 20, 1);
+    store16(header + 22, channels);
+    store32(header + 24, RATE);
+    store32(header + 28, RATE * channels * 2);
+    store16(header + 32, channels * 2);
+    store16(header + 34, 16);
+    memcpy(header + 36, "note", 4);
+    store32(header + 40, 7);
+    memcpy(header + 44, "odd len", 7);
+    memcpy(header + 52, "data", 4);
+    store32(header + 56, data_bytes);
+
+    if (f_open(&file, name, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return false;
+    if (f_open(&filler, filler_name, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return false;
+    ok = (f_write(&file, header, sizeof(header), &written) == FR_OK) && (written == sizeof(header));
+    while (ok && (frame < FILE_FRAMES)) {
+        for (length = 0; (length < CLUSTER_BYTES) && (frame < FILE_FRAMES); length += 2) {
+            store16(chunk + length, (unsigned short)fileSample(frame, channel));
+            if (++channel == channels) {
+                channel = 0;
+                frame++;
+            }
+        }
+        ok = (f_write(&file, chunk, length, &written) == FR_OK) && (written == length) &&
+             (f_write(&filler, chunk, CLUSTER_BYTES, &written) == FR_OK) && (written == CLUSTER_BYTES);
+    }
+    f_close(&filler);
+    return (f_close(&file) == FR_OK) && ok;
+}
+
+// Starts a test with the codec initialised and the statistics cleared
+void startTest(const char *name) {
+    printf("%s\n", name);
+    HeadlessI2CBus_reset();
+    HeadlessI2CBus_initCodec(&codec, CODEC_ADDRESS);
+    HeadlessI2CBus_attach(0, &codec.device);
+    HPS_I2C_initialise(0);
+    HeadlessCodec_reset(RATE);
+    check(WM8731_initialise(AUDIO_BASE) == WM8731_SUCCESS, "codec initialised");
+    AUDIOOUTPUT_resetStats();
+    HeadlessDisk_resetStats();
+    longest_refill_us = 0;
+}
+
+// Plays a file to the end as the main loop would, servicing the player
+// at most once every service_us
+void playFile(char name[], unsigned int service_us) {
+    unsigned long long loop_start_us;
+    unsigned long long last_service_us = now_us;
+    unsigned long long service_start_us;
+    unsigned long long longest_service_us = 0;
+
+    check(WAVPLAYER_open(name) == WAVPLAYER_SUCCESS, "file opened");
+    last_refill_us = now_us;
+    while (WAVPLAYER_isPlaying() || HeadlessCodec_level()) {
+        loop_start_us = now_us;
+        AUDIOOUTPUT_fill(WAVPLAYER_getSource(), AUDIOOUTPUT_FIFO_DEPTH);
+        if (now_us - last_refill_us > longest_refill_us) longest_refill_us = now_us - last_refill_us;
+        last_refill_us = now_us;
+        if (now_us - last_service_us >= service_us) {
+            service_start_us = now_us;
+            WAVPLAYER_service();
+            if (now_us - service_start_us > longest_service_us) longest_service_us = now_us - service_start_us;
+            last_service_us = now_us;
+        }
+        if (now_us - loop_start_us < LOOP_US) advance(LOOP_US - (unsigned int)(now_us - loop_start_us));
+    }
+    printf("  %u card reads of %llu sectors, longest service %llu us, longest between refills %llu us of %u us\n",
+           HeadlessDisk_stats()->reads, HeadlessDisk_stats()->sectors_read, longest_service_us, longest_refill_us,
+           FIFO_US);
+}
+
+// Checks a file was played to the end in time
+void checkPlayedInTime(unsigned int channels) {
+    const HeadlessCodecStats *model = HeadlessCodec_stats();
+    AudioOutputStats stats;
+
+    AUDIOOUTPUT_getStats(&stats);
+    check(WAVPLAYER_getUnderruns() == 0, "the player never ran out of buffered samples");
+    check((model->underruns == 0) && (model->frames_missed == 0), "the DAC never ran out");
+    check(stats.underruns == 0, "AUDIOOUTPUT_fill counted no underruns");
+    check(longest_refill_us < FIFO_US, "the FIFOs were always refilled before they could run dry");
+    check(model->frames_played == FILE_FRAMES, "every frame of the file was played");
+    check(model->checksum == fileChecksum(channels), "the DAC played every frame of the file in order");
+    check(!model->overflows && !model->misaligned, "no FIFO overflow and the channels stay aligned");
+}
+
+void testStereo(void) {
+    startTest("Stereo file, main loop every millisecond");
+    playFile("STEREO.WAV", 0);
+    checkPlayedInTime(2);
+}
+
+void testMono(void) {
+    startTest("Mono file, main loop every millisecond");
+    playFile("MONO.WAV", 0);
+    checkPlayedInTime(1);
+}
+
+void testLateService(void) {
+    const HeadlessCodecStats *model = HeadlessCodec_stats();
+
+    // Each buffer holds 85ms of stereo, so both run dry between services
+    startTest("Stereo file, player serviced every 200 ms");
+    playFile("STEREO.WAV", LATE_SERVICE_US);
+    printf("  %u underruns in the player, %u in the DAC\n", WAVPLAYER_getUnderruns(), model->underruns);
+    check(WAVPLAYER_getUnderruns() > 0, "the player counted its underruns");
+    check(model->underruns > 0, "the DAC ran out");
+    check(model->frames_played == FILE_FRAMES, "every frame of the file was still played");
+    check(model->checksum == fileChecksum(2), "in order, only late");
+}
+
+int main(void) {
+    Timer_setHardwareTicks(0);
+    Timer_initialise(0);
+
+    // Make the disk and write the files, without taking any time
+    check(HeadlessDisk_format(DISK_SECTORS, CLUSTER_SECTORS), "disk formatted as FAT16");
+    check(f_mount(&fatfs, "", 1) == FR_OK, "disk mounted");
+    check(writeWavFile("STEREO.WAV", "FILL1.BIN", 2), "stereo file written");
+    check(writeWavFile("MONO.WAV", "FILL2.BIN", 1), "mono file written");
+
+    HeadlessDisk_setBusy(&advance);
+    testStereo();
+    testMono();
+    testLateService();
+    printf("%u checks, %u failed\n", checks, failed);
+    return failed ? 1 : 0;
+}
+
+#endif /* HEADLESS_WAV */
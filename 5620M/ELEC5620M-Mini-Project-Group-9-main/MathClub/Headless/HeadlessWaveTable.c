@@ -0,0 +1,272 @@
+/**
+ * HeadlessWaveTable.c
+ *
+ * Measures the table oscillator of AudioOutput.c on a Linux host against
+ * the sin() oscillator it replaced:
+ *
+ *  - speed: samples per second of AUDIOOUTPUT_nextSample, and of the loop
+ *    AUDIOOUTPUT_playTone ran before, which wrapped a double phase and
+ *    called sin() for every sample;
+ *  - accuracy: every sample of one second of every note from C0 to B8 is
+ *    compared with sin() at the oscillator's own phase, and the worst
+ *    error must be under WT_MAX_ERROR_DBFS;
+ *  - spectrum: tones with a whole number of cycles in the FFT length,
+ *    so no window is needed, must have no spur above
+ *    WT_MAX_SPUR_DBFS and no more noise and distortion in total
+ *    than WT_MAX_NOISE_DBFS. The same is measured for sin() to
+ *    show the measurement itself is far more accurate than that.
+ *
+ * The speeds are the host's, whose FPU makes sin() much cheaper next to
+ * integer code than the Cortex-A9 does, so they only show the order of
+ * the gain. PROF_AUDIO_PLAYTONE measures it on the board.
+ *
+ * Build with TIMER_HOST, HPS_I2C_HOST, WM8731_HOST and HEADLESS_WAVETABLE
+ * defined, for example:
+ *
+ *   gcc -O2 -DTIMER_HOST -DHPS_I2C_HOST -DWM8731_HOST -DHEADLESS_WAVETABLE
+ *       -D__forceinline=inline -IGTDrivers -IMathClub
+ *       GTDrivers/Timer/Timer.c GTDrivers/HPS_I2C/HPS_I2C.c
+ *       GTDrivers/DE1SoC_WM8731/DE1SoC_WM8731.c GTDrivers/Audio/AudioOutput.c
+ *       GTDrivers/Audio/WaveTable.c MathClub/Headless/HeadlessI2CBus.c
+ *       MathClub/Headless/HeadlessCodec.c MathClub/Headless/HeadlessWaveTable.c
+ *       -lm -o headless_wavetable
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifdef HEADLESS_WAVETABLE
+
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "Audio/AudioOutput.h"
+#include "Audio/WaveTable.h"
+
+// Full scale of the 24-bit samples, and the gain of volume 100
+#define FULL_SCALE 8388608.0
+#define FULL_GAIN 65536
+
+// Samples timed in each run, and runs of each, keeping the fastest
+#define BENCH_SAMPLES 20000000
+#define BENCH_RUNS 3
+
+// Samples of each note compared with sin()
+#define NOTE_SAMPLES 48000
+
+// FFT length. A tone of k cycles in it has an increment of k << 12, and
+// for odd k takes every phase that is a multiple of 2^12 once, so all
+// 1024 table entries with 1024 steps between each.
+#define FFT_BITS 20
+#define FFT_SIZE (1 << FFT_BITS)
+
+// Cycles in the FFT length of each tone measured, about 20Hz to 20kHz,
+// with 9617 close to A4
+#define SPECTRUM_TONES 4
+const unsigned int spectrum_cycles[SPECTRUM_TONES] = {437, 9617, 155557, 436907};
+
+unsigned int checks = 0;
+unsigned int failed = 0;
+
+// Samples of a tone and their spectrum
+signed int samples[FFT_SIZE];
+double fft_real[FFT_SIZE];
+double fft_imag[FFT_SIZE];
+
+void check(bool ok, const char *what) {
+    checks++;
+    if (ok) return;
+    failed++;
+    printf("  FAILED: %s\n", what);
+}
+
+double seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+double dBFS(double error) {
+    return 20 * log10(error / FULL_SCALE);
+}
+
+// Oscillators
+
+// The loop AUDIOOUTPUT_playTone ran for each sample before the table
+double sin_phase = 0.0;
+signed int sinSample(double increment, double amplitude) {
+    sin_phase = sin_phase + increment;
+    while (sin_phase >= PI2) {
+        sin_phase = sin_phase - PI2;
+    }
+    return (signed int)(amplitude * sin(sin_phase));
+}
+
+// What the table oscillator should give at a phase
+double idealSample(unsigned int phase) {
+    return FULL_SCALE * sin(phase * (PI2 / 4294967296.0));
+}
+
+// Speed
+
+// Adds up the samples so the compiler can't drop them
+double benchSin(unsigned int count, signed int *sum) {
+    double increment = A4 * PI2 / F_SAMPLE;
+    double start = seconds();
+    unsigned int i;
+    for (i = 0; i < count; i++) *sum += sinSample(increment, FULL_SCALE);
+    return seconds() - start;
+}
+
+double benchTable(unsigned int count, signed int *sum) {
+    AudioOscillator oscillator = {0, 0};
+    double start = seconds();
+    unsigned int i;
+    oscillator.increment = AUDIOOUTPUT_noteIncrement(AUDIO_NOTE(4, 9));
+    for (i = 0; i < count; i++) *sum += AUDIOOUTPUT_nextSample(&oscillator, FULL_GAIN);
+    return seconds() - start;
+}
+
+void testSpeed(void) {
+    double sin_best = 1e9, table_best = 1e9, time;
+    signed int sum = 0;
+    unsigned int run;
+
+    printf("Samples per second of A4 at full scale\n");
+    for (run = 0; run < BENCH_RUNS; run++) {
+        time = benchSin(BENCH_SAMPLES, &sum);
+        if (time < sin_best) sin_best = time;
+        time = benchTable(BENCH_SAMPLES, &sum);
+        if (time < table_best) table_best = time;
+    }
+    printf("  sin():         %12.0f samples/s, %7.0f times 48kHz\n", BENCH_SAMPLES / sin_best, BENCH_SAMPLES / sin_best / 48000);
+    printf("  table:         %12.0f samples/s, %7.0f times 48kHz\n", BENCH_SAMPLES / table_best, BENCH_SAMPLES / table_best / 48000);
+    printf("  table is %.1f times as fast (sum %d)\n", sin_best / table_best, sum);
+}
+
+// Accuracy
+
+void testEveryNote(void) {
+    AudioOscillator oscillator;
+    double error, worst = 0;
+    unsigned int note, i, worst_note = 0;
+
+    printf("Every note against sin() at the same phase\n");
+    for (note = 0; note < AUDIO_NUM_NOTES; note++) {
+        oscillator.phase = 0;
+        oscillator.increment = AUDIOOUTPUT_noteIncrement(note);
+        for (i = 0; i < NOTE_SAMPLES; i++) {
+            error = fabs(AUDIOOUTPUT_nextSample(&oscillator, FULL_GAIN) - idealSample(oscillator.phase));
+            if (error > worst) {
+                worst = error;
+                worst_note = note;
+            }
+        }
+    }
+    printf("  worst error %.0f of %.0f, %.1f dBFS, in note %u\n", worst, FULL_SCALE, dBFS(worst), worst_note);
+    check(dBFS(worst) < WT_MAX_ERROR_DBFS, "every sample is within WT_MAX_ERROR_DBFS of sin()");
+}
+
+// Spectrum
+
+// In place radix 2 FFT of fft_real and fft_imag
+void fft(void) {
+    unsigned int i, j, bit, length, k;
+    double angle, w_real, w_imag, t_real, t_imag, u_real, u_imag;
+
+    for (i = 1, j = 0; i < FFT_SIZE; i++) {
+        for (bit = FFT_SIZE >> 1; j & bit; bit >>= 1) j ^= bit;
+        j |= bit;
+        if (i < j) {
+            t_real = fft_real[i];
+            fft_real[i] = fft_real[j];
+            fft_real[j] = t_real;
+            t_imag = fft_imag[i];
+            fft_imag[i] = fft_imag[j];
+            fft_imag[j] = t_imag;
+        }
+    }
+    for (length = 2; length <= FFT_SIZE; length <<= 1) {
+        for (k = 0; k < length / 2; k++) {
+            angle = -PI2 * k / length;
+            w_real = cos(angle);
+            w_imag = sin(angle);
+            for (i = k; i < FFT_SIZE; i += length) {
+                j = i + length / 2;
+                t_real = fft_real[j] * w_real - fft_imag[j] * w_imag;
+                t_imag = fft_real[j] * w_imag + fft_imag[j] * w_real;
+                u_real = fft_real[i];
+                u_imag = fft_imag[i];
+                fft_real[i] = u_real + t_real;
+                fft_imag[i] = u_imag + t_imag;
+                fft_real[j] = u_real - t_real;
+                fft_imag[j] = u_imag - t_imag;
+            }
+        }
+    }
+}
+
+// Measures the samples of a tone of the given cycles. Gives the largest
+// spur and all the noise and distortion together, each as the amplitude
+// of a sine with that power in dBFS.
+void measureSpectrum(unsigned int cycles, double *spur, double *noise) {
+    double power, largest = 0, total = 0;
+    unsigned int bin;
+
+    for (bin = 0; bin < FFT_SIZE; bin++) {
+        fft_real[bin] = samples[bin];
+        fft_imag[bin] = 0;
+    }
+    fft();
+    // A sine of amplitude A gives A * FFT_SIZE / 2 in its bin and its
+    // mirror, so the power of each half is scaled to a sine's amplitude
+    for (bin = 0; bin <= FFT_SIZE / 2; bin++) {
+        if (bin == cycles) continue;
+        power = fft_real[bin] * fft_real[bin] + fft_imag[bin] * fft_imag[bin];
+        power *= 4.0 / ((double)FFT_SIZE * FFT_SIZE);
+        if ((bin == 0) || (bin == FFT_SIZE / 2)) power /= 4;
+        if (power > largest) largest = power;
+        total += power;
+    }
+    *spur = dBFS(sqrt(largest));
+    *noise = dBFS(sqrt(total));
+}
+
+void testSpectrum(void) {
+    AudioOscillator oscillator;
+    double spur, noise, worst_spur = -1000, worst_noise = -1000, sin_spur = -1000, sin_noise = -1000;
+    unsigned int tone, i;
+
+    printf("Spectrum of %u samples, largest spur and all noise and distortion\n", FFT_SIZE);
+    for (tone = 0; tone < SPECTRUM_TONES; tone++) {
+        oscillator.phase = 0;
+        oscillator.increment = spectrum_cycles[tone] << (32 - FFT_BITS);
+        for (i = 0; i < FFT_SIZE; i++) samples[i] = AUDIOOUTPUT_nextSample(&oscillator, FULL_GAIN);
+        measureSpectrum(spectrum_cycles[tone], &spur, &noise);
+        printf("  %7.1f Hz  table %6.1f %6.1f dBFS", spectrum_cycles[tone] * (F_SAMPLE / FFT_SIZE), spur, noise);
+        if (spur > worst_spur) worst_spur = spur;
+        if (noise > worst_noise) worst_noise = noise;
+
+        sin_phase = 0;
+        for (i = 0; i < FFT_SIZE; i++) samples[i] = sinSample(spectrum_cycles[tone] * PI2 / FFT_SIZE, FULL_SCALE);
+        measureSpectrum(spectrum_cycles[tone], &spur, &noise);
+        printf("   sin() %6.1f %6.1f dBFS\n", spur, noise);
+        if (spur > sin_spur) sin_spur = spur;
+        if (noise > sin_noise) sin_noise = noise;
+    }
+    check(worst_spur < WT_MAX_SPUR_DBFS, "no spur above WT_MAX_SPUR_DBFS");
+    check(worst_noise < WT_MAX_NOISE_DBFS, "noise and distortion below WT_MAX_NOISE_DBFS");
+    check(sin_noise < WT_MAX_NOISE_DBFS - 20, "the measurement is far more accurate than the table");
+}
+
+int main(void) {
+    testSpeed();
+    testEveryNote();
+    testSpectrum();
+    printf("%u checks, %u failed\n", checks, failed);
+    return failed ? 1 : 0;
+}
+
+#endif /* HEADLESS_WAVETABLE */
@@ -12,9 +12,6 @@
 #include "QuestionGenerator.h"
 
 #include <stdio.h>
-#include <stdlib.h>
-
-#include "Timer/Timer.h"
 
 // Function to add two numbers
 float add(float a, float b) {
@@ -56,16 +53,33 @@ char* operation_symbols[4] = {"+", "-", "x", "/"};
 // Count number of operations stored.
 int num_operations = sizeof(operation_symbols) / sizeof(operation_symbols[0]);
 
+// State of the random number generator. The generator is written out
+// here rather than using rand(), so a seed gives the same questions with
+// any C library.
+unsigned int random_state = 1;
+
+// Sets the seed of the random number generator
+void QuestionGenerator_setSeed(unsigned int seed) {
+    // xorshift never leaves 0, so it can't be used as a state
+    random_state = seed ? seed : 1;
+}
+
+// Steps the xorshift32 random number generator
+unsigned int nextRandom(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
 // Generates a random number between min_value and max_value inclusive
 unsigned int generateRandomNumber(unsigned int min_value, unsigned int max_value) {
     int range;
     unsigned int random_num;
-    // seed the random number generator with the current time
-    srand(Timer_getValue());
 
     // Generate a random number within the range
     range = max_value - min_value + 1;
-    random_num = (rand() % range) + min_value;
+    random_num = (nextRandom() % range) + min_value;
 
     return random_num;
 }
@@ -73,12 +87,10 @@ unsigned int generateRandomNumber(unsigned int min_value, unsigned int max_value
 // Function used to shuffle an array.
 void shuffle(int arr[], int size) {
     int i, j;
-    // seed the random number generator with the current time
-    srand(Timer_getValue());
     // For loop to run through and change the positions of values in array
     for (i = size - 1; i > 0; i--) {
         // generate a random index between 0 and i
-        j = rand() % (i + 1);
+        j = nextRandom() % (i + 1);
         // swap the elements at indices i and j
         swap(&arr[i], &arr[j]);
     }
@@ -113,7 +125,10 @@ QuestionResult QuestionGenerator_generateQuestion(unsigned int difficulty) {
     if (operation_id == 1) {
         if (number2 > number1)
             swap(&number1, &number2);
-        if (number1 == number2) {  // If both numbers are equal
+        if (number1 == max_value_1 && number2 == max_value_1) {
+            // Both are already the largest number1 can be, so make number2 smaller
+            number2--;
+        } else if (number1 == number2) {  // If both numbers are equal
             // Add a random amount to number1 such that it is more than number2
             // but less than max_value_1
             // This is to prevent overflow when calculating the options
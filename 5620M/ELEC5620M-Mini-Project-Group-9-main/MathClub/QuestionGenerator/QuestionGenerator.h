@@ -49,3 +49,16 @@ typedef struct {
  * 			options:	4 options are provided including the answer
  */
 QuestionResult QuestionGenerator_generateQuestion(unsigned int difficulty);
+
+/*
+ * QuestionGenerator_setSeed
+ *
+ * Sets the seed of the random number generator used for the questions.
+ * The same seed always gives the same questions in the same order, so
+ * a recorded game can be replayed. Call it once at start up, with
+ * Timer_getValue() for different questions each game.
+ *
+ * Input:
+ * 		seed:	seed of the random number generator
+ */
+void QuestionGenerator_setSeed(unsigned int seed);
@@ -0,0 +1,344 @@
+/**
+ * Replay.c
+ *
+ * Implementation of the input record and replay
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#include "Replay.h"
+
+unsigned int Replay_hash(unsigned int hash, const void *data, unsigned int length) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    unsigned int i;
+    for (i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+#ifdef REPLAY_ENABLED
+
+#include <stdio.h>
+#include <string.h>
+
+#ifndef GAMEENGINE_HEADLESS
+#include "FatFS/ff.h"
+#endif
+#include "Timer/Timer.h"
+
+// Format version of a recording
+#define REPLAY_VERSION 1
+
+// Recorded or loaded frames
+ReplayFrame replay_frames[REPLAY_MAX_FRAMES];
+unsigned int replay_count = 0;
+
+// Cost of each frame while playing, and whether its hash matched
+unsigned int replay_costs[REPLAY_MAX_FRAMES];
+bool replay_matched[REPLAY_MAX_FRAMES];
+
+unsigned int replay_mode = REPLAY_LIVE;
+unsigned int replay_seed = 0;
+unsigned long long replay_start_us = 0;  // Frame time when recording started
+
+// Frame time held, and the global timer when it was last moved on
+unsigned long long replay_time_us = 0;
+unsigned long long replay_last_hw_us = 0;
+
+// Next frame to play and when the current frame started
+unsigned int replay_index = 0;
+unsigned long long replay_frame_start_us = 0;
+
+// Result of the playback
+signed int replay_divergence = -1;  // First frame whose hash did not match, -1 for none
+unsigned int replay_final_hash = 0;
+
+// File used to load and save, and a buffer for writing reports
+#ifndef GAMEENGINE_HEADLESS
+FIL replay_file;
+#endif
+char replay_text[4096];
+
+// Helper Functions
+
+// Writes a word to a buffer in little endian order
+void replay_putWord(unsigned char *buffer, unsigned int word) {
+    buffer[0] = (unsigned char)word;
+    buffer[1] = (unsigned char)(word >> 8);
+    buffer[2] = (unsigned char)(word >> 16);
+    buffer[3] = (unsigned char)(word >> 24);
+}
+
+// Reads a little endian word from a buffer
+unsigned int replay_getWord(const unsigned char *buffer) {
+    return buffer[0] | (buffer[1] << 8) | (buffer[2] << 16) | ((unsigned int)buffer[3] << 24);
+}
+
+// Moves the held frame time on by the time passed on the global timer
+void replay_followHardware(void) {
+    unsigned long long now = Timer_hardwareUs();
+    replay_time_us += now - replay_last_hw_us;
+    replay_last_hw_us = now;
+}
+
+// Fills in the header of a recording of count frames
+void replay_writeHeader(unsigned char header[REPLAY_HEADER_BYTES], unsigned int count) {
+    header[0] = 'M';
+    header[1] = 'C';
+    header[2] = 'R';
+    header[3] = 'P';
+    replay_putWord(&header[4], REPLAY_VERSION);
+    replay_putWord(&header[8], replay_seed);
+    replay_putWord(&header[12], count);
+    replay_putWord(&header[16], (unsigned int)replay_start_us);
+    replay_putWord(&header[20], (unsigned int)(replay_start_us >> 32));
+    replay_putWord(&header[24], 0);
+    replay_putWord(&header[28], 0);
+}
+
+// Checks the header of a recording, returning its frame count or 0 if
+// it is not a recording this can play
+unsigned int replay_readHeader(const unsigned char header[REPLAY_HEADER_BYTES]) {
+    unsigned int count;
+    if ((header[0] != 'M') || (header[1] != 'C') || (header[2] != 'R') || (header[3] != 'P') ||
+        (replay_getWord(&header[4]) != REPLAY_VERSION)) {
+        return 0;
+    }
+    count = replay_getWord(&header[12]);
+    return (count > REPLAY_MAX_FRAMES) ? 0 : count;
+}
+
+// Starts playing the frames loaded into replay_frames, from the header
+// they were loaded with
+void replay_beginPlayback(const unsigned char header[REPLAY_HEADER_BYTES], unsigned int count) {
+    unsigned long long now;
+
+    replay_seed = replay_getWord(&header[8]);
+    replay_count = count;
+    replay_start_us = replay_getWord(&header[16]) | ((unsigned long long)replay_getWord(&header[20]) << 32);
+
+    // Start at the recorded time, or a whole number of alignments after
+    // it if that has already passed
+    now = Timer_hardwareUs();
+    replay_time_us = replay_start_us;
+    if (now > replay_time_us) {
+        replay_time_us += (now - replay_time_us + REPLAY_ALIGN_US - 1) / REPLAY_ALIGN_US * REPLAY_ALIGN_US;
+    }
+    replay_last_hw_us = now;
+    Timer_setFrameTime(replay_time_us);
+
+    replay_index = 0;
+    replay_divergence = -1;
+    replay_mode = REPLAY_PLAYING;
+}
+
+// Writes the playback summary into replay_text, returning its length
+unsigned int replay_summary(void) {
+    unsigned long long recorded_total = 0, played_total = 0;
+    unsigned int recorded_max = 0, played_max = 0;
+    unsigned int i, length;
+
+    for (i = 0; i < replay_index; i++) {
+        recorded_total += replay_frames[i].cost_us;
+        played_total += replay_costs[i];
+        if (replay_frames[i].cost_us > recorded_max) recorded_max = replay_frames[i].cost_us;
+        if (replay_costs[i] > played_max) played_max = replay_costs[i];
+    }
+    if (!replay_index) return sprintf(replay_text, "# No frames replayed\r\n");
+
+    length = sprintf(replay_text, "# Replayed %u of %u frames, seed %u\r\n", replay_index, replay_count, replay_seed);
+    length += sprintf(&replay_text[length], "# Recorded: mean %u us, max %u us\r\n",
+                      (unsigned int)(recorded_total / replay_index), recorded_max);
+    length += sprintf(&replay_text[length], "# Replayed: mean %u us, max %u us\r\n",
+                      (unsigned int)(played_total / replay_index), played_max);
+    length += sprintf(&replay_text[length], "# Final hash %08x, recorded %08x\r\n", replay_final_hash,
+                      replay_frames[replay_index - 1].hash);
+    if (replay_divergence < 0) {
+        length += sprintf(&replay_text[length], "# Every frame matched\r\n");
+    } else {
+        length += sprintf(&replay_text[length], "# First frame not matching: %d\r\n", replay_divergence);
+    }
+    return length;
+}
+
+// Driver Functions
+
+void Replay_startRecording(unsigned int seed) {
+    replay_seed = seed;
+    replay_count = 0;
+    replay_last_hw_us = Timer_hardwareUs();
+    replay_time_us = replay_last_hw_us;
+    replay_start_us = replay_time_us;
+    Timer_setFrameTime(replay_time_us);
+    replay_mode = REPLAY_RECORDING;
+}
+
+#ifndef GAMEENGINE_HEADLESS
+signed int Replay_startPlayback(char filename[]) {
+    unsigned char header[REPLAY_HEADER_BYTES];
+    unsigned int count;
+    UINT read;
+
+    if (f_open(&replay_file, filename, FA_READ) != FR_OK) return REPLAY_ERRORNOFILE;
+
+    // Check the header, then load every frame
+    if ((f_read(&replay_file, header, sizeof(header), &read) != FR_OK) || (read != sizeof(header)) ||
+        !(count = replay_readHeader(header)) ||
+        (f_read(&replay_file, replay_frames, count * sizeof(ReplayFrame), &read) != FR_OK) ||
+        (read != count * sizeof(ReplayFrame))) {
+        f_close(&replay_file);
+        return REPLAY_ERRORFORMAT;
+    }
+    f_close(&replay_file);
+
+    replay_beginPlayback(header, count);
+    return REPLAY_SUCCESS;
+}
+#endif
+
+signed int Replay_startPlaybackFromMemory(const unsigned char data[], unsigned int length) {
+    unsigned int count;
+
+    if ((length < REPLAY_HEADER_BYTES) || !(count = replay_readHeader(data)) ||
+        (length != REPLAY_HEADER_BYTES + count * sizeof(ReplayFrame))) {
+        return REPLAY_ERRORFORMAT;
+    }
+    memcpy(replay_frames, &data[REPLAY_HEADER_BYTES], count * sizeof(ReplayFrame));
+
+    replay_beginPlayback(data, count);
+    return REPLAY_SUCCESS;
+}
+
+signed int Replay_getDivergence(void) {
+    return replay_divergence;
+}
+
+unsigned int Replay_getMode(void) {
+    return replay_mode;
+}
+
+unsigned int Replay_getSeed(void) {
+    return replay_seed;
+}
+
+void Replay_beginFrame(unsigned int *keys, unsigned int *switches) {
+    ReplayFrame *frame;
+    unsigned long long last_time = replay_time_us;
+
+    if (replay_mode == REPLAY_PLAYING) {
+        // Move on by the recorded time and use the recorded inputs
+        frame = &replay_frames[replay_index];
+        replay_time_us += frame->delta_us;
+        *keys = frame->keys;
+        *switches = frame->switches;
+        replay_frame_start_us = Timer_hardwareUs();
+    } else {
+        replay_followHardware();
+        replay_frame_start_us = replay_last_hw_us;
+        if ((replay_mode == REPLAY_RECORDING) && (replay_count < REPLAY_MAX_FRAMES)) {
+            frame = &replay_frames[replay_count];
+            frame->delta_us = (unsigned int)(replay_time_us - last_time);
+            frame->keys = (unsigned char)(*keys & 0xF);
+            frame->switches = (unsigned short)(*switches & 0x3FF);
+            frame->reserved = 0;
+        }
+    }
+    Timer_setFrameTime(replay_time_us);
+}
+
+bool Replay_endFrame(unsigned int hash) {
+    unsigned int cost_us = (unsigned int)(Timer_hardwareUs() - replay_frame_start_us);
+
+    if (replay_mode == REPLAY_RECORDING) {
+        if (replay_count < REPLAY_MAX_FRAMES) {
+            replay_frames[replay_count].hash = hash;
+            replay_frames[replay_count].cost_us = cost_us;
+            replay_count++;
+        }
+    } else if (replay_mode == REPLAY_PLAYING) {
+        replay_costs[replay_index] = cost_us;
+        replay_matched[replay_index] = (hash == replay_frames[replay_index].hash);
+        if (!replay_matched[replay_index] && (replay_divergence < 0)) replay_divergence = replay_index;
+        replay_final_hash = hash;
+        replay_index++;
+        if (replay_index == replay_count) {
+            // Carry on live from the recorded time
+            replay_last_hw_us = Timer_hardwareUs();
+            replay_mode = REPLAY_LIVE;
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifndef GAMEENGINE_HEADLESS
+signed int Replay_save(char filename[]) {
+    unsigned char header[REPLAY_HEADER_BYTES];
+    unsigned int count = replay_count;
+    UINT written;
+    signed int status = REPLAY_SUCCESS;
+
+    if (replay_mode != REPLAY_RECORDING) return REPLAY_ERRORMODE;
+    if (f_open(&replay_file, filename, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return REPLAY_ERRORNOFILE;
+
+    replay_writeHeader(header, count);
+    if ((f_write(&replay_file, header, sizeof(header), &written) != FR_OK) || (written != sizeof(header)) ||
+        (f_write(&replay_file, replay_frames, count * sizeof(ReplayFrame), &written) != FR_OK) ||
+        (written != count * sizeof(ReplayFrame))) {
+        status = REPLAY_ERRORWRITE;
+    }
+    if (f_close(&replay_file) != FR_OK) status = REPLAY_ERRORWRITE;
+    return status;
+}
+#endif
+
+signed int Replay_saveToMemory(unsigned char data[], unsigned int size, unsigned int *length) {
+    unsigned int count = replay_count;
+
+    if (replay_mode != REPLAY_RECORDING) return REPLAY_ERRORMODE;
+    *length = REPLAY_HEADER_BYTES + count * sizeof(ReplayFrame);
+    if (size < *length) return REPLAY_ERRORWRITE;
+
+    replay_writeHeader(data, count);
+    memcpy(&data[REPLAY_HEADER_BYTES], replay_frames, count * sizeof(ReplayFrame));
+    return REPLAY_SUCCESS;
+}
+
+void Replay_print(void) {
+    replay_summary();
+    printf("%s", replay_text);
+}
+
+#ifndef GAMEENGINE_HEADLESS
+signed int Replay_saveReport(char filename[]) {
+    unsigned int length, i;
+    UINT written;
+    signed int status = REPLAY_SUCCESS;
+
+    if (f_open(&replay_file, filename, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return REPLAY_ERRORNOFILE;
+
+    // Summary, then a line for each frame, written whenever the buffer fills
+    length = replay_summary();
+    length += sprintf(&replay_text[length], "frame,recorded_us,replayed_us,matched\r\n");
+    for (i = 0; (i <= replay_index) && (status == REPLAY_SUCCESS); i++) {
+        if ((i == replay_index) || (length > sizeof(replay_text) - 64)) {
+            if ((f_write(&replay_file, replay_text, length, &written) != FR_OK) || (written != length)) {
+                status = REPLAY_ERRORWRITE;
+            }
+            length = 0;
+        }
+        if (i < replay_index) {
+            length += sprintf(&replay_text[length], "%u,%u,%u,%u\r\n", i, replay_frames[i].cost_us, replay_costs[i],
+                              replay_matched[i] ? 1 : 0);
+        }
+    }
+    if (f_close(&replay_file) != FR_OK) status = REPLAY_ERRORWRITE;
+    return status;
+}
+#endif
+
+#endif /* REPLAY_ENABLED */
@@ -0,0 +1,250 @@
+/**
+ * Replay.h
+ *
+ * Input record and replay. A session is recorded as the push button and
+ * slide switch states read at the start of every frame, with the time
+ * between frames and the question seed, and can be played back on the
+ * board to run exactly the same frames again. Driver changes can then
+ * be compared on the same game rather than by playing it by hand.
+ *
+ * The frame time is held with Timer_setFrameTime for the whole of each
+ * frame, both while recording and while playing, so the game sees the
+ * same times and software timers expire on the same frames however long
+ * each frame takes. A hash of the game state is kept for every frame,
+ * and playback reports the first frame that did not match along with
+ * the cost of every frame.
+ *
+ * Globally define REPLAY_ENABLED to use the replay. Replay_hash is
+ * always available. A recording can also be loaded from and saved to
+ * memory, so one made on the board plays in the headless build, where
+ * GAMEENGINE_HEADLESS leaves out the SD card functions.
+ *
+ * Varun Gonsalves, Emmanuel Leo, Kaif Kutchwala
+ *
+ * Date: 19/10/2026
+ */
+
+#ifndef REPLAY_H_
+#define REPLAY_H_
+
+#include <stdbool.h>
+
+#define REPLAY_SUCCESS 0
+#define REPLAY_ERRORNOFILE 1
+#define REPLAY_ERRORFORMAT 2
+#define REPLAY_ERRORWRITE 3
+#define REPLAY_ERRORMODE 4
+
+// Most frames that can be recorded, about 20 minutes at 30 frames a second
+#define REPLAY_MAX_FRAMES 32768
+
+// Modes
+#define REPLAY_LIVE 0         // Inputs are read from the board and not recorded
+#define REPLAY_RECORDING 1    // Inputs are read from the board and recorded
+#define REPLAY_PLAYING 2      // Inputs come from the recording
+
+// A late playback start is moved on by multiples of this, a whole number
+// of seconds and of 1024us software timer ticks
+#define REPLAY_ALIGN_US 16000000
+
+// Size of the recording header: "MCRP", version, seed, frame count,
+// start time (low and high words) and two reserved words. The frames
+// follow as ReplayFrame structs, little endian on the board and on a host.
+#define REPLAY_HEADER_BYTES 32
+
+// Starting value for Replay_hash
+#define REPLAY_HASH_START 2166136261u
+
+/**
+ * Replay_hash
+ *
+ * Adds bytes to a 32-bit FNV-1a hash.
+ *
+ * Inputs:
+ * 		hash:	hash so far, REPLAY_HASH_START to begin
+ * 		data:	bytes to add
+ * 		length:	number of bytes
+ *
+ * Outputs:
+ * 		The new hash
+ **/
+unsigned int Replay_hash(unsigned int hash, const void *data, unsigned int length);
+
+#ifdef REPLAY_ENABLED
+
+/**
+ * ReplayFrame
+ *
+ * One recorded frame, 16 bytes as saved in a recording.
+ **/
+typedef struct {
+    unsigned int delta_us;     // Time from the start of the previous frame
+    unsigned int hash;         // Game state hash at the end of the frame
+    unsigned int cost_us;      // Time the frame took when it was recorded
+    unsigned short switches;   // Slide switches
+    unsigned char keys;        // Push buttons, as read from the board
+    unsigned char reserved;    // Always 0
+} ReplayFrame;
+
+/**
+ * Replay_startRecording
+ *
+ * Starts recording from now, holding the frame time. Call before the
+ * game is initialised, so it is recorded from its first state.
+ *
+ * Inputs:
+ * 		seed:	question seed to save with the recording
+ **/
+void Replay_startRecording(unsigned int seed);
+
+/**
+ * Replay_startPlayback
+ *
+ * Loads a recording from the SD card and holds the frame time at its
+ * start. Call before the game is initialised, then seed the questions
+ * with Replay_getSeed. The SD card must be mounted.
+ *
+ * The start is moved on by whole multiples of REPLAY_ALIGN_US if the
+ * board took longer to start than when it was recorded, so times round
+ * to milliseconds and timer ticks the same way.
+ *
+ * Inputs:
+ * 		filename:	name of the recording
+ *
+ * Outputs:
+ * 		REPLAY_SUCCESS, REPLAY_ERRORNOFILE or REPLAY_ERRORFORMAT
+ **/
+#ifndef GAMEENGINE_HEADLESS
+signed int Replay_startPlayback(char filename[]);
+#endif
+
+/**
+ * Replay_startPlaybackFromMemory
+ *
+ * As Replay_startPlayback, from a recording already loaded into memory,
+ * such as a file saved by Replay_save.
+ *
+ * Inputs:
+ * 		data:	the recording, header then frames
+ * 		length:	bytes in data
+ *
+ * Outputs:
+ * 		REPLAY_SUCCESS or REPLAY_ERRORFORMAT
+ **/
+signed int Replay_startPlaybackFromMemory(const unsigned char data[], unsigned int length);
+
+/**
+ * Replay_getDivergence
+ *
+ * Outputs:
+ * 		The first played frame whose hash did not match, or -1 if all
+ * 		have matched
+ **/
+signed int Replay_getDivergence(void);
+
+/**
+ * Replay_getMode
+ *
+ * Outputs:
+ * 		REPLAY_LIVE, REPLAY_RECORDING or REPLAY_PLAYING
+ **/
+unsigned int Replay_getMode(void);
+
+/**
+ * Replay_getSeed
+ *
+ * Outputs:
+ * 		The question seed of the recording being made or played
+ **/
+unsigned int Replay_getSeed(void);
+
+/**
+ * Replay_beginFrame
+ *
+ * Starts a frame. The frame time is moved on, and the inputs read from
+ * the board are recorded or, while playing, replaced by the recorded
+ * ones.
+ *
+ * Inputs:
+ * 		keys:		push button register value, replaced while playing
+ * 		switches:	slide switch register value, replaced while playing
+ **/
+void Replay_beginFrame(unsigned int *keys, unsigned int *switches);
+
+/**
+ * Replay_endFrame
+ *
+ * Ends a frame, recording its state hash and cost or, while playing,
+ * checking them against the recording. Once the last recorded frame
+ * has played the game carries on live.
+ *
+ * Inputs:
+ * 		hash:	hash of the game state at the end of the frame
+ *
+ * Outputs:
+ * 		true if this was the last frame of a playback
+ **/
+bool Replay_endFrame(unsigned int hash);
+
+/**
+ * Replay_save
+ *
+ * Saves the frames recorded so far to the SD card. Recording carries on,
+ * so a later save holds more frames.
+ *
+ * Inputs:
+ * 		filename:	name of the recording, overwritten if it exists
+ *
+ * Outputs:
+ * 		REPLAY_SUCCESS, REPLAY_ERRORMODE if not recording,
+ * 		REPLAY_ERRORNOFILE or REPLAY_ERRORWRITE
+ **/
+#ifndef GAMEENGINE_HEADLESS
+signed int Replay_save(char filename[]);
+#endif
+
+/**
+ * Replay_saveToMemory
+ *
+ * As Replay_save, into memory in the same format as the file.
+ *
+ * Inputs:
+ * 		data:	buffer for the recording
+ * 		size:	bytes in data
+ * 		length:	set to the bytes of the recording
+ *
+ * Outputs:
+ * 		REPLAY_SUCCESS, REPLAY_ERRORMODE if not recording or
+ * 		REPLAY_ERRORWRITE if it does not fit
+ **/
+signed int Replay_saveToMemory(unsigned char data[], unsigned int size, unsigned int *length);
+
+/**
+ * Replay_print
+ *
+ * Prints a summary of the playback: frames played, the mean and longest
+ * frame when recorded and when played, the final hashes and the first
+ * frame that did not match.
+ **/
+void Replay_print(void);
+
+/**
+ * Replay_saveReport
+ *
+ * Saves the summary of the playback to the SD card, followed by a line
+ * for each frame with its cost when recorded and when played and
+ * whether its state matched.
+ *
+ * Inputs:
+ * 		filename:	name of the report, overwritten if it exists
+ *
+ * Outputs:
+ * 		REPLAY_SUCCESS, REPLAY_ERRORNOFILE or REPLAY_ERRORWRITE
+ **/
+#ifndef GAMEENGINE_HEADLESS
+signed int Replay_saveReport(char filename[]);
+#endif
+
+#endif /* REPLAY_ENABLED */
+
+#endif /* REPLAY_H_ */
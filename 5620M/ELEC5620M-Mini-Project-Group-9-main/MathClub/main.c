@@ -9,31 +9,70 @@
 #include <stdlib.h>
 
 #include "Audio/AudioOutput.h"
+#include "Audio/AudioSequencer.h"
+#include "Audio/AudioSynth.h"
 #include "DE1SoC_WM8731/DE1SoC_WM8731.h"
+#include "FrameStats/FrameStats.h"
+#include "Delay/Delay.h"
 #include "GameEngine/GameEngine.h"
 #include "GraphicsEngine/GraphicsEngine.h"
-#include "HPS_Watchdog/HPS_Watchdog.h"
 #include "LCD/LCD.h"
 #include "LED/LED.h"
+#include "OutputBuffer/OutputBuffer.h"
+#include "Profiler/Profiler.h"
 #include "QuestionGenerator/QuestionGenerator.h"
+#include "Replay/Replay.h"
 #include "SDCard/SDCard.h"
 #include "Servo/DE1SOC_Servo.h"
 #include "SevenSeg/SevenSeg.h"
+#include "Startup/Startup.h"
+#include "Supervisor/Supervisor.h"
 #include "Timer/Timer.h"
+#include "Tracer/Tracer.h"
 
 volatile unsigned int *key_ptr = (unsigned int *)0xFF200050;     // KEYS 0-3 (push buttons)
 volatile unsigned int *switch_ptr = (unsigned int *)0xFF200040;  // SWITCHES 0-10
 
-// Store the round time limit to reset the remaining time
-// correctly based on difficulty.
-float round_time_limit;
-
-// Store the remaining time in the round to display to the user
-float round_time_remaining;
-
-// Store the last time the round time was update to ensure clock
-// goes down by 1 second
-unsigned int last_round_time_update;
+// Drivers brought up together by STARTUP_run, with the time each took
+#define STARTUP_LCD 0
+#define STARTUP_AUDIO 1
+#define STARTUP_SDCARD 2
+#define STARTUP_NUM_TASKS 3
+StartupTask startup_tasks[STARTUP_NUM_TASKS];
+
+// Time the timer was started, and the time from then to the first
+// main menu frame in us
+unsigned long long boot_start_time;
+unsigned int boot_time_us = 0;
+
+// Report of the start up times, written once the first main menu frame has run
+char boot_summary[256];
+
+// Frame budget of each game state in microseconds, in GAMEENGINE_ order.
+// Menus and animations only need to keep up with the keys, questions are
+// also timed so are given less.
+unsigned int frame_budgets_us[FRAMESTATS_NUM_STATES] = {100000, 50000, 100000, 100000, 100000, 100000};
+
+// Switching on both of these switches prints the frame statistics and
+// adds them to the stats file on the SD card
+#define FRAMESTATS_SWITCHES 0x180  // SW7 and SW8
+#define FRAMESTATS_FILE "framestats.txt"
+unsigned int stats_switches_last = 0;
+
+// File the event trace is saved to with the stats switches
+#define TRACE_FILE "trace.bin"
+
+// With REPLAY_ENABLED defined, every game is recorded and saved with the
+// stats switches. Starting with SW6 on plays the saved game back instead,
+// then saves a report of how it went.
+#define REPLAY_SWITCH 0x40  // SW6
+#define REPLAY_FILE "replay.bin"
+#define REPLAY_REPORT_FILE "replay.csv"
+
+// Push buttons and slide switches read at the start of the frame, or
+// the recorded ones while replaying
+unsigned int key_state;
+unsigned int switch_state;
 
 // Store the state of keys to determine which one is clicked
 unsigned int keys_pressed;
@@ -55,7 +94,7 @@ unsigned int key_last_state = 0;
  */
 unsigned int getPressedKeys() {
     // Store the current state of the keys.
-    unsigned int key_current_state = *key_ptr;
+    unsigned int key_current_state = key_state;
 
     // If the key was down last cycle, and is up now, mark as pressed.
     unsigned int keys_pressed = (~key_current_state) & (key_last_state);
@@ -67,36 +106,93 @@ unsigned int getPressedKeys() {
     return keys_pressed;
 }
 
+// Writes the time from the timer starting to the first main menu frame,
+// and the time each driver took to start, into boot_summary
+void writeBootSummary() {
+    unsigned int i, length;
+    length = sprintf(boot_summary, "Boot to main menu: %u us\n", boot_time_us);
+    for (i = 0; i < STARTUP_NUM_TASKS; i++) {
+        length += sprintf(boot_summary + length, "  %s: ready after %u us, %u us busy, status %d\n",
+                          startup_tasks[i].name, startup_tasks[i].elapsed_us, startup_tasks[i].busy_us,
+                          startup_tasks[i].status);
+    }
+}
+
+#ifdef REPLAY_ENABLED
+// Hashes the game state and the keys held, to check a replay against
+// its recording
+unsigned int hashGameState(void) {
+    unsigned int hash = GameEngine_hashState(REPLAY_HASH_START);
+    hash = Replay_hash(hash, &key_last_state, sizeof(key_last_state));
+    return hash;
+}
+#endif
+
 void exitOnFail(signed int status, signed int successStatus) {
     if (status != successStatus) {
         exit((int)status);  // Add breakpoint here to catch failure
     }
 }
 
-// Resets the round time to the time limit
-void resetRoundTime() {
-    round_time_remaining = round_time_limit;
+// Start up steps for STARTUP_run
+
+// Runs the LCD reset and wake sequence, which is mostly waiting
+signed int startLCD(unsigned int *wait_us, void *context) {
+    signed int status = LCD_initialiseStep(0xFF200060, 0xFF200080, wait_us);
+    (void)context;
+    return (status == LCD_PENDING) ? STARTUP_PENDING : status;
+}
+
+// Sets up the codec, then the synthesiser that plays through it
+signed int startAudio(unsigned int *wait_us, void *context) {
+    signed int status = WM8731_initialiseStep(0xFF203040);
+    (void)wait_us;
+    (void)context;
+    if (status == WM8731_PENDING) return STARTUP_PENDING;
+    if (status != WM8731_SUCCESS) return status;
+
+    // Only the DAC output is used, so power down the line and mic inputs
+    status = WM8731_setPowerDown(WM8731_POWER_LINEIN | WM8731_POWER_MIC);
+    if (status != WM8731_SUCCESS) return status;
+
+    // The game only plays simple tones, so 32kHz is plenty and
+    // costs two thirds of the CPU time of 48kHz, see Headless/HeadlessRates.c
+    status = AUDIOOUTPUT_setSampleRate(32000);
+    if (status != AUDIOOUTPUT_SUCCESS) return status;
+
+    // Initialise the synthesiser and play it, driven by the music
+    // sequencer, through the codec
+    status = SYNTH_initialise();
+    if (status != SYNTH_SUCCESS) return status;
+    AUDIOOUTPUT_setSource(SEQUENCER_getSource());
+    return STARTUP_SUCCESS;
 }
 
-// Resets the level, score and round time for the game
-void resetGameProgress() {
-    GameEngine_setLevel(0);  // reset the score
-    GameEngine_setScore(0);  // reset the level
-    resetRoundTime();        // reset the round time
+// Identifies the SD card now rather than when the game first reads it
+signed int startSDCard(unsigned int *wait_us, void *context) {
+    (void)wait_us;
+    (void)context;
+    // A card that can't be mounted is tried again on first access, so it
+    // does not stop the game starting
+    SDCARD_mount();
+    return STARTUP_SUCCESS;
 }
 
 // Main Function
 // =============
 int main(void) {
-    // Initialise the LCD Display.
-    exitOnFail(
-        LCD_initialise(0xFF200060, 0xFF200080),  // Initialise LCD
-        LCD_SUCCESS);                            // Exit if not successful
+    unsigned int i;
 
-    // Initialise the timer
+    // Initialise the timer first, as the time to the main menu is timed with it
     exitOnFail(
         Timer_initialise(0xFFFEC600),  // Initialise Timer Controller
         TIMER_SUCCESS);                // Exit if not successful
+    boot_start_time = Timer_hardwareUs();
+
+    // Start counting cycles for profiling, if PROFILER_ENABLED is defined
+    Profiler_initialise();
+    // Start recording events, if TRACER_ENABLED is defined
+    Tracer_initialise();
 
     // set timer period
     exitOnFail(
@@ -124,176 +220,128 @@ int main(void) {
         SevenSeg_initialise(0xFF200020, 0xFF200030),
         SEVENSEG_SUCCESS);
 
-    // Initialise the Audio / WM8731
+    // From here the game sets the LEDs, seven segment displays and servo
+    // through the output buffer
+    OutputBuffer_initialise();
+
+    // Bring up the LCD, audio and SD card together, so the codec set up
+    // and card identification happen during the LCD's wake up delays.
+    // The LCD goes first as its delays are the longest.
+    startup_tasks[STARTUP_LCD].name = "LCD";
+    startup_tasks[STARTUP_LCD].step = &startLCD;
+    startup_tasks[STARTUP_AUDIO].name = "Audio";
+    startup_tasks[STARTUP_AUDIO].step = &startAudio;
+    startup_tasks[STARTUP_SDCARD].name = "SD Card";
+    startup_tasks[STARTUP_SDCARD].step = &startSDCard;
     exitOnFail(
-        WM8731_initialise(0xFF203040),
-        WM8731_SUCCESS);
+        STARTUP_run(startup_tasks, STARTUP_NUM_TASKS),
+        STARTUP_SUCCESS);
+
+#ifdef REPLAY_ENABLED
+    // Play back the saved game if SW6 is on, otherwise record this one.
+    // Either way the frame time is held from here on.
+    if (!(*switch_ptr & REPLAY_SWITCH) || (Replay_startPlayback(REPLAY_FILE) != REPLAY_SUCCESS)) {
+        Replay_startRecording(Timer_getValue());
+    }
+    QuestionGenerator_setSeed(Replay_getSeed());
+#else
+    // Seed the questions from the timer so each game is different
+    QuestionGenerator_setSeed(Timer_getValue());
+#endif
 
-    // Mount the SD Card
-    SDCARD_mount();
-    // Initialise game engine state variables
-    GameEngine_initialise("mathclub.txt");
-    // Get the initial round time limit
-    round_time_limit = GameEngine_getTimeLimit();
-    // Reset round time to be maximum i.e. equal to the time limit
-    resetRoundTime();
+    // Initialise game engine state variables, shown and played on the board
+    GameEngine_initialise(&GameEngine_boardOutput, "mathclub.txt");
+
+    // From here the watchdog is only reset while the main loop keeps running
+    exitOnFail(Supervisor_initialise(), SUPERVISOR_SUCCESS);
+
+    // Set the frame budget of each state
+    for (i = 0; i < FRAMESTATS_NUM_STATES; i++) {
+        FrameStats_setBudget(i, frame_budgets_us[i]);
+    }
 
     // Corresponding value set to 1 when a key is pressed then released.
     // Set initial value to no keys pressed
     keys_pressed = 0;
 
     while (1) {
+        // Time the frame starts, for the frame statistics
+        unsigned long long frame_start = Timer_hardwareUs();
         // Get the current state of the game
         int state = GameEngine_getState();
-        // Get the current timer value in milliseconds
-        unsigned int current_time = Timer_getValueMS();
-        // Get the current round time limit for the game
-        round_time_limit = GameEngine_getTimeLimit();
+
+        // Read the inputs for this frame
+        key_state = *key_ptr;
+        switch_state = *switch_ptr;
+#ifdef REPLAY_ENABLED
+        Replay_beginFrame(&key_state, &switch_state);
+#endif
 
         // Check if any buttons have been pressed and released.
         // The keys_pressed variable will need to be bit masked to determine if a
         // specific key was pressed.
         keys_pressed = getPressedKeys();
-
-        if (state == GAMEENGINE_MAINMENU) {
-            // If game is on main menu, display the main menu
-            GameEngine_displayMainMenu();
-
-            // Handle button presses
-            if (keys_pressed & 0x1) {
-                // if player clicks Btn 0 i.e. selects Play option
-                resetGameProgress();                      // reset the level, score and round time
-                GameEngine_setState(GAMEENGINE_PLAYING);  // set game state to PLAYING
-            }
-            if (keys_pressed & 0x2) {
-                // if player clicks Btn 1 i.e. selects increase volume option
-                GameEngine_increaseVolume();  // increase the volume
-            }
-            if (keys_pressed & 0x4) {
-                // if player clicks Btn 2 i.e. selects decrease volume option
-                GameEngine_decreaseVolume();  // decrease the volume
-            }
-
-            // If SW0 is on
-            if (*switch_ptr & 0x1) {
-                GameEngine_setGameMode(GAMEENGINE_HARD);  // set the game mode to HARD
-            } else {
-                GameEngine_setGameMode(GAMEENGINE_EASY);  // else set the game mode to EASY
-            }
-
-        } else if (state == GAMEENGINE_PLAYING) {
-            // If game is in PLAYING state
-            // Display the current level with the remaining round time
-            GameEngine_displayLevel(round_time_remaining);
-
-            // If player runs out of time, end game.
-            if (round_time_remaining <= 0) {
-                resetGameProgress();  // reset the level, score and round time
-
-                // set game over animation last update time to current time
-                // this is so that the animation runs for the required duration
-                GameEngine_setGameOverLastUpdateTime(current_time);
-
-                GameEngine_setState(GAMEENGINE_GAMEOVER);  // set game state to GAMEOVER
-            }
-
-            // If any option is selected i.e. any button is clicked.
-            if (keys_pressed & 0xF) {
-                resetRoundTime();  // reset the round time
-            }
-
-            // Handle button presses
-            if (keys_pressed & 0x1) {
-                // if player clicks Btn 0 i.e. selects option 1
-                GameEngine_enterOption(GAMEENGINE_OPTION1);  // enter option 1
-            }
-            if (keys_pressed & 0x2) {
-                // if player clicks Btn 1 i.e. selects option 2
-                GameEngine_enterOption(GAMEENGINE_OPTION2);  // enter option 2
-            }
-            if (keys_pressed & 0x4) {
-                // if player clicks Btn 2 i.e. selects option 3
-                GameEngine_enterOption(GAMEENGINE_OPTION3);  // enter option 3
-            }
-            if (keys_pressed & 0x8) {
-                // if player clicks Btn 3 i.e. selects option 4
-                GameEngine_enterOption(GAMEENGINE_OPTION4);  // enter option 4
-            }
-
-            // If SW0 is on 9 is on set game mode to paused
-            if (*switch_ptr & 0x200) {
-                GameEngine_setState(GAMEENGINE_PAUSED);
-            }
-
-        } else if (state == GAMEENGINE_PAUSED) {
-            // If game is paused, display pause menu
-            GameEngine_displayPauseMenu();
-
-            // Handle button presses
-            if (keys_pressed & 0x1) {
-                // if player clicks Btn 0 i.e. selects exit option
-                resetGameProgress();                       // reset the level, score and round time
-                GameEngine_setState(GAMEENGINE_MAINMENU);  // exit to main menu
-            }
-            if (keys_pressed & 0x2) {
-                // if player clicks Btn 1 i.e. selects increase volume option
-                GameEngine_increaseVolume();  // increase the volume
-            }
-            if (keys_pressed & 0x4) {
-                // if player clicks Btn 2 i.e. selects decrease volume option
-                GameEngine_decreaseVolume();  // decrease the volume
-            }
-
-            // If SW0 is off 9 is on set game mode to PLAYING
-            if (!(*switch_ptr & 0x200)) {
-                GameEngine_setState(GAMEENGINE_PLAYING);
-            }
-
-        } else if (state == GAMEENGINE_LEVELUP) {
-            // If state is LEVELUP display level up animation
-            GameEngine_levelUp();
-        } else if (state == GAMEENGINE_WIN) {
-            // If state is WIN display celebrate up animation
-            GameEngine_celebrate();
-        } else if (state == GAMEENGINE_GAMEOVER) {
-            // If state is GAMEOVER display game over up animation
-            GameEngine_gameOver();
-        } else {
-            // If game is in invalid state, reset state and send to main menu
-            resetGameProgress();
-            resetRoundTime();
-            GameEngine_setState(GAMEENGINE_MAINMENU);
+        if (keys_pressed) TRACE_INSTANT(TRACE_INPUT, keys_pressed);
+
+        // Run the game for this frame
+        GameEngine_update(keys_pressed, switch_state);
+        if ((state == GAMEENGINE_MAINMENU) && !boot_time_us) {
+            boot_time_us = (unsigned int)(Timer_hardwareUs() - boot_start_time);
+            writeBootSummary();
+            printf("%s", boot_summary);
         }
 
-        // Update the remaining time in the round
-        // First check if game is in PLAYING state
-        // This is to ensure time is not running down when paused or viewing animations
-        if (state == GAMEENGINE_PLAYING) {
-            // Check if one second has passed since the last time remaining time was
-            // updated
-            if ((last_round_time_update - current_time) >= 1000.0) {
-                round_time_remaining--;  // reduce the time by 1 unit
-
-                // round time cannot be below 0
-                if (round_time_remaining < 0) {
-                    round_time_remaining = 0.0;
-                }
-
-                // update the last_round_time_update to current time
-                last_round_time_update = current_time;
-            }
-        }
+        // Run any software timers that are due, such as the scrolling text,
+        // and any driver delays that have finished
+        Timer_service();
+        Delay_service();
+
+        // Write the LEDs, seven segment displays and servo set this frame
+        // that have changed
+        OutputBuffer_commit();
+
+        // Top up the audio FIFOs with any playing sound effect
+        AUDIOOUTPUT_service();
 
         // Refresh the screen to show new contents
         GraphicsEngine_update();
 
+        // Top up again as the screen refresh takes longer than the FIFOs last
+        AUDIOOUTPUT_service();
+
         // Next, make sure we clear the private timer interrupt flag if it is set
         if (Timer_getInterruptStatus() & 0x1) {
             // If the timer interrupt flag is set, clear the flag
             Timer_resetInterrupt();
         }
 
-        // Finally, reset the watchdog timer.
-        HPS_ResetWatchdog();
+        // Add the frame to the statistics of the state it started in, and
+        // report them, and save the event trace, when the stats switches
+        // are turned on together
+        FrameStats_record(state, (unsigned int)(Timer_hardwareUs() - frame_start), Timer_nowMs());
+        if (((*switch_ptr & FRAMESTATS_SWITCHES) == FRAMESTATS_SWITCHES) && (stats_switches_last != FRAMESTATS_SWITCHES)) {
+            FrameStats_print(Timer_nowMs());
+            OutputBuffer_print();
+            printf("%s", boot_summary);
+            FrameStats_appendToFile(FRAMESTATS_FILE, Timer_nowMs());
+            SDCARD_appendToFile(FRAMESTATS_FILE, boot_summary);
+            Tracer_dump(TRACE_FILE);
+#ifdef REPLAY_ENABLED
+            Replay_save(REPLAY_FILE);
+#endif
+        }
+        stats_switches_last = *switch_ptr & FRAMESTATS_SWITCHES;
+
+#ifdef REPLAY_ENABLED
+        // Check the frame against the recording, and report once the whole
+        // recording has played
+        if (Replay_endFrame(hashGameState())) {
+            Replay_print();
+            Replay_saveReport(REPLAY_REPORT_FILE);
+        }
+#endif
+
+        // Finally, tell the supervisor the game loop is still running.
+        Supervisor_kick();
     }
 }